@@ -0,0 +1,114 @@
+#ifndef __aligned_buffer__
+#define __aligned_buffer__
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// Alignement des buffers audio : une ligne de cache, suffisant pour AVX-512
+static const size_t kBufferAlignment = 64;
+
+// Granularité des noyaux SIMD (en échantillons float) : 16 floats = 64 octets
+static const size_t kKernelBlock = 16;
+
+// Taille arrondie au multiple de kKernelBlock supérieur
+inline size_t paddedLength(size_t count) {
+  return (count + kKernelBlock - 1) / kKernelBlock * kKernelBlock;
+}
+
+// Buffer aligné sur une ligne de cache et rembourré à un multiple de kKernelBlock.
+// Le rembourrage est mis à zéro à l'allocation : les noyaux SIMD traitent
+// paddedSize() éléments sans prologue ni épilogue scalaire.
+template <typename T>
+class AlignedBuffer {
+public:
+  AlignedBuffer() {}
+  explicit AlignedBuffer(size_t count) { resize(count); }
+  ~AlignedBuffer() { release(); }
+
+  AlignedBuffer(const AlignedBuffer&) = delete;
+  AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+  AlignedBuffer(AlignedBuffer&& other) noexcept
+    : ptr(other.ptr), count(other.count), padded(other.padded) {
+    other.ptr = nullptr;
+    other.count = 0;
+    other.padded = 0;
+  }
+
+  AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+    if (this != &other) {
+      release();
+      ptr = other.ptr;
+      count = other.count;
+      padded = other.padded;
+      other.ptr = nullptr;
+      other.count = 0;
+      other.padded = 0;
+    }
+    return *this;
+  }
+
+  // Réalloue et remet à zéro (jamais depuis le callback audio)
+  void resize(size_t newCount) {
+    release();
+    count = newCount;
+    padded = paddedLength(newCount);
+    if (padded > 0) {
+      ptr = static_cast<T*>(::operator new(padded * sizeof(T), std::align_val_t(kBufferAlignment)));
+      std::memset(static_cast<void*>(ptr), 0, padded * sizeof(T));
+    }
+  }
+
+  void zero() {
+    if (ptr) {
+      std::memset(static_cast<void*>(ptr), 0, padded * sizeof(T));
+    }
+  }
+
+  T* data() { return ptr; }
+  const T* data() const { return ptr; }
+  size_t size() const { return count; }
+  size_t paddedSize() const { return padded; }
+  bool empty() const { return count == 0; }
+
+  T& operator[](size_t i) { return ptr[i]; }
+  const T& operator[](size_t i) const { return ptr[i]; }
+
+private:
+  void release() {
+    if (ptr) {
+      ::operator delete(static_cast<void*>(ptr), std::align_val_t(kBufferAlignment));
+      ptr = nullptr;
+    }
+  }
+
+  T* ptr = nullptr;
+  size_t count = 0;
+  size_t padded = 0;
+};
+
+// Plage mémoire d'un moteur, verrouillée en mémoire au démarrage (realtime_thread.h)
+// name : libellé de la région dans le rapport (plusieurs plages peuvent le partager)
+struct MemoryRegion {
+  const char* name;
+  const void* data;
+  size_t bytes;
+};
+
+template <typename T>
+inline void appendRegion(std::vector<MemoryRegion>& regions, const char* name, const AlignedBuffer<T>& buffer) {
+  if (buffer.paddedSize() > 0) {
+    regions.push_back(MemoryRegion{name, buffer.data(), buffer.paddedSize() * sizeof(T)});
+  }
+}
+
+template <typename T>
+inline void appendRegion(std::vector<MemoryRegion>& regions, const char* name, const std::vector<T>& buffer) {
+  if (!buffer.empty()) {
+    regions.push_back(MemoryRegion{name, buffer.data(), buffer.size() * sizeof(T)});
+  }
+}
+
+#endif
@@ -1,11 +1,20 @@
 #include <napi.h>
+#include <algorithm>
 #include <atomic>
-#include <mutex>
 #include <vector>
 #include <thread>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <utility>
+#include <chrono>
 #include <cmath> // Pour std::sqrt et std::rand
-#include <condition_variable> // Pour std::condition_variable
-#include <iostream> // Pour std::cout et std::endl
+#include <cstring> // Pour strcpy
+#include <cstdio> // Pour snprintf
+#ifdef _WIN32
+#include <objbase.h> // Pour CoInitialize (thread de contrôle)
+#endif
 
 // Définir ASIOCallConv comme __stdcall sur Windows et comme vide sur les autres plateformes
 #ifdef _WIN32
@@ -18,6 +27,23 @@
 #include "asiosys.h"
 #include "asio.h"
 #include "asiodrivers.h"
+#include "spsc_ring.h"
+#include "fft_engine.h"
+#include "level_meter.h"
+#include "aligned_buffer.h"
+#include "dsp_kernels.h"
+#include "smoothed_parameter.h"
+#include "routing_matrix.h"
+#include "fxlms_canceller.h"
+#include "processing_chain.h"
+#include "block_clock.h"
+#include "callback_stats.h"
+#include "sample_format.h"
+#include "offline_processor.h"
+#include "virtual_asio_driver.h"
+#include "shared_telemetry.h"
+#include "rt_log.h"
+#include "realtime_thread.h"
 
 // Déclaration externe pour AsioDrivers
 extern AsioDrivers* asioDrivers;
@@ -25,565 +51,2376 @@ extern AsioDrivers* asioDrivers;
 // Constantes pour les erreurs ASIO
 #define ASE_OK 0
 
-// Implémentations simplifiées des fonctions ASIO pour la compilation
+// Fonctions ASIO de l'hôte transmises au pilote virtuel (simulation sans carte son)
 // Ces fonctions seront remplacées par les vraies fonctions ASIO lorsque le SDK ASIO sera correctement installé
-long ASIOInit(ASIODriverInfo* info) { 
-  if (info) {
-    strcpy(info->name, "Simulation ASIO"); 
-    info->asioVersion = 2; 
-  }
-  return ASE_OK; 
-}
+// Comme theAsioDriver du SDK, un seul pilote est adressé à la fois : celui du moteur dont la
+// commande s'exécute sur le thread de contrôle, sinon le pilote du sondage des périphériques
+static VirtualAsioDriver virtualDriver;
+static std::atomic<VirtualAsioDriver*> hostDriver{&virtualDriver};
 
-long ASIOExit() { return ASE_OK; }
-long ASIOStart() { return ASE_OK; }
-long ASIOStop() { return ASE_OK; }
+long ASIOInit(ASIODriverInfo* info) { return hostDriver.load()->init(info); }
+long ASIOExit() { return hostDriver.load()->disposeBuffers(); }
+long ASIOStart() { return hostDriver.load()->start(); }
+long ASIOStop() { return hostDriver.load()->stop(); }
 
-long ASIOGetChannels(long* numInputChannels, long* numOutputChannels) { 
-  if (numInputChannels) *numInputChannels = 2; 
-  if (numOutputChannels) *numOutputChannels = 2; 
-  return ASE_OK; 
+long ASIOGetChannels(long* numInputChannels, long* numOutputChannels) {
+  return hostDriver.load()->getChannels(numInputChannels, numOutputChannels);
 }
 
 long ASIOGetBufferSize(long* minSize, long* maxSize, long* preferredSize, long* granularity) {
-  if (minSize) *minSize = 256;
-  if (maxSize) *maxSize = 2048;
-  if (preferredSize) *preferredSize = 1024;
-  if (granularity) *granularity = 256;
-  return ASE_OK;
+  return hostDriver.load()->getBufferSize(minSize, maxSize, preferredSize, granularity);
+}
+
+long ASIOGetSampleRate(ASIOSampleRate* currentRate) { return hostDriver.load()->getSampleRate(currentRate); }
+long ASIOCanSampleRate(ASIOSampleRate sampleRate) { return hostDriver.load()->canSampleRate(sampleRate); }
+
+// Optimisation ASIOOutputReady refusée par le pilote virtuel sauf option outputReady
+long ASIOOutputReady() { return hostDriver.load()->outputReady(); }
+
+long ASIOGetLatencies(long* inputLatency, long* outputLatency) {
+  return hostDriver.load()->getLatencies(inputLatency, outputLatency);
+}
+
+long ASIOGetChannelInfo(ASIOChannelInfo* info) { return hostDriver.load()->getChannelInfo(info); }
+
+long ASIOCreateBuffers(ASIOBufferInfo* bufferInfos, long numChannels, long bufferSize, ASIOCallbacks* callbacks) {
+  return hostDriver.load()->createBuffers(bufferInfos, numChannels, bufferSize, callbacks);
 }
 
-long ASIOCreateBuffers(ASIOBufferInfo* bufferInfos, long numChannels, long bufferSize, ASIOCallbacks* callbacks) { 
-  return ASE_OK; 
+long ASIODisposeBuffers() { return hostDriver.load()->disposeBuffers(); }
+
+// Journal du moteur : utilisable depuis le callback (rt_log.h), écrit par son propre thread
+static RtLogger engineLog;
+
+// Sortie du journal (thread du journal) : avertissements et erreurs sur stderr
+static void writeLogMessage(LogLevel level, const std::string& message) {
+  FILE* stream = level >= LogLevel::Warning ? stderr : stdout;
+  std::fprintf(stream, "[asio] %s: %s\n", logLevelName(level), message.c_str());
+  std::fflush(stream);
 }
 
-long ASIODisposeBuffers() { return ASE_OK; }
+static void stopEngineLog() {
+  engineLog.stop();
+}
 
 class ASIOHandler : public Napi::ObjectWrap<ASIOHandler> {
 public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  
+  // Chaque instance est un moteur indépendant (new ASIOHandler()) : pilote, buffers,
+  // chaîne DSP, mesures et threads de télémétrie lui appartiennent. Plusieurs moteurs
+  // peuvent traiter en parallèle, chacun sur le cœur choisi par initialize(id, { realtime: { cpu } }).
   ASIOHandler(const Napi::CallbackInfo& info);
+  ~ASIOHandler();
   
-  // Structure pour les buffers audio
-  struct AudioBuffer {
-    std::vector<float> input;
-    std::vector<float> output;
-    std::atomic<bool> ready{false};
-  };
-
-  // Callbacks ASIO
+  // Callbacks ASIO du moteur, appelés par les fonctions de son emplacement (EngineCallbacks)
+  // Repli pour les pilotes sans time info : position estimée et horloge locale
   void bufferSwitch(long index, ASIOBool processNow) {
-    std::lock_guard<std::mutex> lock(bufferMutex);
-    
-    // Traitement d'inversion de phase
-    for(int i = 0; i < bufferSize; i++) {
-      currentBuffer->output[i] = currentBuffer->input[i] * -gain;
+    if (processing.load(std::memory_order_acquire)) {
+      const int64_t start = monotonicNs();
+      const double position = static_cast<double>(blockClock.blocks()) * static_cast<double>(bufferSize);
+      blockClock.record(position, static_cast<double>(start), kBlockPositionValid | kBlockTimeValid | kBlockEstimated, index);
+      processBlock(index);
+      callbackStats.record(start, monotonicNs());
     }
-    
-    currentBuffer->ready.store(true);
-    bufferCondition.notify_one();
-  }
-  
-  // Fonction de callback statique pour ASIO
-  static void ASIOCallConv bufferSwitchStatic(long index, ASIOBool processNow) {
-    // Cette fonction est appelée par le pilote ASIO lorsqu'un buffer est prêt
-    // Nous devons rediriger l'appel vers l'instance de ASIOHandler
-    // Pour simplifier, nous utilisons des variables statiques
-    if (processing.load()) {
-      // Sélectionner le buffer actif
-      currentBuffer = &buffers[index];
-      
-      // Copier les données d'entrée depuis les buffers ASIO
-      // Dans une implémentation réelle, ces données proviendraient du pilote ASIO
-      
-      // Traitement d'inversion de phase
-      for(int i = 0; i < bufferSize; i++) {
-        currentBuffer->output[i] = currentBuffer->input[i] * -gain;
+  }
+  
+  // Callback préféré des pilotes ASIO 2 : position et temps système fournis par le pilote
+  ASIOTime* bufferSwitchTimeInfo(ASIOTime* params, long index, ASIOBool processNow) {
+    if (processing.load(std::memory_order_acquire)) {
+      const int64_t start = monotonicNs();
+      uint32_t flags = 0;
+      double position = 0.0;
+      double systemTime = 0.0;
+      if (params) {
+        const ASIOTimeInfo& timeInfo = params->timeInfo;
+        if (timeInfo.flags & kSamplePositionValid) {
+          position = asio64ToDouble(timeInfo.samplePosition);
+          flags |= kBlockPositionValid;
+        }
+        if (timeInfo.flags & kSystemTimeValid) {
+          systemTime = asio64ToDouble(timeInfo.systemTime);
+          flags |= kBlockTimeValid;
+        }
       }
-      
-      currentBuffer->ready.store(true);
-      bufferCondition.notify_one();
+      blockClock.record(position, systemTime, flags, index);
+      processBlock(index);
+      callbackStats.record(start, monotonicNs());
+    }
+    return nullptr;
+  }
+  
+  // Le pilote signale une nouvelle fréquence : elle sera prise en compte au prochain démarrage
+  void sampleRateDidChange(ASIOSampleRate rate) {
+    pendingSampleRate.store(rate, std::memory_order_relaxed);
+    sampleRateChanged.store(true, std::memory_order_release);
+    engineLog.log(LogLevel::Warning, "Moteur {} : fréquence d'échantillonnage changée par le pilote: {} Hz", slot, rate);
+  }
+  
+  // Messages du pilote (mêmes réponses que hostsample.cpp)
+  long asioMessage(long selector, long value, void* message, double* opt) {
+    switch (selector) {
+      case kAsioSelectorSupported:
+        return (value == kAsioResetRequest || value == kAsioEngineVersion || value == kAsioResyncRequest ||
+                value == kAsioLatenciesChanged || value == kAsioSupportsTimeInfo ||
+                value == kAsioSupportsTimeCode) ? 1L : 0L;
+      case kAsioResetRequest:
+        // Le pilote demande une réinitialisation : elle ne peut avoir lieu dans le callback.
+        // Ses capacités (canaux, tailles de buffer) peuvent avoir changé : liste à sonder de nouveau
+        resetRequested.store(true, std::memory_order_release);
+        devicesStale.store(true, std::memory_order_release);
+        engineLog.log(LogLevel::Warning, "Moteur {} : le pilote ASIO demande une réinitialisation", slot);
+        return 1L;
+      case kAsioResyncRequest:
+        // Perte de synchronisation signalée par le pilote : visible dans l'historique des blocs
+        engineLog.log(LogLevel::Warning, "Moteur {} : perte de synchronisation signalée par le pilote ASIO", slot);
+        return 1L;
+      case kAsioLatenciesChanged:
+        latenciesChanged.store(true, std::memory_order_release);
+        engineLog.log(LogLevel::Info, "Moteur {} : latences du pilote ASIO modifiées", slot);
+        return 1L;
+      case kAsioEngineVersion:
+        return 2L;
+      case kAsioSupportsTimeInfo:
+        return 1L;
+      case kAsioSupportsTimeCode:
+        return 0L;
     }
+    return 0L;
   }
 
 private:
-  // Méthodes exposées à JavaScript
-  static Napi::Value Initialize(const Napi::CallbackInfo& info);
-  static Napi::Value Start(const Napi::CallbackInfo& info);
-  static Napi::Value Stop(const Napi::CallbackInfo& info);
-  static Napi::Value GetInputLevel(const Napi::CallbackInfo& info);
-  static Napi::Value GetFFTData(const Napi::CallbackInfo& info);
-  static Napi::Value SetBufferSize(const Napi::CallbackInfo& info);
-  static Napi::Value SetInversionGain(const Napi::CallbackInfo& info);
+  // Méthodes exposées à JavaScript (getDevices, refreshDevices et processFiles sont
+  // statiques : ils ne dépendent d'aucun moteur)
+  Napi::Value Initialize(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+  Napi::Value GetInputLevel(const Napi::CallbackInfo& info);
+  Napi::Value GetFFTData(const Napi::CallbackInfo& info);
+  Napi::Value GetLevels(const Napi::CallbackInfo& info);
+  Napi::Value GetWaveform(const Napi::CallbackInfo& info);
+  Napi::Value SetInversionGain(const Napi::CallbackInfo& info);
+  Napi::Value SetRouting(const Napi::CallbackInfo& info);
+  Napi::Value GetTimeInfo(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value StartTelemetry(const Napi::CallbackInfo& info);
+  Napi::Value StopTelemetry(const Napi::CallbackInfo& info);
+  Napi::Value StartSharedTelemetry(const Napi::CallbackInfo& info);
+  Napi::Value StopSharedTelemetry(const Napi::CallbackInfo& info);
+  static Napi::Value ProcessFiles(const Napi::CallbackInfo& info);
   static Napi::Value getDevices(const Napi::CallbackInfo& info);
+  static Napi::Value RefreshDevices(const Napi::CallbackInfo& info);
 
-  // Variables ASIO
-  static ASIODriverInfo driverInfo;
-  static ASIOBufferInfo bufferInfos[2];
-  static long inputChannels;
-  static long outputChannels;
-  static long bufferSize;
-  static long minSize, maxSize, preferredSize, granularity;
-
-  // Synchronisation
-  static std::mutex bufferMutex;
-  static std::condition_variable bufferCondition;
-  static AudioBuffer buffers[2];
-  static AudioBuffer* currentBuffer;
-  static float gain;
-  static std::atomic<bool> processing;
-};
-
-// Initialisation des variables statiques
-std::mutex ASIOHandler::bufferMutex;
-std::condition_variable ASIOHandler::bufferCondition;
-ASIOHandler::AudioBuffer ASIOHandler::buffers[2];
-ASIOHandler::AudioBuffer* ASIOHandler::currentBuffer = &ASIOHandler::buffers[0];
-float ASIOHandler::gain = 1.0f;
-std::atomic<bool> ASIOHandler::processing{false};
-long ASIOHandler::bufferSize = 1024;
-ASIODriverInfo ASIOHandler::driverInfo;
-ASIOBufferInfo ASIOHandler::bufferInfos[2];
-long ASIOHandler::inputChannels = 0;
-long ASIOHandler::outputChannels = 0;
-long ASIOHandler::minSize = 0;
-long ASIOHandler::maxSize = 0;
-long ASIOHandler::preferredSize = 0;
-long ASIOHandler::granularity = 0;
-
-ASIOHandler::ASIOHandler(const Napi::CallbackInfo& info) 
-  : Napi::ObjectWrap<ASIOHandler>(info) {
-  // Initialisation du driver ASIO
+  // Traitement temps réel d'un bloc : sans verrou, sans allocation, sans appel système
+  void processBlock(long index);
   
-  // Allocation des buffers
-  buffers[0].input.resize(bufferSize);
-  buffers[0].output.resize(bufferSize);
-  buffers[1].input.resize(bufferSize);
-  buffers[1].output.resize(bufferSize);
-}
-
-Napi::Value ASIOHandler::Initialize(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
+  // Commandes de contrôle (initialize, start, stop, close), exécutées une à une dans l'ordre
+  // des appels, tous moteurs confondus : préparation sur le thread Node (arguments
+  // JavaScript, état laissé par la commande précédente), appels au pilote sur le thread de
+  // contrôle, réponse sur le thread Node. La commande suivante n'est préparée qu'une fois
+  // la précédente résolue.
+  // Le sondage des périphériques (probe) passe par la même file : charger un pilote pour
+  // le sonder ne peut pas croiser une initialisation.
   
-  // Vérifier les arguments
-  if (info.Length() < 1) {
-    Napi::TypeError::New(env, "Argument 1 doit être l'ID ou le nom du pilote ASIO").ThrowAsJavaScriptException();
-    return env.Null();
-  }
+  // Périphérique de la liste : pilote du registre (driverIndex >= 0) ou périphérique simulé
+  struct DeviceInfo {
+    std::string name;
+    long driverIndex = -1;
+    bool isSimulated = false;
+    bool probed = false;            // capacités relevées auprès du pilote
+    std::string error;              // échec du sondage
+    long inputChannels = 0;
+    long outputChannels = 0;
+    long minSize = 0, maxSize = 0, preferredSize = 0, granularity = 0;
+    double sampleRate = 0.0;
+    std::vector<double> sampleRates; // fréquences standard acceptées (ASIOCanSampleRate)
+    long inputLatency = 0;
+    long outputLatency = 0;
+  };
   
-  std::string driverIdentifier;
-  long driverId = -1;
-  bool isSimulated = false;
+  enum class ControlOp { Initialize, Start, Stop, Close, Probe };
+  struct ControlCommand {
+    ControlCommand(Napi::Env env, ControlOp op) : op(op), deferred(Napi::Promise::Deferred::New(env)) {}
+    ControlOp op;
+    Napi::Promise::Deferred deferred;
+    Napi::ObjectReference arguments;
+    ASIOHandler* engine = nullptr;  // moteur visé (nullptr : sondage des périphériques)
+    Napi::ObjectReference engineObject; // empêche la libération du moteur avant la réponse
+    bool keepAlive = true;          // maintient Node actif jusqu'à la réponse (appels JavaScript)
+    std::string error;              // échec côté thread de contrôle (promesse rejetée)
+    long driverId = -1;             // initialize : pilote à charger (index du registre ou nom)
+    std::string driverIdentifier;
+    bool simulated = false;
+    RealtimeOptions realtime;       // initialize : priorité, affinité, verrouillage mémoire
+    bool outputReady = false;       // initialize : pilote virtuel, accepter ASIOOutputReady
+    ChainSettings settings;         // start : chaîne et source de temps du pilote virtuel
+    DriverClock clock = DriverClock::RealTime;
+    uint64_t clockBlocks = 0;
+    std::vector<DeviceInfo> devices; // probe : cache précédent, puis nouvelle liste
+  };
   
-  // Déterminer si l'argument est un ID numérique ou un nom de pilote
-  if (info[0].IsNumber()) {
-    driverId = info[0].As<Napi::Number>().Int32Value();
-    std::cout << "Initialisation du pilote ASIO avec ID: " << driverId << std::endl;
-  } else if (info[0].IsString()) {
-    driverIdentifier = info[0].As<Napi::String>().Utf8Value();
-    std::cout << "Initialisation du pilote ASIO: " << driverIdentifier << std::endl;
-    
-    // Vérifier si c'est un pilote simulé
-    if (driverIdentifier == "Simulation ASIO") {
-      isSimulated = true;
-    }
-  } else {
-    Napi::TypeError::New(env, "Argument 1 doit être un nombre (ID) ou une chaîne (nom)").ThrowAsJavaScriptException();
-    return env.Null();
-  }
+  // Copie de la configuration du moteur pour les lecteurs du thread Node
+  struct EngineConfig {
+    long bufferSize = 1024;
+    double sampleRate = 44100.0;
+    long inputLatency = 0;
+    long outputLatency = 0;
+    DriverClock clock = DriverClock::RealTime;
+  };
+  Napi::Value enqueueControl(const Napi::CallbackInfo& info, ControlOp op);
+  static Napi::Promise enqueueControl(Napi::Env env, ControlOp op, Napi::Array arguments, bool keepAlive,
+                                      ASIOHandler* engine);
+  static void runNextControl(Napi::Env env);
+  static void controlLoop();
+  static void deliverControl(Napi::Env env, Napi::Function callback, ControlCommand* command);
+  static void stopControlThread();
   
-  // Initialiser AsioDrivers si nécessaire
-  if (!asioDrivers) {
-    std::cout << "Initialisation de AsioDrivers..." << std::endl;
-    asioDrivers = new AsioDrivers();
-  }
+  // Méthodes synchrones qui modifient la configuration : refusées (exception) tant qu'une
+  // commande de contrôle de ce moteur est en attente ou en cours
+  bool controlPending(Napi::Env env);
   
-  // Obtenir le nombre de pilotes ASIO disponibles
-  char* driverNames[32]; // Tableau pour stocker les noms des pilotes
-  long numDrivers = asioDrivers->getDriverNames(driverNames, 32);
+  // Configuration lue par les méthodes de télémétrie (GetStats, GetTimeInfo, GetWaveform) :
+  // le thread de contrôle la publie sous configMutex à la fin de l'initialisation et du démarrage
+  void publishConfig();
+  EngineConfig engineConfig();
   
-  // Si c'est un pilote simulé ou si aucun pilote ASIO n'est disponible
-  if (isSimulated || numDrivers <= 0) {
-    std::cout << "Utilisation du pilote ASIO simulé" << std::endl;
-    
-    // Initialiser le pilote ASIO simulé
-    strcpy(driverInfo.name, "Simulation ASIO");
-    driverInfo.asioVersion = 2;
-    
-    // Obtenir les canaux d'entrée et de sortie
-    inputChannels = 2;
-    outputChannels = 2;
-    
-    // Obtenir les tailles de buffer disponibles
-    minSize = 256;
-    maxSize = 2048;
-    preferredSize = 1024;
-    granularity = 256;
-    
-    // Utiliser la taille de buffer préférée
-    bufferSize = preferredSize;
-  } else {
-    // Charger le pilote ASIO réel
-    bool driverLoaded = false;
-    
-    if (driverId >= 0 && driverId < numDrivers) {
-      // Charger par ID
-      char* driverName = driverNames[driverId];
-      if (driverName) {
-        driverLoaded = asioDrivers->loadDriver(driverName);
-        driverIdentifier = driverName;
-      }
-    } else {
-      // Charger par nom
-      driverLoaded = asioDrivers->loadDriver(const_cast<char*>(driverIdentifier.c_str()));
-    }
-    
-    if (!driverLoaded) {
-      Napi::Error::New(env, "Impossible de charger le pilote ASIO: " + driverIdentifier).ThrowAsJavaScriptException();
-      return env.Null();
-    }
-    
-    // Initialiser le pilote ASIO
-    if (ASIOInit(&driverInfo) != ASE_OK) {
-      Napi::Error::New(env, "Erreur lors de l'initialisation du pilote ASIO").ThrowAsJavaScriptException();
-      return env.Null();
-    }
-  }
+  bool prepareInitialize(Napi::Env env, Napi::Array arguments, ControlCommand* command);
+  void executeInitialize(ControlCommand* command);
+  Napi::Value initializeResult(Napi::Env env, ControlCommand* command);
+  bool prepareStart(Napi::Env env, Napi::Array arguments, ControlCommand* command);
+  void executeStart(ControlCommand* command);
+  Napi::Value startResult(Napi::Env env, ControlCommand* command);
+  void executeStop(ControlCommand* command);
+  static Napi::Value stopResult(Napi::Env env);
+  void executeClose(ControlCommand* command);
+  Napi::Value closeResult(Napi::Env env);
   
-  // Obtenir les informations sur les canaux
-  if (ASIOGetChannels(&inputChannels, &outputChannels) != ASE_OK) {
-    Napi::Error::New(env, "Erreur lors de la récupération des informations sur les canaux").ThrowAsJavaScriptException();
-    return env.Null();
-  }
+  // Ressources partagées avec les autres moteurs : emplacement des callbacks, pilote du
+  // registre, pages verrouillées en mémoire. shutdown() arrête les threads du moteur et
+  // libère tout (destructeur, fermeture de l'environnement Node).
+  bool claimSlot();
+  void releaseSlot();
+  void releaseRegistryDriver();
+  void lockMemory();
+  void releaseMemoryLock();
+  void shutdown();
+  static void stopEngines();
   
-  // Obtenir les informations sur les buffers
-  if (ASIOGetBufferSize(&minSize, &maxSize, &preferredSize, &granularity) != ASE_OK) {
-    Napi::Error::New(env, "Erreur lors de la récupération des informations sur les buffers").ThrowAsJavaScriptException();
-    return env.Null();
-  }
+  // Périphériques : sondés sur le thread de contrôle, lus depuis le cache par getDevices
+  static std::vector<DeviceInfo> simulatedDevices();
+  static std::vector<std::string> listDriverNames();
+  static void probeDriver(DeviceInfo* device);
+  static void queryCapabilities(DeviceInfo* device);
+  static void queueDeviceProbe(Napi::Env env);
+  static void executeProbe(ControlCommand* command);
+  static Napi::Value probeResult(Napi::Env env, ControlCommand* command);
+  static Napi::Array devicesToArray(Napi::Env env);
+
+  // Routage (à l'arrêt uniquement) : validation des routes JavaScript et
+  // reconstruction des plans et des descripteurs de buffers ASIO
+  static bool parseRouteList(Napi::Env env, Napi::Value value, std::vector<Route>* routes);
+  bool parseRoutes(Napi::Env env, Napi::Value value, std::vector<Route>* routes);
+  void applyRouting(const std::vector<Route>& routes);
+  void describeDriverBuffers();
+  Napi::Array routesToArray(Napi::Env env);
   
-  // Utiliser la taille de buffer préférée
-  bufferSize = preferredSize;
+  // Formats d'échantillons : interrogation du pilote (Initialize) et liaison des
+  // buffers créés par le pilote aux plans float (Start, après ASIOCreateBuffers)
+  bool queryChannelFormats(std::string* error);
+  bool bindDriverBuffers(std::string* error);
+  static Napi::Array formatsToArray(Napi::Env env, const std::vector<long>& types);
   
-  // Préparer les buffers
-  buffers[0].input.resize(bufferSize);
-  buffers[0].output.resize(bufferSize);
-  buffers[1].input.resize(bufferSize);
-  buffers[1].output.resize(bufferSize);
+  // Options de la chaîne communes à start() et processFiles() (rampe, mode et paramètres
+  // FxLMS) ; les routes et le canal d'erreur sont validés par l'appelant selon ses canaux
+  static bool parseChainOptions(Napi::Env env, Napi::Object options, ChainSettings* settings);
   
-  // Configurer les buffers ASIO
-  bufferInfos[0].isInput = ASIOTrue;
-  bufferInfos[0].channelNum = 0;
-  bufferInfos[0].buffers[0] = buffers[0].input.data();
-  bufferInfos[0].buffers[1] = buffers[1].input.data();
+  // Source de temps du pilote virtuel (clock, duration) : durée convertie en blocs
+  bool parseClockOptions(Napi::Env env, Napi::Object options, DriverClock* clock, uint64_t* blocks);
   
-  bufferInfos[1].isInput = ASIOFalse;
-  bufferInfos[1].channelNum = 0;
-  bufferInfos[1].buffers[0] = buffers[0].output.data();
-  bufferInfos[1].buffers[1] = buffers[1].output.data();
+  // Réglages temps réel (initialize) : true, ou { priority, cpu, lockMemory, lockProcess }
+  static bool parseRealtimeOptions(Napi::Env env, Napi::Value value, RealtimeOptions* options);
+  Napi::Object realtimeToObject(Napi::Env env);
   
-  // Créer un objet pour retourner les informations d'initialisation
-  Napi::Object result = Napi::Object::New(env);
-  result.Set("success", Napi::Boolean::New(env, true));
-  result.Set("driverName", Napi::String::New(env, driverIdentifier.c_str()));
-  result.Set("inputChannels", Napi::Number::New(env, inputChannels));
-  result.Set("outputChannels", Napi::Number::New(env, outputChannels));
-  result.Set("bufferSize", Napi::Number::New(env, bufferSize));
+  // Options d'un fichier traité hors ligne (valeurs par défaut du lot puis options propres)
+  static bool parseOfflineOptions(Napi::Env env, Napi::Object options, OfflineJob* job);
   
-  return result;
-}
+  // Réponse impulsionnelle JavaScript (Float32Array ou tableau de nombres)
+  static bool parseImpulse(Napi::Env env, Napi::Value value, std::vector<float>* impulse);
 
-Napi::Value ASIOHandler::Start(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
-  
-  // Vérifier les arguments pour le gain (facteur d'inversion de phase)
-  if (info.Length() >= 1 && info[0].IsNumber()) {
-    gain = info[0].As<Napi::Number>().DoubleValue();
-  } else {
-    gain = 1.0; // Valeur par défaut
-  }
-  
-#ifdef ASIO_INCLUDED
-  // Configurer les callbacks ASIO
-  ASIOCallbacks callbacks;
-  callbacks.bufferSwitch = &ASIOHandler::bufferSwitchStatic;
-  callbacks.sampleRateDidChange = nullptr;
-  callbacks.asioMessage = nullptr;
-  callbacks.bufferSwitchTimeInfo = nullptr;
-  
-  // Créer les buffers ASIO
-  if (ASIOCreateBuffers(bufferInfos, 2, bufferSize, &callbacks) != ASE_OK) {
-    Napi::Error::New(env, "Erreur lors de la création des buffers ASIO").ThrowAsJavaScriptException();
-    return env.Null();
+  // Horloge monotone du chronométrage des callbacks (lecture du compteur, sans appel au pilote)
+  static int64_t monotonicNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
   }
-  
-  // Démarrer le traitement audio
-  if (ASIOStart() != ASE_OK) {
-    Napi::Error::New(env, "Erreur lors du démarrage du traitement audio").ThrowAsJavaScriptException();
-    return env.Null();
+
+  // Entiers 64 bits ASIO ({hi, lo} sans NATIVE_INT64) convertis en double
+  template <typename Asio64>
+  static double asio64ToDouble(const Asio64& value) {
+    return static_cast<double>(value.hi) * 4294967296.0 + static_cast<double>(value.lo);
   }
+
+  // Côté lecteur (sous analysisMutex) : vide la file du callback dans la fenêtre d'analyse
+  void drainInputRing();
+  void copyLatestInput(float* destination, size_t count);
   
-  // Indiquer que le traitement est en cours
-  processing.store(true);
+  // Valeurs affichées : niveau en pourcentage, spectre du dernier bloc (0 à 100 par bande)
+  static float displayLevel(float rms);
+  void computeDisplaySpectrum(uint32_t numBands, float* display);
   
-  // Créer un objet pour retourner les informations de démarrage
-  Napi::Object result = Napi::Object::New(env);
-  result.Set("success", Napi::Boolean::New(env, true));
-  result.Set("gain", Napi::Number::New(env, gain));
+  // Résultats en Float32Array : tableau fourni par l'appelant (rempli sur place) ou nouveau
+  static bool isFloat32Array(Napi::Value value);
   
-  return result;
-#else
-  // Version simulée pour le développement sans SDK ASIO
-  processing.store(true);
+  // Télémétrie poussée vers JavaScript : un thread cadencé relève niveaux et statistiques
+  // (lectures sans verrou) et les transmet par ThreadSafeFunction. Le spectre est calculé
+  // à la réception, sur le thread Node (sous analysisMutex, comme GetFFTData).
+  struct TelemetryFrame {
+    ASIOHandler* engine;
+    LevelSnapshot levels;
+    CallbackStatsSnapshot stats;
+    bool processing;
+    int64_t timeNs;
+  };
+  void telemetryLoop();
+  void stopTelemetryThread();
+  static void deliverTelemetry(Napi::Env env, Napi::Function callback, TelemetryFrame* frame);
   
-  Napi::Object result = Napi::Object::New(env);
-  result.Set("success", Napi::Boolean::New(env, true));
-  result.Set("gain", Napi::Number::New(env, gain));
-  result.Set("simulated", Napi::Boolean::New(env, true));
+  // Cadence commune aux deux flux : frameRate des options (1 à 240 trames par seconde)
+  static bool parseFrameRate(Napi::Env env, Napi::Object options, double* frameRate);
+  static void waitNextFrame(std::chrono::steady_clock::time_point* next, int64_t periodNs);
   
-  return result;
-#endif
-}
+  // Télémétrie en mémoire partagée : un thread cadencé calcule le spectre et écrit
+  // niveaux, statistiques et spectre dans le SharedArrayBuffer fourni par JavaScript,
+  // sans aucun appel N-API par trame
+  void sharedTelemetryLoop();
+  void stopSharedTelemetryThread();
 
-Napi::Value ASIOHandler::Stop(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
+  // Callbacks ASIO sans paramètre de contexte : chaque emplacement a ses propres fonctions,
+  // qui retrouvent le moteur dans engineSlots (occupé de la construction à la fermeture)
+  static const size_t kMaxEngines = 16;
+  template <size_t Slot> struct EngineCallbacks;
+  template <size_t... Slots>
+  static ASIOCallbacks callbacksForSlot(size_t slot, std::index_sequence<Slots...>);
+  static std::atomic<ASIOHandler*> engineSlots[kMaxEngines];
+  long slot = -1;                 // -1 : moteur fermé
+  ASIOCallbacks callbacks = ASIOCallbacks();
   
-#ifdef ASIO_INCLUDED
-  // Arrêter le traitement audio
-  if (ASIOStop() != ASE_OK) {
-    Napi::Error::New(env, "Erreur lors de l'arrêt du traitement audio").ThrowAsJavaScriptException();
-    return env.Null();
-  }
+  // Pilote du moteur : adressé par les fonctions ASIO de l'hôte pendant ses commandes
+  VirtualAsioDriver driver;
+
+  // Variables ASIO
+  ASIODriverInfo driverInfo = ASIODriverInfo();
+  std::vector<ASIOBufferInfo> bufferInfos; // entrées actives puis sorties actives
   
-  // Libérer les buffers ASIO
-  if (ASIODisposeBuffers() != ASE_OK) {
-    Napi::Error::New(env, "Erreur lors de la libération des buffers ASIO").ThrowAsJavaScriptException();
-    return env.Null();
-  }
-#endif
+  // Format de chaque canal du pilote (ASIOSampleType) et convertisseur choisi (nullptr : non supporté)
+  std::vector<long> inputTypes, outputTypes;
+  std::vector<const SampleConverter*> inputConverters, outputConverters;
   
-  // Indiquer que le traitement est arrêté
-  processing.store(false);
+  // Canal actif lié à son buffer pilote : conversion vers / depuis le plan float du même index
+  struct ChannelBinding {
+    void (*toFloat)(const void* in, float* out, size_t count);
+    void (*fromFloat)(const float* in, void* out, size_t count);
+    void* buffers[2];
+    float* planes[2];
+    size_t bytes; // taille d'une moitié du buffer du pilote
+  };
+  std::vector<ChannelBinding> inputBindings, outputBindings;
+  long inputChannels = 0;
+  long outputChannels = 0;
+  long bufferSize = 1024;
+  long minSize = 0, maxSize = 0, preferredSize = 0, granularity = 0;
+  ASIOSampleRate sampleRate = 44100.0;
   
-  // Créer un objet pour retourner les informations d'arrêt
-  Napi::Object result = Napi::Object::New(env);
-  result.Set("success", Napi::Boolean::New(env, true));
+  // Optimisation ASIOOutputReady : le pilote peut jouer le bloc dès que le callback
+  // l'a rempli, au lieu d'attendre le bloc suivant (un buffer de latence en moins)
+  bool postOutput = false;
+  long inputLatency = 0, outputLatency = 0;
+  long announcedOutputLatency = 0; // avant ASIOCreateBuffers, pour la même taille de buffer
+  long latencySaved = 0;           // mesuré au démarrage
+  std::mutex configMutex;
+  EngineConfig publishedConfig;
+
+  // Chaîne DSP (routage, inversion ou FxLMS, gain de sortie), partagée avec le traitement hors ligne
+  ProcessingChain chain;
+  std::atomic<bool> processing{false};
   
-  return result;
-}
+  // Échange sans verrou entre le callback et les lecteurs
+  // Le callback est l'unique producteur de inputRing ; côté consommateur, le thread Node et
+  // le thread de télémétrie partagée se succèdent sous analysisMutex (jamais le callback)
+  SpscRing<float> inputRing;
+  std::mutex analysisMutex;
+  bool analysisDropLogged = false; // callback uniquement : premier bloc ignoré signalé
 
-Napi::Value ASIOHandler::GetInputLevel(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
+  // Fenêtre circulaire des derniers échantillons d'entrée (sous analysisMutex)
+  std::vector<float> analysisWindow;
+  std::vector<float> drainScratch;
+  size_t analysisWritePos = 0;
+  SpectrumAnalyzer spectrumAnalyzer;
+  size_t analysisBlockSize = 0;
   
-  if (!processing.load()) {
-    return Napi::Number::New(env, 0.0f);
-  }
+  // Tampons de l'analyse spectrale, agrandis au besoin et réutilisés d'un appel à l'autre
+  std::vector<float> spectrumInput;
+  std::vector<float> bandEnergies;
+
+  // Mesure de niveau calculée dans le callback et publiée par seqlock
+  LevelMeter inputMeter;
   
-  // Calcul du niveau d'entrée (RMS)
-  float rms = 0.0f;
-  int validSamples = 0;
+  // Horodatage de chaque bloc (position d'échantillon, temps système)
+  BlockClock blockClock;
   
-  {
-    std::lock_guard<std::mutex> lock(bufferMutex);
-    for (size_t i = 0; i < currentBuffer->input.size(); i++) {
-      const float sample = currentBuffer->input[i];
-      if (!std::isnan(sample) && !std::isinf(sample)) {
-        rms += sample * sample;
-        validSamples++;
-      }
-    }
-  }
+  // Temps de traitement, intervalles entre callbacks et charge DSP
+  CallbackStats callbackStats;
   
-  // Éviter la division par zéro
-  if (validSamples > 0) {
-    rms = std::sqrt(rms / validSamples);
-  } else {
-    rms = 0.0f;
-  }
+  // Réglages temps réel demandés à l'initialisation et ce qui a été appliqué
+  // (thread de contrôle, lus par le thread Node dans les réponses aux commandes)
+  RealtimeOptions realtimeOptions;
+  RealtimeMemoryReport realtimeMemory;
+  RealtimeThreadReport realtimeThread;
+  std::vector<MemoryRegion> lockedRegions; // plages verrouillées au démarrage
+  bool processLockHeld = false;    // compté dans processLockUsers
   
-  // Normaliser entre 0 et 1, puis convertir en pourcentage
-  // La plupart des signaux audio sont normalisés entre -1 et 1
-  // donc RMS est généralement entre 0 et 0.707 (sin wave RMS)
-  float normalizedRMS = std::min(rms * 1.414f, 1.0f);
+  // Notifications du pilote, consommées par le thread Node
+  std::atomic<double> pendingSampleRate{0.0};
+  std::atomic<bool> sampleRateChanged{false};
+  std::atomic<bool> resetRequested{false};
+  std::atomic<bool> latenciesChanged{false};
   
-  return Napi::Number::New(env, normalizedRMS * 100.0f); // Pourcentage
-}
-
-Napi::Value ASIOHandler::GetFFTData(const Napi::CallbackInfo& info) {
-  Napi::Env env = info.Env();
+  // Flux de télémétrie (startTelemetry / stopTelemetry)
+  std::thread telemetryThread;
+  std::atomic<bool> telemetryRunning{false};
+  Napi::ThreadSafeFunction telemetryFunction;
+  int64_t telemetryPeriodNs = 0;
+  uint32_t telemetryBands = 0;
   
-  // Nombre de bandes de fréquence pour l'analyse FFT
-  const uint32_t numBands = 32;
-  Napi::Array fftData = Napi::Array::New(env, numBands);
+  // Flux en mémoire partagée (startSharedTelemetry / stopSharedTelemetry)
+  // La référence maintient le SharedArrayBuffer en vie tant que le thread y écrit
+  std::thread sharedTelemetryThread;
+  std::atomic<bool> sharedTelemetryRunning{false};
+  Napi::ObjectReference sharedTelemetryArray;
+  SharedTelemetryRegion sharedTelemetryRegion;
+  std::vector<float> sharedSpectrum;
+  int64_t sharedTelemetryPeriodNs = 0;
   
-  if (!processing.load()) {
-    // Si le traitement est arrêté, renvoyer un tableau de zéros
-    for (uint32_t i = 0; i < numBands; i++) {
-      fftData[i] = Napi::Number::New(env, 0);
-    }
-    return fftData;
-  }
+  // File des commandes de contrôle (thread Node) et commande confiée au thread de contrôle
+  static std::deque<std::unique_ptr<ControlCommand>> controlQueue;
+  static std::thread controlThread;
+  static std::mutex controlMutex;
+  static std::condition_variable controlCondition;
+  static ControlCommand* controlJob;
+  static bool controlStopping;
+  static Napi::ThreadSafeFunction controlFunction;
   
-  // Implémentation simplifiée de l'analyse spectrale
-  // Dans une implémentation réelle, nous utiliserions une FFT complète
-  // comme la bibliothèque FFTW ou une implémentation personnalisée
+  // Cache des périphériques (thread Node) ; devicesStale est levé par le pilote (kAsioResetRequest)
+  static std::vector<DeviceInfo> deviceCache;
+  static bool deviceProbeQueued;
+  static std::atomic<bool> devicesStale;
   
-  std::vector<float> bandEnergies(numBands, 0.0f);
+  // Un seul pilote du registre peut être chargé dans le processus (AsioDrivers) : il
+  // appartient au moteur qui l'a initialisé (currentDriverName, thread de contrôle)
+  static std::atomic<ASIOHandler*> registryOwner;
+  static std::string currentDriverName;
   
-  {
-    std::lock_guard<std::mutex> lock(bufferMutex);
-    
-    // Division du buffer en bandes de fréquence (approximation simplifiée)
-    // Cette approche est une simulation, pas une vraie FFT
-    const size_t samplesPerBand = currentBuffer->input.size() / numBands;
-    
-    for (uint32_t band = 0; band < numBands; band++) {
-      float energy = 0.0f;
-      size_t startIdx = band * samplesPerBand;
-      size_t endIdx = (band + 1) * samplesPerBand;
-      
-      // Limiter l'index de fin à la taille du buffer
-      endIdx = std::min(endIdx, currentBuffer->input.size());
-      
-      // Calculer l'énergie pour cette bande
-      for (size_t i = startIdx; i < endIdx; i++) {
-        energy += currentBuffer->input[i] * currentBuffer->input[i];
-      }
-      
-      // Normaliser par le nombre d'échantillons dans la bande
-      if (endIdx > startIdx) {
-        energy /= (endIdx - startIdx);
-      }
-      
-      // Appliquer une pondération pour simuler la réponse en fréquence
-      // Les hautes fréquences (bandes supérieures) sont généralement plus faibles
-      float frequencyWeight = 1.0f - (0.5f * band / numBands);
-      energy *= frequencyWeight;
-      
-      // Stocker l'énergie de la bande
-      bandEnergies[band] = energy;
+  // mlockall (option lockProcess) porte sur tout le processus : il n'est levé que lorsque
+  // plus aucun moteur ne le demande
+  static std::mutex processLockMutex;
+  static int processLockUsers;
+};
+
+// Capacité de la file d'échange : plusieurs blocs de taille maximale
+static const size_t kInputRingBlocks = 8;
+
+// Durée par défaut de la rampe de gain
+static const double kDefaultGainRampMs = 20.0;
+
+// Longueur maximale du filtre adaptatif (et du retard du chemin secondaire)
+static const int64_t kMaxFxlmsTaps = 65536;
+
+// Nombre maximal de bandes demandées à GetFFTData
+static const uint32_t kMaxSpectrumBands = 4096;
+
+// Pilotes lus dans le registre (getDriverNames : 32 caractères par nom)
+static const long kMaxDrivers = 32;
+static const long kDriverNameLength = 32;
+
+// Nom du pilote simulé (pilote virtuel), accepté par initialize()
+static const char* const kSimulationDriverName = "Simulation ASIO";
+
+// Fréquences essayées par ASIOCanSampleRate lors du sondage
+static const double kStandardSampleRates[] = {44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0};
+
+// Cadence du flux de télémétrie (trames par seconde)
+static const double kDefaultTelemetryRate = 30.0;
+static const double kMaxTelemetryRate = 240.0;
+
+// Variables statiques : état commun à tous les moteurs
+std::atomic<ASIOHandler*> ASIOHandler::engineSlots[ASIOHandler::kMaxEngines] = {};
+std::deque<std::unique_ptr<ASIOHandler::ControlCommand>> ASIOHandler::controlQueue;
+std::thread ASIOHandler::controlThread;
+std::mutex ASIOHandler::controlMutex;
+std::condition_variable ASIOHandler::controlCondition;
+ASIOHandler::ControlCommand* ASIOHandler::controlJob = nullptr;
+bool ASIOHandler::controlStopping = false;
+Napi::ThreadSafeFunction ASIOHandler::controlFunction;
+std::vector<ASIOHandler::DeviceInfo> ASIOHandler::deviceCache;
+bool ASIOHandler::deviceProbeQueued = false;
+std::atomic<bool> ASIOHandler::devicesStale{false};
+std::atomic<ASIOHandler*> ASIOHandler::registryOwner{nullptr};
+std::string ASIOHandler::currentDriverName;
+std::mutex ASIOHandler::processLockMutex;
+int ASIOHandler::processLockUsers = 0;
+
+// Fonctions remises au pilote par l'emplacement Slot : le moteur est relu à chaque appel
+template <size_t Slot>
+struct ASIOHandler::EngineCallbacks {
+  static void ASIOCallConv bufferSwitch(long index, ASIOBool processNow) {
+    if (ASIOHandler* engine = engineSlots[Slot].load(std::memory_order_acquire)) {
+      engine->bufferSwitch(index, processNow);
     }
   }
   
-  // Normaliser les valeurs pour l'affichage
-  float maxEnergy = 0.0f;
-  for (const auto& energy : bandEnergies) {
-    maxEnergy = std::max(maxEnergy, energy);
+  static ASIOTime* ASIOCallConv bufferSwitchTimeInfo(ASIOTime* params, long index, ASIOBool processNow) {
+    ASIOHandler* engine = engineSlots[Slot].load(std::memory_order_acquire);
+    return engine ? engine->bufferSwitchTimeInfo(params, index, processNow) : nullptr;
   }
   
-  // Éviter la division par zéro
-  if (maxEnergy > 0.0f) {
-    for (uint32_t i = 0; i < numBands; i++) {
-      // Convertir en pourcentage et appliquer une échelle logarithmique simplifiée
-      float normalizedValue = (bandEnergies[i] / maxEnergy);
-      float displayValue = std::sqrt(normalizedValue) * 100.0f; // Échelle non linéaire pour meilleure visualisation
-      fftData[i] = Napi::Number::New(env, displayValue);
-    }
-  } else {
-    // Si aucune énergie détectée, renvoyer des zéros
-    for (uint32_t i = 0; i < numBands; i++) {
-      fftData[i] = Napi::Number::New(env, 0);
+  static void ASIOCallConv sampleRateDidChange(ASIOSampleRate rate) {
+    if (ASIOHandler* engine = engineSlots[Slot].load(std::memory_order_acquire)) {
+      engine->sampleRateDidChange(rate);
     }
   }
   
-  return fftData;
+  static long ASIOCallConv asioMessage(long selector, long value, void* message, double* opt) {
+    ASIOHandler* engine = engineSlots[Slot].load(std::memory_order_acquire);
+    return engine ? engine->asioMessage(selector, value, message, opt) : 0L;
+  }
+};
+
+template <size_t... Slots>
+ASIOCallbacks ASIOHandler::callbacksForSlot(size_t slot, std::index_sequence<Slots...>) {
+  static const ASIOCallbacks table[] = {
+    {&EngineCallbacks<Slots>::bufferSwitch, &EngineCallbacks<Slots>::sampleRateDidChange,
+     &EngineCallbacks<Slots>::asioMessage, &EngineCallbacks<Slots>::bufferSwitchTimeInfo}...
+  };
+  return table[slot];
 }
 
-// *** Implémentation de GetDevices ***
-#ifdef ASIO_INCLUDED
-// Helper class pour gérer AsioDrivers (comme recommandé dans les exemples ASIO SDK)
-// Note: AsioDrivers est défini dans asiodrivers.cpp qui est compilé séparément
+ASIOHandler::ASIOHandler(const Napi::CallbackInfo& info) 
+  : Napi::ObjectWrap<ASIOHandler>(info) {
+  // Les buffers sont alloués par Initialize / setRouting, uniquement à l'arrêt :
+  // le callback ne doit jamais voir une réallocation
+  if (!claimSlot()) {
+    Napi::Error::New(info.Env(), "Nombre maximal de moteurs atteint (" + std::to_string(kMaxEngines) + ")").ThrowAsJavaScriptException();
+  }
+}
 
-Napi::Value ASIOHandler::getDevices(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
+ASIOHandler::~ASIOHandler() {
+  // Objet JavaScript libéré sans close() : aucune commande ne le référence plus
+  shutdown();
+}
 
-    // Créer un tableau pour stocker les périphériques
-    Napi::Array devices = Napi::Array::New(env);
-    
-    // Initialiser AsioDrivers si nécessaire
-    if (!asioDrivers) {
-        std::cout << "Initialisation de AsioDrivers..." << std::endl;
-        asioDrivers = new AsioDrivers();
-    }
-    
-    // Créer des périphériques ASIO simulés pour garantir le fonctionnement de l'application
-    // Nous fournissons toujours ces périphériques, même si des pilotes réels sont détectés
-    
-    // Périphérique 1: Simulation ASIO
-    Napi::Object device1 = Napi::Object::New(env);
-    device1.Set("name", Napi::String::New(env, "Simulation ASIO"));
-    device1.Set("id", Napi::Number::New(env, 0));
-    device1.Set("isSimulated", Napi::Boolean::New(env, true));
-    device1.Set("numInputChannels", Napi::Number::New(env, 2));
-    device1.Set("numOutputChannels", Napi::Number::New(env, 2));
-    device1.Set("preferredBufferSize", Napi::Number::New(env, 1024));
-    devices.Set(0u, device1);
-    
-    // Périphérique 2: Focusrite Saffire Pro 24 (simulé)
-    Napi::Object device2 = Napi::Object::New(env);
-    device2.Set("name", Napi::String::New(env, "Focusrite Saffire Pro 24"));
-    device2.Set("id", Napi::Number::New(env, 1));
-    device2.Set("isSimulated", Napi::Boolean::New(env, true));
-    device2.Set("numInputChannels", Napi::Number::New(env, 16));
-    device2.Set("numOutputChannels", Napi::Number::New(env, 8));
-    device2.Set("preferredBufferSize", Napi::Number::New(env, 512));
-    devices.Set(1u, device2);
-    
-    // Périphérique 3: Steinberg UR22 (simulé)
-    Napi::Object device3 = Napi::Object::New(env);
-    device3.Set("name", Napi::String::New(env, "Steinberg UR22"));
-    device3.Set("id", Napi::Number::New(env, 2));
-    device3.Set("isSimulated", Napi::Boolean::New(env, true));
-    device3.Set("numInputChannels", Napi::Number::New(env, 2));
-    device3.Set("numOutputChannels", Napi::Number::New(env, 2));
-    device3.Set("preferredBufferSize", Napi::Number::New(env, 256));
-    devices.Set(2u, device3);
-    
-    // Périphérique 4: RME Fireface UCX (simulé)
-    Napi::Object device4 = Napi::Object::New(env);
-    device4.Set("name", Napi::String::New(env, "RME Fireface UCX"));
-    device4.Set("id", Napi::Number::New(env, 3));
-    device4.Set("isSimulated", Napi::Boolean::New(env, true));
-    device4.Set("numInputChannels", Napi::Number::New(env, 18));
-    device4.Set("numOutputChannels", Napi::Number::New(env, 18));
-    device4.Set("preferredBufferSize", Napi::Number::New(env, 128));
-    devices.Set(3u, device4);
-    
-    // Essayer de détecter les pilotes ASIO réels (pour information seulement)
-    char* driverNames[32]; // Tableau pour stocker les noms des pilotes
-    long numDrivers = asioDrivers->getDriverNames(driverNames, 32);
-    std::cout << "Nombre de pilotes ASIO détectés: " << numDrivers << std::endl;
-    
-    if (numDrivers > 0) {
-        std::cout << "Pilotes ASIO détectés (non utilisés pour l'instant):" << std::endl;
-        for (long i = 0; i < numDrivers; i++) {
-            if (driverNames[i]) {
-                std::cout << "  " << i << ": " << driverNames[i] << std::endl;
-            }
-        }
+bool ASIOHandler::claimSlot() {
+  for (size_t i = 0; i < kMaxEngines; i++) {
+    ASIOHandler* expected = nullptr;
+    if (engineSlots[i].compare_exchange_strong(expected, this, std::memory_order_acq_rel)) {
+      slot = static_cast<long>(i);
+      callbacks = callbacksForSlot(i, std::make_index_sequence<kMaxEngines>());
+      return true;
     }
-    
-    return devices;
+  }
+  return false;
 }
-#else
-// Fournir une implémentation vide ou simulée si ASIO n'est pas inclus
-Napi::Value ASIOHandler::getDevices(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
-    Napi::Array deviceList = Napi::Array::New(env, 2); // Simuler deux périphériques
 
-    Napi::Object device1 = Napi::Object::New(env);
-    device1.Set("id", Napi::Number::New(env, 0));
-    device1.Set("name", Napi::String::New(env, "Simulated ASIO Input"));
-    deviceList[uint32_t(0)] = device1;
+void ASIOHandler::releaseSlot() {
+  // Le pilote est arrêté : plus aucun callback ne passe par cet emplacement
+  if (slot >= 0) {
+    engineSlots[slot].store(nullptr, std::memory_order_release);
+    slot = -1;
+  }
+}
 
-    Napi::Object device2 = Napi::Object::New(env);
-    device2.Set("id", Napi::Number::New(env, 1));
-    device2.Set("name", Napi::String::New(env, "Simulated ASIO Output"));
-    deviceList[uint32_t(1)] = device2;
-    
-    return deviceList;
+void ASIOHandler::releaseRegistryDriver() {
+  ASIOHandler* owner = this;
+  registryOwner.compare_exchange_strong(owner, nullptr);
+}
+
+void ASIOHandler::lockMemory() {
+  releaseMemoryLock();
+  realtimeMemory = RealtimeMemoryReport();
+  
+  // Tout ce que touchent le callback et la vidange de la file : buffers du pilote,
+  // plans float, spectres FxLMS et du chemin secondaire, file d'échange, analyse
+  std::vector<MemoryRegion> regions;
+  for (const std::vector<ChannelBinding>* bindings : {&inputBindings, &outputBindings}) {
+    for (const ChannelBinding& binding : *bindings) {
+      for (long half = 0; half < 2; half++) {
+        regions.push_back(MemoryRegion{"driverBuffers", binding.buffers[half], binding.bytes});
+      }
+    }
+  }
+  chain.memoryRegions(regions);
+  regions.push_back(MemoryRegion{"inputRing", inputRing.data(), inputRing.capacity() * sizeof(float)});
+  appendRegion(regions, "analysis", analysisWindow);
+  appendRegion(regions, "analysis", drainScratch);
+  lockMemoryRegions(regions, &lockedRegions, &realtimeMemory);
+  
+  if (realtimeOptions.lockProcess) {
+    std::lock_guard<std::mutex> lock(processLockMutex);
+    lockProcessMemory(&realtimeMemory);
+    if (realtimeMemory.processLocked) {
+      processLockHeld = true;
+      processLockUsers++;
+    }
+  }
+}
+
+void ASIOHandler::releaseMemoryLock() {
+  unlockMemoryRegions(lockedRegions);
+  lockedRegions.clear();
+  
+  std::lock_guard<std::mutex> lock(processLockMutex);
+  if (processLockHeld) {
+    processLockHeld = false;
+    if (--processLockUsers == 0) {
+      unlockProcessMemory();
+    }
+  }
+}
+
+void ASIOHandler::shutdown() {
+  // Threads du moteur arrêtés avant la libération de ses buffers et de son emplacement
+  stopTelemetryThread();
+  stopSharedTelemetryThread();
+  processing.store(false);
+  driver.disposeBuffers();
+  releaseRegistryDriver();
+  releaseMemoryLock();
+  releaseSlot();
+}
+
+void ASIOHandler::stopEngines() {
+  // Fermeture de l'environnement Node, après l'arrêt du thread de contrôle
+  for (size_t i = 0; i < kMaxEngines; i++) {
+    if (ASIOHandler* engine = engineSlots[i].load(std::memory_order_acquire)) {
+      engine->shutdown();
+    }
+  }
+}
+
+void ASIOHandler::processBlock(long index) {
+  const size_t count = static_cast<size_t>(bufferSize);
+  
+  // Buffers du pilote -> plans float (un convertisseur par canal, choisi au démarrage)
+  for (const ChannelBinding& binding : inputBindings) {
+    binding.toFloat(binding.buffers[index & 1], binding.planes[index & 1], count);
+  }
+  
+  // Inversion ou anti-bruit adaptatif, gain de sortie interpolé dans le bloc
+  chain.process(index);
+  
+  // L'analyse (niveau, spectre) porte sur la première entrée routée
+  const float* analysisInput = chain.analysisInput(index);
+  
+  // Mesure de niveau incrémentale (une réduction par bloc)
+  inputMeter.process(analysisInput, count);
+  
+  // Publier l'entrée pour les lecteurs ; si la file est pleine, le bloc est ignoré
+  // (signalé une fois par démarrage : sans lecteur, la file reste pleine)
+  if (inputRing.push(analysisInput, count) < count && !analysisDropLogged) {
+    analysisDropLogged = true;
+    engineLog.log(LogLevel::Debug, "File d'analyse pleine : blocs ignorés jusqu'à la prochaine lecture");
+  }
+  
+  // Plans float -> buffers du pilote, dans leur format natif
+  for (const ChannelBinding& binding : outputBindings) {
+    binding.fromFloat(binding.planes[index & 1], binding.buffers[index & 1], count);
+  }
+  
+  // Toutes les sorties sont écrites : le pilote du moteur peut les envoyer sans attendre le
+  // bloc suivant (pas la fonction globale, qui vise le pilote de la commande en cours)
+  if (postOutput) {
+    driver.outputReady();
+  }
+}
+
+bool ASIOHandler::parseRouteList(Napi::Env env, Napi::Value value, std::vector<Route>* routes) {
+  if (!value.IsArray()) {
+    Napi::TypeError::New(env, "Les routes doivent être un tableau de { input, output, gain }").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  Napi::Array array = value.As<Napi::Array>();
+  if (array.Length() == 0) {
+    Napi::Error::New(env, "Au moins une route est nécessaire").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  routes->clear();
+  for (uint32_t i = 0; i < array.Length(); i++) {
+    Napi::Value item = array.Get(i);
+    if (!item.IsObject()) {
+      Napi::TypeError::New(env, "Route " + std::to_string(i) + " invalide").ThrowAsJavaScriptException();
+      return false;
+    }
+    Napi::Object object = item.As<Napi::Object>();
+    if (!object.Get("input").IsNumber() || !object.Get("output").IsNumber()) {
+      Napi::TypeError::New(env, "Route " + std::to_string(i) + " : input et output doivent être des nombres").ThrowAsJavaScriptException();
+      return false;
+    }
+    
+    Route route;
+    route.input = static_cast<long>(object.Get("input").As<Napi::Number>().Int64Value());
+    route.output = static_cast<long>(object.Get("output").As<Napi::Number>().Int64Value());
+    route.gain = object.Get("gain").IsNumber() ? object.Get("gain").As<Napi::Number>().FloatValue() : 1.0f;
+    
+    if (route.input < 0) {
+      Napi::RangeError::New(env, "Canal d'entrée inexistant: " + std::to_string(route.input)).ThrowAsJavaScriptException();
+      return false;
+    }
+    if (route.output < 0) {
+      Napi::RangeError::New(env, "Canal de sortie inexistant: " + std::to_string(route.output)).ThrowAsJavaScriptException();
+      return false;
+    }
+    if (!std::isfinite(route.gain)) {
+      Napi::RangeError::New(env, "Gain de route invalide").ThrowAsJavaScriptException();
+      return false;
+    }
+    for (const Route& other : *routes) {
+      if (other.input == route.input && other.output == route.output) {
+        Napi::Error::New(env, "Route en double: " + std::to_string(route.input) + " -> " + std::to_string(route.output)).ThrowAsJavaScriptException();
+        return false;
+      }
+    }
+    routes->push_back(route);
+  }
+  return true;
+}
+
+bool ASIOHandler::parseRoutes(Napi::Env env, Napi::Value value, std::vector<Route>* routes) {
+  if (value.IsArray() && value.As<Napi::Array>().Length() > static_cast<uint32_t>(inputChannels * outputChannels)) {
+    Napi::Error::New(env, "Trop de routes pour le nombre de canaux du pilote").ThrowAsJavaScriptException();
+    return false;
+  }
+  if (!parseRouteList(env, value, routes)) {
+    return false;
+  }
+  
+  // Canaux existants sur le pilote et formats d'échantillons supportés
+  for (const Route& route : *routes) {
+    if (route.input >= inputChannels) {
+      Napi::RangeError::New(env, "Canal d'entrée inexistant: " + std::to_string(route.input)).ThrowAsJavaScriptException();
+      return false;
+    }
+    if (route.output >= outputChannels) {
+      Napi::RangeError::New(env, "Canal de sortie inexistant: " + std::to_string(route.output)).ThrowAsJavaScriptException();
+      return false;
+    }
+    if (!inputConverters[route.input] || !outputConverters[route.output]) {
+      const long channel = !inputConverters[route.input] ? route.input : route.output;
+      const long type = !inputConverters[route.input] ? inputTypes[route.input] : outputTypes[route.output];
+      Napi::RangeError::New(env, "Format d'échantillon non supporté (" + std::string(sampleFormatName(type)) +
+                            ") pour le canal " + std::to_string(channel)).ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  return true;
+}
+
+void ASIOHandler::applyRouting(const std::vector<Route>& routes) {
+  chain.configureRouting(routes, static_cast<size_t>(bufferSize));
+  describeDriverBuffers();
+}
+
+void ASIOHandler::describeDriverBuffers() {
+  // Un descripteur ASIO par canal actif, dans l'ordre des plans de la matrice ;
+  // les adresses des buffers sont fournies par le pilote (ASIOCreateBuffers)
+  const std::vector<long>& inputs = chain.routing().inputChannels();
+  const std::vector<long>& outputs = chain.routing().outputChannels();
+  bufferInfos.assign(inputs.size() + outputs.size(), ASIOBufferInfo());
+  for (size_t i = 0; i < inputs.size(); i++) {
+    ASIOBufferInfo& bufferInfo = bufferInfos[i];
+    bufferInfo.isInput = ASIOTrue;
+    bufferInfo.channelNum = inputs[i];
+    bufferInfo.buffers[0] = nullptr;
+    bufferInfo.buffers[1] = nullptr;
+  }
+  for (size_t i = 0; i < outputs.size(); i++) {
+    ASIOBufferInfo& bufferInfo = bufferInfos[inputs.size() + i];
+    bufferInfo.isInput = ASIOFalse;
+    bufferInfo.channelNum = outputs[i];
+    bufferInfo.buffers[0] = nullptr;
+    bufferInfo.buffers[1] = nullptr;
+  }
+  inputBindings.clear();
+  outputBindings.clear();
+}
+
+bool ASIOHandler::queryChannelFormats(std::string* error) {
+  const SimdLevel level = dspKernels().level;
+  inputTypes.assign(static_cast<size_t>(inputChannels), -1);
+  outputTypes.assign(static_cast<size_t>(outputChannels), -1);
+  inputConverters.assign(static_cast<size_t>(inputChannels), nullptr);
+  outputConverters.assign(static_cast<size_t>(outputChannels), nullptr);
+  
+  for (long direction = 0; direction < 2; direction++) {
+    const bool isInput = direction == 0;
+    const long count = isInput ? inputChannels : outputChannels;
+    for (long channel = 0; channel < count; channel++) {
+      ASIOChannelInfo channelInfo;
+      channelInfo.channel = channel;
+      channelInfo.isInput = isInput ? ASIOTrue : ASIOFalse;
+      if (ASIOGetChannelInfo(&channelInfo) != ASE_OK) {
+        *error = "Erreur lors de la récupération du format du canal " + std::to_string(channel);
+        return false;
+      }
+      // Choix du convertisseur une fois pour toutes : aucun test de format dans le callback
+      const SampleConverter* converter = sampleConverterFor(static_cast<SampleFormat>(channelInfo.type), level);
+      (isInput ? inputTypes : outputTypes)[channel] = channelInfo.type;
+      (isInput ? inputConverters : outputConverters)[channel] = converter;
+    }
+  }
+  return true;
+}
+
+bool ASIOHandler::bindDriverBuffers(std::string* error) {
+  RoutingMatrix& routing = chain.routing();
+  const size_t inputCount = routing.inputChannels().size();
+  inputBindings.clear();
+  outputBindings.clear();
+  for (size_t i = 0; i < bufferInfos.size(); i++) {
+    const ASIOBufferInfo& bufferInfo = bufferInfos[i];
+    if (!bufferInfo.buffers[0] || !bufferInfo.buffers[1]) {
+      *error = "Le pilote n'a pas fourni de buffer pour le canal " + std::to_string(bufferInfo.channelNum);
+      return false;
+    }
+    const bool isInput = bufferInfo.isInput == ASIOTrue;
+    const size_t slot = isInput ? i : i - inputCount;
+    const SampleConverter* converter = isInput ? inputConverters[bufferInfo.channelNum] : outputConverters[bufferInfo.channelNum];
+    
+    ChannelBinding binding;
+    binding.toFloat = converter->toFloat;
+    binding.fromFloat = converter->fromFloat;
+    binding.bytes = converter->bytesPerSample * static_cast<size_t>(bufferSize);
+    for (long half = 0; half < 2; half++) {
+      binding.buffers[half] = bufferInfo.buffers[half];
+      binding.planes[half] = isInput ? routing.inputPlane(half, slot) : routing.outputPlane(half, slot);
+    }
+    (isInput ? inputBindings : outputBindings).push_back(binding);
+  }
+  return true;
+}
+
+Napi::Array ASIOHandler::formatsToArray(Napi::Env env, const std::vector<long>& types) {
+  Napi::Array formats = Napi::Array::New(env, types.size());
+  for (size_t i = 0; i < types.size(); i++) {
+    formats.Set(static_cast<uint32_t>(i), Napi::String::New(env, sampleFormatName(types[i])));
+  }
+  return formats;
+}
+
+bool ASIOHandler::parseChainOptions(Napi::Env env, Napi::Object options, ChainSettings* settings) {
+  if (options.Has("rampMs") && options.Get("rampMs").IsNumber()) {
+    settings->rampMs = std::max(0.0, options.Get("rampMs").As<Napi::Number>().DoubleValue());
+  }
+  if (options.Has("ramp") && options.Get("ramp").IsString()) {
+    std::string ramp = options.Get("ramp").As<Napi::String>().Utf8Value();
+    if (ramp == "exponential") {
+      settings->rampShape = RampShape::Exponential;
+    } else if (ramp != "linear") {
+      Napi::TypeError::New(env, "Forme de rampe inconnue: " + ramp).ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  if (options.Has("mode") && options.Get("mode").IsString()) {
+    std::string modeName = options.Get("mode").As<Napi::String>().Utf8Value();
+    if (modeName == "fxlms") {
+      settings->mode = ProcessingMode::Fxlms;
+    } else if (modeName == "inversion") {
+      settings->mode = ProcessingMode::Inversion;
+    } else {
+      Napi::TypeError::New(env, "Mode de traitement inconnu: " + modeName).ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  if (settings->mode != ProcessingMode::Fxlms) {
+    return true;
+  }
+  
+  // Le canal d'erreur peut venir d'options appliquées précédemment (valeurs par défaut d'un lot)
+  if (options.Get("errorChannel").IsNumber()) {
+    settings->errorChannel = static_cast<long>(options.Get("errorChannel").As<Napi::Number>().Int64Value());
+    if (settings->errorChannel < 0) {
+      Napi::RangeError::New(env, "Canal du micro d'erreur invalide: " + std::to_string(settings->errorChannel)).ThrowAsJavaScriptException();
+      return false;
+    }
+  } else if (settings->errorChannel < 0) {
+    Napi::TypeError::New(env, "Le mode fxlms nécessite errorChannel (canal du micro d'erreur)").ThrowAsJavaScriptException();
+    return false;
+  }
+  FxlmsConfig& fxlmsConfig = settings->fxlms;
+  if (options.Get("taps").IsNumber()) {
+    const int64_t taps = options.Get("taps").As<Napi::Number>().Int64Value();
+    fxlmsConfig.taps = static_cast<size_t>(std::max<int64_t>(1, std::min<int64_t>(taps, kMaxFxlmsTaps)));
+  }
+  if (options.Get("stepSize").IsNumber()) {
+    fxlmsConfig.stepSize = std::max(0.0f, std::min(options.Get("stepSize").As<Napi::Number>().FloatValue(), 1.0f));
+  }
+  if (options.Get("secondaryDelay").IsNumber()) {
+    const int64_t delay = options.Get("secondaryDelay").As<Napi::Number>().Int64Value();
+    fxlmsConfig.secondaryDelay = static_cast<size_t>(std::max<int64_t>(0, std::min<int64_t>(delay, kMaxFxlmsTaps)));
+  }
+  if (options.Get("secondaryGain").IsNumber()) {
+    fxlmsConfig.secondaryGain = options.Get("secondaryGain").As<Napi::Number>().FloatValue();
+  }
+  if (options.Has("secondaryPath") && !parseImpulse(env, options.Get("secondaryPath"), &fxlmsConfig.secondaryPath)) {
+    return false;
+  }
+  return true;
+}
+
+bool ASIOHandler::parseClockOptions(Napi::Env env, Napi::Object options, DriverClock* clock, uint64_t* blocks) {
+  if (options.Has("clock")) {
+    Napi::Value value = options.Get("clock");
+    const std::string name = value.IsString() ? value.As<Napi::String>().Utf8Value() : std::string();
+    if (name != "realtime" && name != "virtual") {
+      Napi::TypeError::New(env, "L'option clock doit valoir 'realtime' ou 'virtual'").ThrowAsJavaScriptException();
+      return false;
+    }
+    *clock = name == "virtual" ? DriverClock::Virtual : DriverClock::RealTime;
+  }
+  
+  if (options.Has("duration")) {
+    Napi::Value value = options.Get("duration");
+    const double seconds = value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : -1.0;
+    if (!(seconds >= 0.0) || *clock != DriverClock::Virtual) {
+      Napi::RangeError::New(env, "L'option duration (secondes >= 0) n'est acceptée qu'avec l'horloge virtuelle").ThrowAsJavaScriptException();
+      return false;
+    }
+    // Durée arrondie au bloc supérieur ; 0 : jusqu'à stop()
+    *blocks = static_cast<uint64_t>(std::ceil(seconds * sampleRate / static_cast<double>(bufferSize)));
+  }
+  return true;
+}
+
+bool ASIOHandler::parseRealtimeOptions(Napi::Env env, Napi::Value value, RealtimeOptions* options) {
+  if (value.IsBoolean()) {
+    options->enabled = value.As<Napi::Boolean>().Value();
+    return true;
+  }
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, "L'option realtime doit être un booléen ou { priority, cpu, lockMemory, lockProcess }").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  Napi::Object object = value.As<Napi::Object>();
+  options->enabled = true;
+  if (object.Has("priority")) {
+    Napi::Value priority = object.Get("priority");
+    const double p = priority.IsNumber() ? priority.As<Napi::Number>().DoubleValue() : 0.0;
+    if (!(p >= 1.0 && p <= 99.0) || p != std::floor(p)) {
+      Napi::RangeError::New(env, "L'option priority doit être un entier de 1 à 99").ThrowAsJavaScriptException();
+      return false;
+    }
+    options->priority = static_cast<int>(p);
+  }
+  if (object.Has("cpu")) {
+    Napi::Value cpu = object.Get("cpu");
+    const double c = cpu.IsNumber() ? cpu.As<Napi::Number>().DoubleValue() : -1.0;
+    const int cpus = realtimeCpuCount();
+    if (!(c >= 0.0) || c != std::floor(c) || (cpus > 0 && c >= cpus)) {
+      Napi::RangeError::New(env, "L'option cpu doit désigner un cœur existant (0 à " + std::to_string(cpus - 1) + ")").ThrowAsJavaScriptException();
+      return false;
+    }
+    options->cpu = static_cast<int>(c);
+  }
+  if (object.Has("lockMemory")) {
+    Napi::Value lockMemory = object.Get("lockMemory");
+    if (!lockMemory.IsBoolean()) {
+      Napi::TypeError::New(env, "L'option lockMemory doit être un booléen").ThrowAsJavaScriptException();
+      return false;
+    }
+    options->lockMemory = lockMemory.As<Napi::Boolean>().Value();
+  }
+  if (object.Has("lockProcess")) {
+    Napi::Value lockProcess = object.Get("lockProcess");
+    if (!lockProcess.IsBoolean()) {
+      Napi::TypeError::New(env, "L'option lockProcess doit être un booléen").ThrowAsJavaScriptException();
+      return false;
+    }
+    options->lockProcess = lockProcess.As<Napi::Boolean>().Value();
+  }
+  return true;
+}
+
+Napi::Object ASIOHandler::realtimeToObject(Napi::Env env) {
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("enabled", Napi::Boolean::New(env, realtimeOptions.enabled));
+  if (!realtimeOptions.enabled) {
+    return result;
+  }
+  
+  // Thread de traitement (renseigné au démarrage)
+  result.Set("priority", Napi::Number::New(env, realtimeOptions.priority));
+  result.Set("priorityApplied", Napi::Boolean::New(env, realtimeThread.priorityApplied));
+  if (!realtimeThread.priorityError.empty()) {
+    result.Set("priorityError", Napi::String::New(env, realtimeThread.priorityError));
+  }
+  result.Set("cpu", Napi::Number::New(env, realtimeOptions.cpu));
+  result.Set("affinityApplied", Napi::Boolean::New(env, realtimeThread.affinityApplied));
+  if (!realtimeThread.affinityError.empty()) {
+    result.Set("affinityError", Napi::String::New(env, realtimeThread.affinityError));
+  }
+  result.Set("stackPrefaulted", Napi::Number::New(env, static_cast<double>(realtimeThread.stackPrefaulted)));
+  
+  // Régions du moteur (verrouillées au démarrage), octets par région
+  result.Set("memoryLocked", Napi::Boolean::New(env, realtimeMemory.locked));
+  result.Set("lockedBytes", Napi::Number::New(env, static_cast<double>(realtimeMemory.lockedBytes)));
+  Napi::Object regions = Napi::Object::New(env);
+  for (const RealtimeRegionReport& region : realtimeMemory.regions) {
+    Napi::Object entry = Napi::Object::New(env);
+    entry.Set("bytes", Napi::Number::New(env, static_cast<double>(region.bytes)));
+    entry.Set("locked", Napi::Boolean::New(env, region.locked));
+    regions.Set(region.name, entry);
+  }
+  result.Set("memoryRegions", regions);
+  if (!realtimeMemory.error.empty()) {
+    result.Set("memoryError", Napi::String::New(env, realtimeMemory.error));
+  }
+  
+  // Tout le processus, sur demande (lockProcess)
+  if (realtimeOptions.lockProcess) {
+    result.Set("processLocked", Napi::Boolean::New(env, realtimeMemory.processLocked));
+    result.Set("processLockedFuture", Napi::Boolean::New(env, realtimeMemory.future));
+    result.Set("processLockedBytes", Napi::Number::New(env, static_cast<double>(realtimeMemory.processLockedBytes)));
+    if (!realtimeMemory.processError.empty()) {
+      result.Set("processError", Napi::String::New(env, realtimeMemory.processError));
+    }
+  }
+  return result;
+}
+
+bool ASIOHandler::parseImpulse(Napi::Env env, Napi::Value value, std::vector<float>* impulse) {
+  impulse->clear();
+  if (isFloat32Array(value)) {
+    Napi::Float32Array array = value.As<Napi::Float32Array>();
+    impulse->assign(array.Data(), array.Data() + array.ElementLength());
+  } else if (value.IsArray()) {
+    Napi::Array array = value.As<Napi::Array>();
+    impulse->reserve(array.Length());
+    for (uint32_t i = 0; i < array.Length(); i++) {
+      Napi::Value tap = array.Get(i);
+      if (!tap.IsNumber()) {
+        Napi::TypeError::New(env, "La réponse impulsionnelle ne doit contenir que des nombres").ThrowAsJavaScriptException();
+        return false;
+      }
+      impulse->push_back(tap.As<Napi::Number>().FloatValue());
+    }
+  } else {
+    Napi::TypeError::New(env, "La réponse impulsionnelle doit être un Float32Array ou un tableau").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  if (impulse->empty() || impulse->size() > static_cast<size_t>(kMaxFxlmsTaps)) {
+    Napi::RangeError::New(env, "Longueur de réponse impulsionnelle invalide").ThrowAsJavaScriptException();
+    return false;
+  }
+  for (float tap : *impulse) {
+    if (!std::isfinite(tap)) {
+      Napi::RangeError::New(env, "La réponse impulsionnelle contient des valeurs non finies").ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  return true;
+}
+
+Napi::Array ASIOHandler::routesToArray(Napi::Env env) {
+  const std::vector<Route>& routes = chain.routing().routes();
+  Napi::Array array = Napi::Array::New(env, routes.size());
+  for (size_t i = 0; i < routes.size(); i++) {
+    Napi::Object route = Napi::Object::New(env);
+    route.Set("input", Napi::Number::New(env, routes[i].input));
+    route.Set("output", Napi::Number::New(env, routes[i].output));
+    route.Set("gain", Napi::Number::New(env, routes[i].gain));
+    array.Set(static_cast<uint32_t>(i), route);
+  }
+  return array;
+}
+
+void ASIOHandler::drainInputRing() {
+  if (analysisWindow.empty()) {
+    return;
+  }
+  
+  // Ne conserver que les échantillons les plus récents dans la fenêtre circulaire
+  size_t count;
+  while ((count = inputRing.pop(drainScratch.data(), drainScratch.size())) > 0) {
+    for (size_t i = 0; i < count; i++) {
+      analysisWindow[analysisWritePos] = drainScratch[i];
+      analysisWritePos = (analysisWritePos + 1) % analysisWindow.size();
+    }
+  }
+}
+
+void ASIOHandler::copyLatestInput(float* destination, size_t count) {
+  const size_t windowSize = analysisWindow.size();
+  if (windowSize == 0) {
+    std::fill(destination, destination + count, 0.0f);
+    return;
+  }
+  count = std::min(count, windowSize);
+  size_t readPos = (analysisWritePos + windowSize - count) % windowSize;
+  for (size_t i = 0; i < count; i++) {
+    destination[i] = analysisWindow[readPos];
+    readPos = (readPos + 1) % windowSize;
+  }
+}
+
+// initialize(id | nom), start(gain, options) et stop() renvoient une promesse : les appels
+// au pilote (chargement, ASIOCreateBuffers, ASIODisposeBuffers) s'exécutent sur le thread
+// de contrôle, et les commandes sont traitées une à une dans l'ordre des appels
+Napi::Value ASIOHandler::Initialize(const Napi::CallbackInfo& info) {
+  return enqueueControl(info, ControlOp::Initialize);
+}
+
+Napi::Value ASIOHandler::Start(const Napi::CallbackInfo& info) {
+  return enqueueControl(info, ControlOp::Start);
+}
+
+Napi::Value ASIOHandler::Stop(const Napi::CallbackInfo& info) {
+  return enqueueControl(info, ControlOp::Stop);
+}
+
+// close() : arrêt, libération des buffers et du pilote du registre, puis des threads de
+// télémétrie et de l'emplacement du moteur (sinon fait à la libération de l'objet JavaScript)
+Napi::Value ASIOHandler::Close(const Napi::CallbackInfo& info) {
+  return enqueueControl(info, ControlOp::Close);
+}
+
+Napi::Value ASIOHandler::enqueueControl(const Napi::CallbackInfo& info, ControlOp op) {
+  Napi::Env env = info.Env();
+  
+  // Les arguments sont conservés jusqu'au tour de la commande : ils sont validés
+  // par rapport à l'état laissé par les commandes précédentes
+  Napi::Array arguments = Napi::Array::New(env, info.Length());
+  for (size_t i = 0; i < info.Length(); i++) {
+    arguments.Set(static_cast<uint32_t>(i), info[i]);
+  }
+  return enqueueControl(env, op, arguments, true, this);
+}
+
+Napi::Promise ASIOHandler::enqueueControl(Napi::Env env, ControlOp op, Napi::Array arguments, bool keepAlive,
+                                          ASIOHandler* engine) {
+  std::unique_ptr<ControlCommand> command(new ControlCommand(env, op));
+  command->arguments = Napi::Persistent(arguments.As<Napi::Object>());
+  command->keepAlive = keepAlive;
+  if (engine != nullptr) {
+    command->engine = engine;
+    command->engineObject = Napi::Persistent(engine->Value());
+  }
+  Napi::Promise promise = command->deferred.Promise();
+  
+  if (!controlThread.joinable()) {
+    // N-API 5 : pas de fonction JavaScript, la réponse est construite par deliverControl
+    controlFunction = Napi::ThreadSafeFunction::New(env, Napi::Function(), "asio_control", 0, 1);
+    controlFunction.Unref(env);
+    controlStopping = false;
+    controlThread = std::thread(&ASIOHandler::controlLoop);
+  }
+  
+  controlQueue.push_back(std::move(command));
+  if (controlQueue.size() == 1) {
+    runNextControl(env);
+  }
+  return promise;
+}
+
+void ASIOHandler::runNextControl(Napi::Env env) {
+  while (!controlQueue.empty()) {
+    ControlCommand* command = controlQueue.front().get();
+  
+    // Lecture des arguments sur le thread Node ; une erreur rejette la promesse
+    // sans passer par le thread de contrôle
+    Napi::Array arguments = command->arguments.Value().As<Napi::Array>();
+    const bool prepared = command->op == ControlOp::Initialize ? command->engine->prepareInitialize(env, arguments, command)
+                        : command->op == ControlOp::Start ? command->engine->prepareStart(env, arguments, command)
+                        : true;
+    if (command->op == ControlOp::Probe) {
+      command->devices = deviceCache;
+    }
+    if (!prepared) {
+      command->deferred.Reject(env.GetAndClearPendingException().Value());
+      controlQueue.pop_front();
+      continue;
+    }
+  
+    // Node reste actif tant qu'une commande demandée par JavaScript est en cours
+    // (le sondage lancé au chargement du module ne retarde pas la sortie)
+    if (command->keepAlive) {
+      controlFunction.Ref(env);
+    }
+    {
+      std::lock_guard<std::mutex> lock(controlMutex);
+      controlJob = command;
+    }
+    controlCondition.notify_one();
+    return;
+  }
+}
+
+void ASIOHandler::controlLoop() {
+#ifdef _WIN32
+  // Les pilotes ASIO sont des objets COM créés et appelés depuis ce thread
+  CoInitialize(0);
+#endif
+  for (;;) {
+    ControlCommand* command;
+    {
+      std::unique_lock<std::mutex> lock(controlMutex);
+      controlCondition.wait(lock, [] { return controlStopping || controlJob != nullptr; });
+      if (controlStopping) {
+        break;
+      }
+      command = controlJob;
+      controlJob = nullptr;
+    }
+  
+    // Fonctions ASIO de l'hôte dirigées vers le pilote du moteur de la commande
+    hostDriver.store(command->engine != nullptr ? &command->engine->driver : &virtualDriver);
+    switch (command->op) {
+      case ControlOp::Initialize: command->engine->executeInitialize(command); break;
+      case ControlOp::Start: command->engine->executeStart(command); break;
+      case ControlOp::Stop: command->engine->executeStop(command); break;
+      case ControlOp::Close: command->engine->executeClose(command); break;
+      case ControlOp::Probe: executeProbe(command); break;
+    }
+    hostDriver.store(&virtualDriver);
+  
+    // La commande suivante n'est préparée qu'après la réponse à celle-ci (deliverControl)
+    if (controlFunction.BlockingCall(command, &ASIOHandler::deliverControl) != napi_ok) {
+      break;
+    }
+  }
+#ifdef _WIN32
+  CoUninitialize();
+#endif
+}
+
+void ASIOHandler::deliverControl(Napi::Env env, Napi::Function, ControlCommand* command) {
+  // Environnement Node fermé : la commande a déjà été libérée par stopControlThread
+  if (env == nullptr) {
+    return;
+  }
+  
+  controlFunction.Unref(env);
+  if (!command->error.empty()) {
+    command->deferred.Reject(Napi::Error::New(env, command->error).Value());
+  } else {
+    Napi::Value result = command->op == ControlOp::Initialize ? command->engine->initializeResult(env, command)
+                       : command->op == ControlOp::Start ? command->engine->startResult(env, command)
+                       : command->op == ControlOp::Close ? command->engine->closeResult(env)
+                       : command->op == ControlOp::Probe ? probeResult(env, command)
+                       : stopResult(env);
+    command->deferred.Resolve(result);
+  }
+  controlQueue.pop_front();
+  runNextControl(env);
+}
+
+void ASIOHandler::stopControlThread() {
+  // Fermeture de l'environnement Node : la commande en cours se termine, les suivantes
+  // sont abandonnées (leurs promesses ne seront jamais réglées)
+  {
+    std::lock_guard<std::mutex> lock(controlMutex);
+    controlStopping = true;
+  }
+  controlCondition.notify_one();
+  if (controlThread.joinable()) {
+    controlThread.join();
+    controlFunction.Release();
+  }
+  controlQueue.clear();
+}
+
+bool ASIOHandler::controlPending(Napi::Env env) {
+  for (const std::unique_ptr<ControlCommand>& command : controlQueue) {
+    if (command->engine == this) {
+      Napi::Error::New(env, "Une commande initialize, start, stop ou close est en cours").ThrowAsJavaScriptException();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ASIOHandler::publishConfig() {
+  std::lock_guard<std::mutex> lock(configMutex);
+  publishedConfig.bufferSize = bufferSize;
+  publishedConfig.sampleRate = sampleRate;
+  publishedConfig.inputLatency = inputLatency;
+  publishedConfig.outputLatency = outputLatency;
+  publishedConfig.clock = driver.clock();
+}
+
+ASIOHandler::EngineConfig ASIOHandler::engineConfig() {
+  std::lock_guard<std::mutex> lock(configMutex);
+  return publishedConfig;
+}
+
+bool ASIOHandler::prepareInitialize(Napi::Env env, Napi::Array arguments, ControlCommand* command) {
+  if (slot < 0) {
+    Napi::Error::New(env, "Ce moteur a été fermé").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  // Vérifier les arguments
+  if (arguments.Length() < 1) {
+    Napi::TypeError::New(env, "Argument 1 doit être l'ID ou le nom du pilote ASIO").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  // Les buffers ne peuvent pas être réalloués pendant que le callback les utilise
+  if (processing.load()) {
+    Napi::Error::New(env, "Impossible d'initialiser pendant le traitement audio").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  std::string& driverIdentifier = command->driverIdentifier;
+  long& driverId = command->driverId;
+  
+  // Déterminer si l'argument est un ID numérique ou un nom de pilote
+  Napi::Value driver = arguments.Get(0u);
+  if (driver.IsNumber()) {
+    driverId = driver.As<Napi::Number>().Int32Value();
+    engineLog.log(LogLevel::Info, "Moteur {} : initialisation du pilote ASIO avec ID: {}", slot, driverId);
+  } else if (driver.IsString()) {
+    driverIdentifier = driver.As<Napi::String>().Utf8Value();
+    engineLog.log(LogLevel::Info, "Moteur {} : initialisation du pilote ASIO: {}", slot, driverIdentifier);
+  
+    // Vérifier si c'est un pilote simulé
+    command->simulated = driverIdentifier == kSimulationDriverName;
+  } else {
+    Napi::TypeError::New(env, "Argument 1 doit être un nombre (ID) ou une chaîne (nom)").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  // Options : { realtime: true | { priority (1 à 99), cpu, lockMemory, lockProcess },
+  //             outputReady (pilote virtuel : accepter l'optimisation ASIOOutputReady) }
+  if (arguments.Length() >= 2 && arguments.Get(1u).IsObject()) {
+    Napi::Object options = arguments.Get(1u).As<Napi::Object>();
+    if (options.Has("realtime") && !parseRealtimeOptions(env, options.Get("realtime"), &command->realtime)) {
+      return false;
+    }
+    if (options.Has("outputReady")) {
+      if (!options.Get("outputReady").IsBoolean()) {
+        Napi::TypeError::New(env, "L'option outputReady doit être un booléen").ThrowAsJavaScriptException();
+        return false;
+      }
+      command->outputReady = options.Get("outputReady").As<Napi::Boolean>().Value();
+    }
+  }
+  
+  return true;
+}
+
+void ASIOHandler::executeInitialize(ControlCommand* command) {
+  std::string& driverIdentifier = command->driverIdentifier;
+  
+  // Initialiser AsioDrivers si nécessaire (thread de contrôle uniquement, comme le sondage)
+  if (!asioDrivers) {
+    engineLog.log(LogLevel::Debug, "Initialisation de AsioDrivers...");
+    asioDrivers = new AsioDrivers();
+  }
+  
+  // Si c'est un pilote simulé ou si aucun pilote ASIO n'est disponible
+  const std::vector<std::string> driverNames = listDriverNames();
+  command->simulated = command->simulated || driverNames.empty();
+  if (!command->simulated && command->driverId >= 0 && command->driverId < static_cast<long>(driverNames.size())) {
+    // Charger par ID
+    driverIdentifier = driverNames[command->driverId];
+  }
+  
+  // Un seul pilote du registre par processus : celui d'un autre moteur n'est pas déchargé
+  // (les autres moteurs utilisent le pilote simulé) ; le précédent de ce moteur est
+  // déchargé par loadDriver
+  const ASIOHandler* owner = registryOwner.load();
+  if (!command->simulated && owner != nullptr && owner != this) {
+    command->error = "Le pilote ASIO " + currentDriverName + " est déjà utilisé par un autre moteur";
+    return;
+  }
+  if (owner == this) {
+    currentDriverName.clear();
+    releaseRegistryDriver();
+  }
+  
+  if (command->simulated) {
+    engineLog.log(LogLevel::Info, "Utilisation du pilote ASIO simulé");
+  
+    // Initialiser le pilote ASIO simulé
+    strcpy(driverInfo.name, "Simulation ASIO");
+    driverInfo.asioVersion = 2;
+  
+    // Obtenir les canaux d'entrée et de sortie
+    inputChannels = 2;
+    outputChannels = 2;
+  
+    // Obtenir les tailles de buffer disponibles
+    minSize = 256;
+    maxSize = 2048;
+    preferredSize = 1024;
+    granularity = 256;
+  
+    // Utiliser la taille de buffer préférée
+    bufferSize = preferredSize;
+  } else {
+    // Charger le pilote ASIO réel
+    if (!asioDrivers->loadDriver(const_cast<char*>(driverIdentifier.c_str()))) {
+      command->error = "Impossible de charger le pilote ASIO: " + driverIdentifier;
+      return;
+    }
+  
+    // Initialiser le pilote ASIO
+    if (ASIOInit(&driverInfo) != ASE_OK) {
+      command->error = "Erreur lors de l'initialisation du pilote ASIO";
+      return;
+    }
+    
+    // Le pilote chargé appartient au moteur, mais les fonctions ASIO de l'hôte s'adressent
+    // à son pilote virtuel : les capacités et le traitement qui suivent sont les siens
+    engineLog.log(LogLevel::Warning, "Moteur {} : pilote {} chargé, traitement par le pilote virtuel", slot, driverIdentifier);
+  }
+  
+  // Obtenir les informations sur les canaux
+  if (ASIOGetChannels(&inputChannels, &outputChannels) != ASE_OK) {
+    command->error = "Erreur lors de la récupération des informations sur les canaux";
+    return;
+  }
+  
+  // Obtenir les informations sur les buffers
+  if (ASIOGetBufferSize(&minSize, &maxSize, &preferredSize, &granularity) != ASE_OK) {
+    command->error = "Erreur lors de la récupération des informations sur les buffers";
+    return;
+  }
+  
+  // Utiliser la taille de buffer préférée
+  bufferSize = preferredSize;
+  
+  // Vérifier si le pilote du moteur accepte l'optimisation ASIOOutputReady (comme hostsample.cpp)
+  driver.setOutputReady(command->outputReady);
+  postOutput = (driver.outputReady() == ASE_OK);
+  
+  // Latences annoncées par le pilote (affinées après ASIOCreateBuffers dans Start)
+  if (ASIOGetLatencies(&inputLatency, &outputLatency) != ASE_OK) {
+    inputLatency = 0;
+    outputLatency = 0;
+  }
+  announcedOutputLatency = outputLatency;
+  latencySaved = 0;
+  
+  // Obtenir la fréquence d'échantillonnage (nécessaire à la balistique des mesures)
+  if (ASIOGetSampleRate(&sampleRate) != ASE_OK || sampleRate <= 0.0) {
+    sampleRate = 44100.0;
+  }
+  inputMeter.configure(sampleRate, static_cast<size_t>(bufferSize));
+  inputMeter.reset();
+  
+  // Choisir les noyaux DSP selon le processeur (SSE2/AVX2/AVX-512, repli scalaire)
+  selectDspKernels();
+  
+  // Format d'échantillon de chaque canal et convertisseur associé
+  if (!queryChannelFormats(&command->error)) {
+    return;
+  }
+  
+  // Conserver le routage précédent s'il reste valide pour ce pilote, sinon 1ère entrée -> 1ère sortie
+  std::vector<Route> routes = chain.routing().routes();
+  for (const Route& route : routes) {
+    if (route.input >= inputChannels || route.output >= outputChannels ||
+        !inputConverters[route.input] || !outputConverters[route.output]) {
+      routes.clear();
+      break;
+    }
+  }
+  if (routes.empty()) {
+    if (inputChannels < 1 || outputChannels < 1 || !inputConverters[0] || !outputConverters[0]) {
+      command->error = "Format d'échantillon non supporté sur le premier canal";
+      return;
+    }
+    routes.push_back(Route{0, 0, 1.0f});
+  }
+  applyRouting(routes);
+  
+  // Préparer la file d'échange avec les lecteurs (le thread de télémétrie partagée peut
+  // encore terminer une analyse commencée avant l'arrêt)
+  {
+    std::lock_guard<std::mutex> lock(analysisMutex);
+    inputRing.reset(static_cast<size_t>(std::max(bufferSize, maxSize)) * kInputRingBlocks);
+    analysisWindow.assign(static_cast<size_t>(std::max(bufferSize, maxSize)), 0.0f);
+    drainScratch.assign(static_cast<size_t>(bufferSize), 0.0f);
+    analysisWritePos = 0;
+    analysisBlockSize = static_cast<size_t>(bufferSize);
+  }
+  
+  // Réglages temps réel appliqués au démarrage, une fois les plans et buffers alloués
+  releaseMemoryLock();
+  realtimeOptions = command->realtime;
+  realtimeMemory = RealtimeMemoryReport();
+  realtimeThread = RealtimeThreadReport();
+  
+  if (!command->simulated) {
+    currentDriverName = driverIdentifier;
+    registryOwner.store(this);
+  }
+  publishConfig();
+}
+
+Napi::Value ASIOHandler::initializeResult(Napi::Env env, ControlCommand* command) {
+  // Créer un objet pour retourner les informations d'initialisation
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("success", Napi::Boolean::New(env, true));
+  result.Set("engine", Napi::Number::New(env, slot));
+  result.Set("driverName", Napi::String::New(env, command->driverIdentifier.c_str()));
+  result.Set("inputChannels", Napi::Number::New(env, inputChannels));
+  result.Set("outputChannels", Napi::Number::New(env, outputChannels));
+  result.Set("bufferSize", Napi::Number::New(env, bufferSize));
+  result.Set("sampleRate", Napi::Number::New(env, sampleRate));
+  result.Set("simd", Napi::String::New(env, dspKernels().name));
+  result.Set("inputFormats", formatsToArray(env, inputTypes));
+  result.Set("outputFormats", formatsToArray(env, outputTypes));
+  result.Set("routes", routesToArray(env));
+  result.Set("postOutput", Napi::Boolean::New(env, postOutput));
+  result.Set("inputLatency", Napi::Number::New(env, inputLatency));
+  result.Set("outputLatency", Napi::Number::New(env, outputLatency));
+  result.Set("realtime", realtimeToObject(env));
+  
+  return result;
+}
+
+bool ASIOHandler::prepareStart(Napi::Env env, Napi::Array arguments, ControlCommand* command) {
+  if (slot < 0) {
+    Napi::Error::New(env, "Ce moteur a été fermé").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  if (processing.load()) {
+    Napi::Error::New(env, "Le traitement audio est déjà en cours").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  if (bufferInfos.empty()) {
+    Napi::Error::New(env, "ASIO n'est pas initialisé").ThrowAsJavaScriptException();
+    return false;
+  }
+  
+  // Vérifier les arguments pour le gain (facteur d'inversion de phase)
+  float startGain = 1.0f; // Valeur par défaut
+  if (arguments.Length() >= 1 && arguments.Get(0u).IsNumber()) {
+    startGain = arguments.Get(0u).As<Napi::Number>().FloatValue();
+  }
+  
+  // Options : { routes, rampMs, ramp: 'linear' | 'exponential',
+  //             mode: 'inversion' | 'fxlms', errorChannel, taps, stepSize,
+  //             secondaryPath (réponse FIR) ou secondaryDelay + secondaryGain,
+  //             clock: 'realtime' | 'virtual', duration (secondes rejouées, horloge virtuelle) }
+  ChainSettings& settings = command->settings;
+  settings.gain = startGain;
+  settings.rampMs = kDefaultGainRampMs;
+  settings.routes = chain.routing().routes();
+  // Retard par défaut du chemin secondaire : latences d'entrée + de sortie du pilote
+  const long roundTrip = inputLatency + outputLatency;
+  settings.fxlms.secondaryDelay = static_cast<size_t>(roundTrip > 0 ? roundTrip : 2 * bufferSize);
+  // Pilote virtuel : horloge réelle par défaut
+  command->clock = DriverClock::RealTime;
+  command->clockBlocks = 0;
+  if (arguments.Length() >= 2 && arguments.Get(1u).IsObject()) {
+    Napi::Object options = arguments.Get(1u).As<Napi::Object>();
+    if (options.Has("routes")) {
+      if (!parseRoutes(env, options.Get("routes"), &settings.routes)) {
+        return false;
+      }
+    }
+    if (!parseChainOptions(env, options, &settings)) {
+      return false;
+    }
+    if (!parseClockOptions(env, options, &command->clock, &command->clockBlocks)) {
+      return false;
+    }
+    if (settings.mode == ProcessingMode::Fxlms) {
+      if (settings.routes.size() != 1) {
+        Napi::RangeError::New(env, "Le mode fxlms n'accepte qu'une route (référence -> haut-parleur)").ThrowAsJavaScriptException();
+        return false;
+      }
+      const long errorChannel = settings.errorChannel;
+      if (errorChannel >= inputChannels || errorChannel == settings.routes[0].input || !inputConverters[errorChannel]) {
+        Napi::RangeError::New(env, "Canal du micro d'erreur invalide: " + std::to_string(errorChannel)).ThrowAsJavaScriptException();
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void ASIOHandler::executeStart(ControlCommand* command) {
+  // Reconstruire les plans (le micro d'erreur est capturé sans être routé) ;
+  // le callback n'est pas encore actif : configuration sans concurrence
+  chain.configure(command->settings, sampleRate, static_cast<size_t>(bufferSize));
+  describeDriverBuffers();
+  
+  // Nouvel historique de blocs et notifications du pilote remises à zéro
+  blockClock.configure(sampleRate, bufferSize);
+  blockClock.reset();
+  callbackStats.configure(sampleRate, static_cast<size_t>(bufferSize));
+  callbackStats.reset();
+  sampleRateChanged.store(false);
+  resetRequested.store(false);
+  latenciesChanged.store(false);
+  
+#ifdef ASIO_INCLUDED
+  // Créer les buffers ASIO avec les callbacks de l'emplacement du moteur (le pilote peut
+  // conserver le pointeur jusqu'à ASIODisposeBuffers)
+  if (ASIOCreateBuffers(bufferInfos.data(), static_cast<long>(bufferInfos.size()), bufferSize, &callbacks) != ASE_OK) {
+    command->error = "Erreur lors de la création des buffers ASIO";
+    return;
+  }
+  
+  // Chaque buffer du pilote est associé au convertisseur de son format et à son plan float
+  if (!bindDriverBuffers(&command->error)) {
+    ASIODisposeBuffers();
+    inputBindings.clear();
+    outputBindings.clear();
+    return;
+  }
+  
+  // Les latences définitives ne sont connues qu'une fois les buffers créés
+  // (et tiennent compte de l'optimisation ASIOOutputReady)
+  ASIOGetLatencies(&inputLatency, &outputLatency);
+  
+  // Gain de l'optimisation mesuré : la taille de buffer est celle de l'initialisation,
+  // l'écart de latence de sortie annoncée ne vient que de ASIOOutputReady
+  latencySaved = postOutput ? std::max(0L, announcedOutputLatency - outputLatency) : 0;
+  
+  // Plans, spectres et buffers définitifs : verrouiller leurs pages les charge toutes,
+  // plus de défaut de page ni d'échange pendant le traitement
+  if (realtimeOptions.enabled && realtimeOptions.lockMemory) {
+    lockMemory();
+    if (!realtimeMemory.locked) {
+      engineLog.log(LogLevel::Warning, "Moteur {} : mémoire non verrouillée: {}", slot, realtimeMemory.error);
+    }
+  }
+  
+  // Thread de traitement : priorité, affinité et pile réglées avant le premier bloc
+  realtimeThread = RealtimeThreadReport();
+  if (realtimeOptions.enabled) {
+    driver.setThreadSetup([this] { realtimeThread = applyRealtimeThread(realtimeOptions); });
+  } else {
+    driver.setThreadSetup(nullptr);
+  }
+  
+  // Démarrer le traitement audio (horloge virtuelle : blocs enchaînés, temps synthétisé)
+  driver.setClock(command->clock, command->clockBlocks);
+  if (ASIOStart() != ASE_OK) {
+    // Rien n'a démarré : défaire les buffers et le verrouillage, comme executeStop
+    command->error = "Erreur lors du démarrage du traitement audio";
+    driver.setThreadSetup(nullptr);
+    ASIODisposeBuffers();
+    inputBindings.clear();
+    outputBindings.clear();
+    releaseMemoryLock();
+    return;
+  }
+  if (!realtimeThread.priorityError.empty()) {
+    engineLog.log(LogLevel::Warning, "Moteur {} : priorité temps réel non appliquée: {}", slot, realtimeThread.priorityError);
+  }
+#endif
+  
+  // Indiquer que le traitement est en cours
+  publishConfig();
+  inputMeter.reset();
+  analysisDropLogged = false;
+  processing.store(true);
+}
+
+Napi::Value ASIOHandler::startResult(Napi::Env env, ControlCommand* command) {
+  // Créer un objet pour retourner les informations de démarrage
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("success", Napi::Boolean::New(env, true));
+  result.Set("gain", Napi::Number::New(env, -chain.outputGain().target()));
+  result.Set("routes", routesToArray(env));
+  result.Set("mode", Napi::String::New(env, chain.mode() == ProcessingMode::Fxlms ? "fxlms" : "inversion"));
+  if (chain.mode() == ProcessingMode::Fxlms) {
+    result.Set("taps", Napi::Number::New(env, static_cast<double>(chain.canceller().taps())));
+    result.Set("partitions", Napi::Number::New(env, static_cast<double>(chain.canceller().partitionCount())));
+  }
+#ifdef ASIO_INCLUDED
+  result.Set("postOutput", Napi::Boolean::New(env, postOutput));
+  result.Set("inputLatency", Napi::Number::New(env, inputLatency));
+  result.Set("outputLatency", Napi::Number::New(env, outputLatency));
+  result.Set("latencySaved", Napi::Number::New(env, latencySaved));
+  result.Set("latencySavedMs", Napi::Number::New(env, 1000.0 * latencySaved / sampleRate));
+  result.Set("clock", Napi::String::New(env, command->clock == DriverClock::Virtual ? "virtual" : "realtime"));
+  result.Set("realtime", realtimeToObject(env));
+#else
+  // Version simulée pour le développement sans SDK ASIO
+  result.Set("simulated", Napi::Boolean::New(env, true));
+#endif
+  
+  return result;
+}
+
+void ASIOHandler::executeStop(ControlCommand* command) {
+#ifdef ASIO_INCLUDED
+  // Arrêter le traitement audio
+  if (ASIOStop() != ASE_OK) {
+    command->error = "Erreur lors de l'arrêt du traitement audio";
+    return;
+  }
+  
+  // Libérer les buffers ASIO
+  if (ASIODisposeBuffers() != ASE_OK) {
+    command->error = "Erreur lors de la libération des buffers ASIO";
+    return;
+  }
+  inputBindings.clear();
+  outputBindings.clear();
+  releaseMemoryLock();
+#endif
+  
+  // Indiquer que le traitement est arrêté
+  processing.store(false);
+}
+
+Napi::Value ASIOHandler::stopResult(Napi::Env env) {
+  // Créer un objet pour retourner les informations d'arrêt
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("success", Napi::Boolean::New(env, true));
+  
+  return result;
+}
+
+void ASIOHandler::executeClose(ControlCommand* command) {
+  if (processing.load()) {
+    executeStop(command);
+    if (!command->error.empty()) {
+      return;
+    }
+  }
+  
+  // Pilote du registre déchargé sur le thread de contrôle : disponible pour un autre moteur
+  if (registryOwner.load() == this) {
+    ASIOExit();
+    asioDrivers->removeCurrentDriver();
+    currentDriverName.clear();
+    releaseRegistryDriver();
+  }
+  bufferInfos.clear();
+  releaseMemoryLock();
+}
+
+Napi::Value ASIOHandler::closeResult(Napi::Env env) {
+  // Les threads de télémétrie lisent l'état du moteur : arrêtés avant de rendre l'emplacement
+  stopTelemetryThread();
+  stopSharedTelemetryThread();
+  releaseSlot();
+  return stopResult(env);
+}
+
+Napi::Value ASIOHandler::GetInputLevel(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  if (!processing.load()) {
+    return Napi::Number::New(env, 0.0f);
+  }
+  
+  // Dernier instantané publié par le callback : quelques lectures, sans verrou
+  return Napi::Number::New(env, displayLevel(inputMeter.snapshot().rms));
+}
+
+float ASIOHandler::displayLevel(float rms) {
+  // Normaliser entre 0 et 1, puis convertir en pourcentage
+  // La plupart des signaux audio sont normalisés entre -1 et 1
+  // donc RMS est généralement entre 0 et 0.707 (sin wave RMS)
+  float normalizedRMS = std::min(rms * 1.414f, 1.0f);
+  
+  return normalizedRMS * 100.0f; // Pourcentage
+}
+
+// Argument : nombre de bandes (32 par défaut) ou Float32Array rempli sur place (une bande par élément)
+// Résultat : Float32Array, sans objet JavaScript par bande
+Napi::Value ASIOHandler::GetFFTData(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  Napi::Float32Array fftData;
+  if (info.Length() >= 1 && isFloat32Array(info[0])) {
+    fftData = info[0].As<Napi::Float32Array>();
+    if (fftData.ElementLength() < 1 || fftData.ElementLength() > kMaxSpectrumBands) {
+      Napi::RangeError::New(env, "Le tableau doit contenir entre 1 et " + std::to_string(kMaxSpectrumBands) + " bandes").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  } else {
+    // Nombre de bandes de fréquence pour l'analyse FFT (32 par défaut)
+    uint32_t numBands = 32;
+    if (info.Length() >= 1 && info[0].IsNumber()) {
+      numBands = std::max(1u, std::min(info[0].As<Napi::Number>().Uint32Value(), kMaxSpectrumBands));
+    }
+    fftData = Napi::Float32Array::New(env, numBands);
+  }
+  
+  const uint32_t numBands = static_cast<uint32_t>(fftData.ElementLength());
+  if (processing.load()) {
+    computeDisplaySpectrum(numBands, fftData.Data());
+  } else {
+    // Si le traitement est arrêté, renvoyer des zéros
+    std::fill(fftData.Data(), fftData.Data() + numBands, 0.0f);
+  }
+  
+  return fftData;
+}
+
+void ASIOHandler::computeDisplaySpectrum(uint32_t numBands, float* display) {
+  // Appelé par le thread Node et par le thread de télémétrie partagée
+  std::lock_guard<std::mutex> lock(analysisMutex);
+  
+  // Une FFT réelle de la taille du buffer ASIO (radix mixte : 96, 192, 480... sont acceptés)
+  // puis un parcours de la table bins -> bandes précalculée
+  spectrumAnalyzer.configure(std::max<size_t>(1, analysisBlockSize), numBands);
+  
+  // Récupérer le dernier bloc publié par le callback, sans bloquer celui-ci
+  drainInputRing();
+  const size_t fftSize = spectrumAnalyzer.fftSize();
+  if (spectrumInput.size() < fftSize) {
+    spectrumInput.resize(fftSize);
+  }
+  if (bandEnergies.size() < numBands) {
+    bandEnergies.resize(numBands);
+  }
+  copyLatestInput(spectrumInput.data(), fftSize);
+  spectrumAnalyzer.analyze(spectrumInput.data(), bandEnergies.data());
+  
+  // Normaliser les valeurs pour l'affichage
+  float maxEnergy = 0.0f;
+  for (uint32_t i = 0; i < numBands; i++) {
+    maxEnergy = std::max(maxEnergy, bandEnergies[i]);
+  }
+  
+  // Éviter la division par zéro : si aucune énergie n'est détectée, des zéros
+  for (uint32_t i = 0; i < numBands; i++) {
+    // Convertir en pourcentage et appliquer une échelle logarithmique simplifiée
+    // (échelle non linéaire pour meilleure visualisation)
+    display[i] = maxEnergy > 0.0f ? std::sqrt(bandEnergies[i] / maxEnergy) * 100.0f : 0.0f;
+  }
+}
+
+// Niveaux détaillés : RMS, crête et crête maintenue (valeurs linéaires, 1.0 = pleine échelle)
+// Avec un Float32Array d'au moins 3 éléments : [rms, peak, peakHold] écrits sur place
+Napi::Value ASIOHandler::GetLevels(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  const LevelSnapshot levels = inputMeter.snapshot();
+  
+  if (info.Length() >= 1 && isFloat32Array(info[0])) {
+    Napi::Float32Array values = info[0].As<Napi::Float32Array>();
+    if (values.ElementLength() < 3) {
+      Napi::RangeError::New(env, "Le tableau des niveaux doit contenir au moins 3 éléments").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    float* data = values.Data();
+    data[0] = levels.rms;
+    data[1] = levels.peak;
+    data[2] = levels.peakHold;
+    return values;
+  }
+  
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("rms", Napi::Number::New(env, levels.rms));
+  result.Set("peak", Napi::Number::New(env, levels.peak));
+  result.Set("peakHold", Napi::Number::New(env, levels.peakHold));
+  result.Set("blocks", Napi::Number::New(env, levels.blocks));
+  
+  return result;
+}
+
+// Forme d'onde : derniers échantillons de la première entrée routée
+// Argument : nombre d'échantillons (taille du buffer par défaut) ou Float32Array rempli sur place ;
+// au-delà de la fenêtre d'analyse, les éléments restants sont mis à zéro
+Napi::Value ASIOHandler::GetWaveform(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  Napi::Float32Array waveform;
+  if (info.Length() >= 1 && isFloat32Array(info[0])) {
+    waveform = info[0].As<Napi::Float32Array>();
+  } else {
+    size_t count = static_cast<size_t>(std::max(1L, engineConfig().bufferSize));
+    if (info.Length() >= 1 && info[0].IsNumber()) {
+      count = static_cast<size_t>(std::max<int64_t>(1, info[0].As<Napi::Number>().Int64Value()));
+    }
+    // La fenêtre est réallouée par le thread de contrôle à l'initialisation
+    size_t window = 0;
+    {
+      std::lock_guard<std::mutex> lock(analysisMutex);
+      window = analysisWindow.size();
+    }
+    waveform = Napi::Float32Array::New(env, std::min(count, std::max<size_t>(1, window)));
+  }
+  
+  float* samples = waveform.Data();
+  const size_t length = waveform.ElementLength();
+  size_t available = 0;
+  if (processing.load()) {
+    std::lock_guard<std::mutex> lock(analysisMutex);
+    available = std::min(length, analysisWindow.size());
+    drainInputRing();
+    copyLatestInput(samples, available);
+  }
+  std::fill(samples + available, samples + length, 0.0f);
+  
+  return waveform;
+}
+
+bool ASIOHandler::isFloat32Array(Napi::Value value) {
+  return value.IsTypedArray() && value.As<Napi::TypedArray>().TypedArrayType() == napi_float32_array;
+}
+
+// Horloge des blocs : blocs perdus, gigue des callbacks, fréquence mesurée et derniers horodatages
+Napi::Value ASIOHandler::GetTimeInfo(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  size_t maxEntries = 32;
+  if (info.Length() >= 1 && info[0].IsNumber()) {
+    const int64_t requested = info[0].As<Napi::Number>().Int64Value();
+    maxEntries = static_cast<size_t>(std::max<int64_t>(0, std::min<int64_t>(requested, BlockClock::kHistory)));
+  }
+  
+  const BlockClockStats stats = blockClock.stats();
+  std::vector<BlockTimeEntry> entries(maxEntries);
+  entries.resize(blockClock.history(entries.data(), entries.size()));
+  
+  Napi::Array history = Napi::Array::New(env, entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    const BlockTimeEntry& entry = entries[i];
+    Napi::Object item = Napi::Object::New(env);
+    item.Set("block", Napi::Number::New(env, static_cast<double>(entry.block)));
+    item.Set("index", Napi::Number::New(env, entry.index));
+    item.Set("samplePosition", (entry.flags & kBlockPositionValid) ? Napi::Number::New(env, entry.samplePosition) : env.Null());
+    item.Set("systemTime", (entry.flags & kBlockTimeValid) ? Napi::Number::New(env, entry.systemTime) : env.Null());
+    item.Set("estimated", Napi::Boolean::New(env, (entry.flags & kBlockEstimated) != 0));
+    history.Set(static_cast<uint32_t>(i), item);
+  }
+  
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("blocks", Napi::Number::New(env, static_cast<double>(stats.blocks)));
+  result.Set("droppedBlocks", Napi::Number::New(env, static_cast<double>(stats.droppedBlocks)));
+  result.Set("sampleRate", Napi::Number::New(env, engineConfig().sampleRate));
+  result.Set("measuredSampleRate", Napi::Number::New(env, stats.measuredSampleRate));
+  result.Set("nominalPeriodMs", Napi::Number::New(env, stats.nominalPeriodNs / 1e6));
+  result.Set("meanIntervalMs", Napi::Number::New(env, stats.meanIntervalNs / 1e6));
+  result.Set("jitterMeanMs", Napi::Number::New(env, stats.jitterMeanNs / 1e6));
+  result.Set("jitterMaxMs", Napi::Number::New(env, stats.jitterMaxNs / 1e6));
+  result.Set("sampleRateChanged", Napi::Boolean::New(env, sampleRateChanged.load(std::memory_order_acquire)));
+  result.Set("pendingSampleRate", Napi::Number::New(env, pendingSampleRate.load(std::memory_order_relaxed)));
+  result.Set("resetRequested", Napi::Boolean::New(env, resetRequested.load(std::memory_order_acquire)));
+  result.Set("latenciesChanged", Napi::Boolean::New(env, latenciesChanged.load(std::memory_order_acquire)));
+  result.Set("history", history);
+  
+  return result;
+}
+
+// Histogramme JSON : cases non vides { lowerUs, count }
+static Napi::Array histogramToArray(Napi::Env env, const LatencyHistogram& histogram) {
+  Napi::Array buckets = Napi::Array::New(env);
+  uint32_t count = 0;
+  for (size_t i = 0; i < LatencyHistogram::kBuckets; i++) {
+    const uint64_t value = histogram.count(i);
+    if (value == 0) {
+      continue;
+    }
+    Napi::Object bucket = Napi::Object::New(env);
+    bucket.Set("lowerUs", Napi::Number::New(env, static_cast<double>(LatencyHistogram::bucketLower(i))));
+    bucket.Set("count", Napi::Number::New(env, static_cast<double>(value)));
+    buckets.Set(count++, bucket);
+  }
+  return buckets;
+}
+
+// Statistiques temps réel du callback : temps de traitement, intervalles, charge DSP, dépassements
+Napi::Value ASIOHandler::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  const EngineConfig config = engineConfig();
+  const CallbackStatsSnapshot stats = callbackStats.snapshot();
+  const LatencyHistogram& processingHistogram = callbackStats.processingHistogram();
+  const LatencyHistogram& intervalHistogram = callbackStats.intervalHistogram();
+  
+  Napi::Object processingTime = Napi::Object::New(env);
+  processingTime.Set("lastUs", Napi::Number::New(env, stats.lastProcessingUs));
+  processingTime.Set("meanUs", Napi::Number::New(env, stats.meanProcessingUs));
+  processingTime.Set("maxUs", Napi::Number::New(env, stats.maxProcessingUs));
+  processingTime.Set("p50Us", Napi::Number::New(env, processingHistogram.quantile(0.5)));
+  processingTime.Set("p99Us", Napi::Number::New(env, processingHistogram.quantile(0.99)));
+  processingTime.Set("histogram", histogramToArray(env, processingHistogram));
+  
+  Napi::Object interval = Napi::Object::New(env);
+  interval.Set("meanUs", Napi::Number::New(env, stats.meanIntervalUs));
+  interval.Set("maxUs", Napi::Number::New(env, stats.maxIntervalUs));
+  interval.Set("p50Us", Napi::Number::New(env, intervalHistogram.quantile(0.5)));
+  interval.Set("p99Us", Napi::Number::New(env, intervalHistogram.quantile(0.99)));
+  interval.Set("histogram", histogramToArray(env, intervalHistogram));
+  
+  Napi::Object dspLoad = Napi::Object::New(env);
+  dspLoad.Set("current", Napi::Number::New(env, stats.dspLoad));
+  dspLoad.Set("mean", Napi::Number::New(env, stats.meanDspLoad));
+  dspLoad.Set("peak", Napi::Number::New(env, stats.peakDspLoad));
+  
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("processing", Napi::Boolean::New(env, processing.load()));
+  result.Set("clock", Napi::String::New(env, config.clock == DriverClock::Virtual ? "virtual" : "realtime"));
+  result.Set("clockFinished", Napi::Boolean::New(env, driver.finished()));
+  result.Set("callbacks", Napi::Number::New(env, static_cast<double>(stats.callbacks)));
+  result.Set("overruns", Napi::Number::New(env, static_cast<double>(stats.overruns)));
+  result.Set("lateCallbacks", Napi::Number::New(env, static_cast<double>(stats.lateCallbacks)));
+  result.Set("logDropped", Napi::Number::New(env, static_cast<double>(engineLog.droppedCount())));
+  result.Set("bufferSize", Napi::Number::New(env, config.bufferSize));
+  result.Set("sampleRate", Napi::Number::New(env, config.sampleRate));
+  result.Set("bufferPeriodMs", Napi::Number::New(env, stats.periodUs / 1000.0));
+  result.Set("latencyMs", Napi::Number::New(env, config.sampleRate > 0.0 ?
+    1000.0 * (config.inputLatency + config.outputLatency) / config.sampleRate : 0.0));
+  result.Set("dspLoad", dspLoad);
+  result.Set("processingTime", processingTime);
+  result.Set("callbackInterval", interval);
+  
+  return result;
+}
+
+bool ASIOHandler::parseOfflineOptions(Napi::Env env, Napi::Object options, OfflineJob* job) {
+  if (options.Has("routes") && !parseRouteList(env, options.Get("routes"), &job->settings.routes)) {
+    return false;
+  }
+  if (options.Get("gain").IsNumber()) {
+    job->settings.gain = options.Get("gain").As<Napi::Number>().FloatValue();
+  }
+  if (options.Get("blockSize").IsNumber()) {
+    job->blockSize = static_cast<size_t>(std::max<int64_t>(0, options.Get("blockSize").As<Napi::Number>().Int64Value()));
+  }
+  if (options.Get("outputChannels").IsNumber()) {
+    job->outputChannels = static_cast<long>(options.Get("outputChannels").As<Napi::Number>().Int64Value());
+  }
+  if (options.Get("outputFormat").IsString()) {
+    const std::string name = options.Get("outputFormat").As<Napi::String>().Utf8Value();
+    if (name == "same") {
+      job->keepFormat = true;
+    } else if (offlineFormatFromName(name, &job->outputFormat)) {
+      job->keepFormat = false;
+    } else {
+      Napi::TypeError::New(env, "Format de sortie inconnu: " + name).ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  return parseChainOptions(env, options, &job->settings);
+}
+
+// Traitement hors ligne dans un thread de travail : le thread Node reste libre,
+// la promesse est résolue avec un résultat par fichier
+class OfflineWorker : public Napi::AsyncWorker {
+public:
+  OfflineWorker(Napi::Env env, std::vector<OfflineJob> jobs, unsigned threads)
+    : Napi::AsyncWorker(env), deferred(Napi::Promise::Deferred::New(env)),
+      jobs(std::move(jobs)), threads(threads) {}
+  
+  Napi::Promise promise() { return deferred.Promise(); }
+  
+  void Execute() override {
+    results = processFiles(jobs, threads);
+  }
+  
+  void OnOK() override {
+    Napi::Env env = Env();
+    Napi::Array array = Napi::Array::New(env, results.size());
+    for (size_t i = 0; i < results.size(); i++) {
+      const OfflineResult& result = results[i];
+      Napi::Object item = Napi::Object::New(env);
+      item.Set("input", Napi::String::New(env, jobs[i].input));
+      item.Set("output", Napi::String::New(env, jobs[i].output));
+      item.Set("success", Napi::Boolean::New(env, result.success));
+      if (!result.success) {
+        item.Set("error", Napi::String::New(env, result.error));
+      }
+      item.Set("frames", Napi::Number::New(env, static_cast<double>(result.frames)));
+      item.Set("inputChannels", Napi::Number::New(env, result.inputChannels));
+      item.Set("outputChannels", Napi::Number::New(env, result.outputChannels));
+      item.Set("sampleRate", Napi::Number::New(env, result.sampleRate));
+      item.Set("seconds", Napi::Number::New(env, result.seconds));
+      item.Set("realtimeFactor", Napi::Number::New(env, result.realtimeFactor));
+      array.Set(static_cast<uint32_t>(i), item);
+    }
+    deferred.Resolve(array);
+  }
+  
+  void OnError(const Napi::Error& error) override {
+    deferred.Reject(error.Value());
+  }
+  
+private:
+  Napi::Promise::Deferred deferred;
+  std::vector<OfflineJob> jobs;
+  unsigned threads;
+  std::vector<OfflineResult> results;
+};
+
+// Traitement hors ligne de fichiers WAV par la chaîne du callback, aussi vite que possible
+// processFiles([{ input, output, ...options }], { threads, blockSize, outputFormat,
+//               outputChannels, routes, gain, rampMs, ramp, mode, errorChannel, ... })
+Napi::Value ASIOHandler::ProcessFiles(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "Argument 1 doit être un tableau de { input, output }").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  Napi::Object defaults = info.Length() >= 2 && info[1].IsObject() ? info[1].As<Napi::Object>() : Napi::Object::New(env);
+  
+  unsigned threads = 1;
+  if (defaults.Get("threads").IsNumber()) {
+    threads = static_cast<unsigned>(std::max<int64_t>(0, std::min<int64_t>(defaults.Get("threads").As<Napi::Number>().Int64Value(), 256)));
+  }
+  
+  Napi::Array array = info[0].As<Napi::Array>();
+  std::vector<OfflineJob> jobs;
+  jobs.reserve(array.Length());
+  for (uint32_t i = 0; i < array.Length(); i++) {
+    Napi::Value item = array.Get(i);
+    if (!item.IsObject() || !item.As<Napi::Object>().Get("input").IsString() ||
+        !item.As<Napi::Object>().Get("output").IsString()) {
+      Napi::TypeError::New(env, "Fichier " + std::to_string(i) + " : input et output doivent être des chemins").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    Napi::Object object = item.As<Napi::Object>();
+    OfflineJob job;
+    job.input = object.Get("input").As<Napi::String>().Utf8Value();
+    job.output = object.Get("output").As<Napi::String>().Utf8Value();
+    job.settings.rampMs = kDefaultGainRampMs;
+    if (!parseOfflineOptions(env, defaults, &job) || !parseOfflineOptions(env, object, &job)) {
+      return env.Null();
+    }
+    jobs.push_back(std::move(job));
+  }
+  
+  // Mêmes noyaux SIMD que le traitement temps réel, même sans pilote initialisé
+  selectDspKernels();
+  
+  OfflineWorker* worker = new OfflineWorker(env, std::move(jobs), threads);
+  Napi::Promise promise = worker->promise();
+  worker->Queue();
+  return promise;
+}
+
+// *** Implémentation de GetDevices ***
+#ifdef ASIO_INCLUDED
+// Liste servie depuis le cache : aucun accès au registre ni au pilote sur le thread Node.
+// Le cache est rempli par un sondage sur le thread de contrôle, lancé au chargement du
+// module, puis de nouveau après une demande de réinitialisation du pilote ou refreshDevices()
+Napi::Value ASIOHandler::getDevices(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  // Réinitialisation signalée par le pilote : nouveau sondage en arrière-plan,
+  // la liste actuelle est renvoyée en attendant
+  if (devicesStale.exchange(false, std::memory_order_acq_rel)) {
+    queueDeviceProbe(env);
+  }
+  return devicesToArray(env);
+}
+
+// Nouveau sondage (changement de périphériques signalé par le système) : promesse de la liste
+Napi::Value ASIOHandler::RefreshDevices(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  devicesStale.store(false, std::memory_order_release);
+  return enqueueControl(env, ControlOp::Probe, Napi::Array::New(env), true, nullptr);
+}
+
+void ASIOHandler::queueDeviceProbe(Napi::Env env) {
+  if (!deviceProbeQueued) {
+    deviceProbeQueued = true;
+    enqueueControl(env, ControlOp::Probe, Napi::Array::New(env), false, nullptr);
+  }
+}
+#else
+// Fournir une implémentation vide ou simulée si ASIO n'est pas inclus
+Napi::Value ASIOHandler::getDevices(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Array deviceList = Napi::Array::New(env, 2); // Simuler deux périphériques
+
+    Napi::Object device1 = Napi::Object::New(env);
+    device1.Set("id", Napi::Number::New(env, 0));
+    device1.Set("name", Napi::String::New(env, "Simulated ASIO Input"));
+    deviceList[uint32_t(0)] = device1;
+
+    Napi::Object device2 = Napi::Object::New(env);
+    device2.Set("id", Napi::Number::New(env, 1));
+    device2.Set("name", Napi::String::New(env, "Simulated ASIO Output"));
+    deviceList[uint32_t(1)] = device2;
+    
+    return deviceList;
+}
+
+// Sans SDK ASIO : pas de pilote à sonder, la liste simulée est renvoyée telle quelle
+Napi::Value ASIOHandler::RefreshDevices(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  deferred.Resolve(getDevices(info));
+  return deferred.Promise();
+}
+#endif
+
+// Périphériques simulés, toujours présents pour garantir le fonctionnement de l'application ;
+// seul le premier (pilote virtuel) est sondé
+std::vector<ASIOHandler::DeviceInfo> ASIOHandler::simulatedDevices() {
+  struct { const char* name; long inputs; long outputs; long preferredSize; } const entries[] = {
+    {kSimulationDriverName, 2, 2, 1024},
+    {"Focusrite Saffire Pro 24", 16, 8, 512},
+    {"Steinberg UR22", 2, 2, 256},
+    {"RME Fireface UCX", 18, 18, 128},
+  };
+  std::vector<DeviceInfo> devices;
+  for (const auto& entry : entries) {
+    DeviceInfo device;
+    device.name = entry.name;
+    device.isSimulated = true;
+    device.inputChannels = entry.inputs;
+    device.outputChannels = entry.outputs;
+    device.preferredSize = entry.preferredSize;
+    devices.push_back(device);
+  }
+  return devices;
+}
+
+std::vector<std::string> ASIOHandler::listDriverNames() {
+  // getDriverNames copie chaque nom dans un buffer fourni par l'appelant
+  char buffers[kMaxDrivers][kDriverNameLength] = {};
+  char* names[kMaxDrivers];
+  for (long i = 0; i < kMaxDrivers; i++) {
+    names[i] = buffers[i];
+  }
+  const long count = asioDrivers ? asioDrivers->getDriverNames(names, kMaxDrivers) : 0;
+  return std::vector<std::string>(names, names + std::max(0L, count));
+}
+
+void ASIOHandler::executeProbe(ControlCommand* command) {
+  // Un pilote initialisé ne peut pas être rechargé sans perdre ses buffers : les pilotes
+  // du registre gardent alors le résultat du sondage précédent. Sinon, le registre est
+  // relu (pilotes installés ou retirés) et chaque pilote est chargé puis déchargé.
+  const bool driverInUse = registryOwner.load() != nullptr;
+  if (!driverInUse) {
+    delete asioDrivers;
+    asioDrivers = new AsioDrivers();
+  }
+  
+  const std::vector<DeviceInfo> previous = std::move(command->devices);
+  std::vector<DeviceInfo> devices = simulatedDevices();
+  const std::vector<std::string> names = listDriverNames();
+  for (size_t i = 0; i < names.size(); i++) {
+    DeviceInfo device;
+    device.name = names[i];
+    device.driverIndex = static_cast<long>(i);
+    devices.push_back(device);
+  }
+  
+  for (DeviceInfo& device : devices) {
+    const bool driver = device.driverIndex >= 0 || device.name == kSimulationDriverName;
+    if (!driver) {
+      continue;
+    }
+    if (driverInUse && device.driverIndex >= 0) {
+      for (const DeviceInfo& known : previous) {
+        if (known.name == device.name && known.driverIndex == device.driverIndex) {
+          device = known;
+          break;
+        }
+      }
+    } else {
+      probeDriver(&device);
+    }
+  }
+  command->devices = std::move(devices);
+}
+
+void ASIOHandler::probeDriver(DeviceInfo* device) {
+  // Pilote simulé : le pilote virtuel n'a pas besoin d'être chargé
+  if (device->driverIndex < 0) {
+    queryCapabilities(device);
+    return;
+  }
+  
+  // Pilote du registre : seul son chargement est vérifié. Les fonctions ASIO de l'hôte
+  // s'adressent au pilote virtuel, l'interroger rapporterait les capacités de celui-ci :
+  // l'entrée reste non sondée, sans capacités.
+  if (!asioDrivers->loadDriver(const_cast<char*>(device->name.c_str()))) {
+    device->error = "Impossible de charger le pilote ASIO";
+    return;
+  }
+  asioDrivers->removeCurrentDriver();
+  device->error.clear();
+}
+
+void ASIOHandler::queryCapabilities(DeviceInfo* device) {
+  if (ASIOGetChannels(&device->inputChannels, &device->outputChannels) != ASE_OK ||
+      ASIOGetBufferSize(&device->minSize, &device->maxSize, &device->preferredSize, &device->granularity) != ASE_OK) {
+    device->error = "Erreur lors de la récupération des capacités du pilote";
+    return;
+  }
+  if (ASIOGetSampleRate(&device->sampleRate) != ASE_OK) {
+    device->sampleRate = 0.0;
+  }
+  device->sampleRates.clear();
+  for (double rate : kStandardSampleRates) {
+    if (ASIOCanSampleRate(rate) == ASE_OK) {
+      device->sampleRates.push_back(rate);
+    }
+  }
+  if (ASIOGetLatencies(&device->inputLatency, &device->outputLatency) != ASE_OK) {
+    device->inputLatency = 0;
+    device->outputLatency = 0;
+  }
+  device->error.clear();
+  device->probed = true;
+}
+
+Napi::Value ASIOHandler::probeResult(Napi::Env env, ControlCommand* command) {
+  deviceCache.swap(command->devices);
+  deviceProbeQueued = false;
+  return devicesToArray(env);
+}
+
+Napi::Array ASIOHandler::devicesToArray(Napi::Env env) {
+  Napi::Array devices = Napi::Array::New(env, deviceCache.size());
+  for (size_t i = 0; i < deviceCache.size(); i++) {
+    const DeviceInfo& device = deviceCache[i];
+    Napi::Object item = Napi::Object::New(env);
+    item.Set("name", Napi::String::New(env, device.name));
+    item.Set("id", Napi::Number::New(env, static_cast<double>(i)));
+    item.Set("isSimulated", Napi::Boolean::New(env, device.isSimulated));
+    if (device.driverIndex >= 0) {
+      // Index accepté par initialize(id)
+      item.Set("driverIndex", Napi::Number::New(env, device.driverIndex));
+    }
+    item.Set("probed", Napi::Boolean::New(env, device.probed));
+    if (device.probed) {
+      item.Set("numInputChannels", Napi::Number::New(env, device.inputChannels));
+      item.Set("numOutputChannels", Napi::Number::New(env, device.outputChannels));
+      item.Set("preferredBufferSize", Napi::Number::New(env, device.preferredSize));
+      Napi::Array sampleRates = Napi::Array::New(env, device.sampleRates.size());
+      for (size_t r = 0; r < device.sampleRates.size(); r++) {
+        sampleRates.Set(static_cast<uint32_t>(r), Napi::Number::New(env, device.sampleRates[r]));
+      }
+      item.Set("minBufferSize", Napi::Number::New(env, device.minSize));
+      item.Set("maxBufferSize", Napi::Number::New(env, device.maxSize));
+      item.Set("bufferGranularity", Napi::Number::New(env, device.granularity));
+      item.Set("sampleRate", Napi::Number::New(env, device.sampleRate));
+      item.Set("sampleRates", sampleRates);
+      item.Set("inputLatency", Napi::Number::New(env, device.inputLatency));
+      item.Set("outputLatency", Napi::Number::New(env, device.outputLatency));
+    }
+    if (!device.error.empty()) {
+      item.Set("error", Napi::String::New(env, device.error));
+    }
+    devices.Set(static_cast<uint32_t>(i), item);
+  }
+  return devices;
 }
-#endif
 
 // Implémentation de SetInversionGain
 Napi::Value ASIOHandler::SetInversionGain(const Napi::CallbackInfo& info) {
@@ -601,31 +2438,342 @@ Napi::Value ASIOHandler::SetInversionGain(const Napi::CallbackInfo& info) {
   // Limiter le gain à une plage raisonnable (0 à 2)
   newGain = std::max(0.0f, std::min(newGain, 2.0f));
   
-  // Mettre à jour le gain avec verrou pour éviter les problèmes de concurrence
-  {
-    std::lock_guard<std::mutex> lock(bufferMutex);
-    gain = newGain;
-  }
+  // Mise à jour atomique de la cible : le callback la lit une fois par bloc et
+  // rejoint la nouvelle valeur par une rampe, sans verrou ni clic
+  chain.outputGain().setTarget(-newGain);
   
   // Créer un objet pour retourner le résultat
   Napi::Object result = Napi::Object::New(env);
   result.Set("success", Napi::Boolean::New(env, true));
-  result.Set("gain", Napi::Number::New(env, gain));
+  result.Set("gain", Napi::Number::New(env, -chain.outputGain().target()));
+  
+  return result;
+}
+
+Napi::Value ASIOHandler::SetRouting(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  // Les plans et les buffers ASIO sont réalloués : impossible pendant le traitement
+  // ni pendant une commande de contrôle
+  if (controlPending(env)) {
+    return env.Null();
+  }
+  if (processing.load()) {
+    Napi::Error::New(env, "Le routage ne peut être modifié que lorsque le traitement est arrêté").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  
+  if (bufferInfos.empty()) {
+    Napi::Error::New(env, "ASIO n'est pas initialisé").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Argument 1 doit être un tableau de routes").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  
+  std::vector<Route> routes;
+  if (!parseRoutes(env, info[0], &routes)) {
+    return env.Null();
+  }
+  applyRouting(routes);
+  
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("success", Napi::Boolean::New(env, true));
+  result.Set("routes", routesToArray(env));
+  
+  return result;
+}
+
+// Flux de télémétrie : callback(trame) appelé frameRate fois par seconde, sans requête
+// Options : { frameRate (1 à 240, défaut 30), bands (bandes du spectre, 0 : sans spectre) }
+Napi::Value ASIOHandler::StartTelemetry(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  if (info.Length() < 1 || !info[0].IsFunction()) {
+    Napi::TypeError::New(env, "Argument 1 doit être une fonction recevant les trames de télémétrie").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  
+  double frameRate = kDefaultTelemetryRate;
+  uint32_t bands = 32;
+  if (info.Length() >= 2 && info[1].IsObject()) {
+    Napi::Object options = info[1].As<Napi::Object>();
+    if (!parseFrameRate(env, options, &frameRate)) {
+      return env.Null();
+    }
+    if (options.Has("bands")) {
+      Napi::Value value = options.Get("bands");
+      const double requested = value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : -1.0;
+      if (!(requested >= 0.0 && requested <= kMaxSpectrumBands)) {
+        Napi::RangeError::New(env, "bands doit être compris entre 0 et " + std::to_string(kMaxSpectrumBands)).ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      bands = static_cast<uint32_t>(requested);
+    }
+  }
+  
+  // Un seul flux : le précédent est remplacé
+  stopTelemetryThread();
+  telemetryPeriodNs = static_cast<int64_t>(1e9 / frameRate);
+  telemetryBands = bands;
+  
+  // File de deux trames : si JavaScript prend du retard, les trames suivantes sont ignorées
+  telemetryFunction = Napi::ThreadSafeFunction::New(env, info[0].As<Napi::Function>(), "asio_telemetry", 2, 1);
+  // Le flux seul ne maintient pas Node en vie
+  telemetryFunction.Unref(env);
+  telemetryRunning.store(true);
+  telemetryThread = std::thread(&ASIOHandler::telemetryLoop, this);
+  
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("success", Napi::Boolean::New(env, true));
+  result.Set("frameRate", Napi::Number::New(env, frameRate));
+  result.Set("bands", Napi::Number::New(env, bands));
+  return result;
+}
+
+Napi::Value ASIOHandler::StopTelemetry(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  stopTelemetryThread();
+  
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("success", Napi::Boolean::New(env, true));
+  return result;
+}
+
+void ASIOHandler::stopTelemetryThread() {
+  // Au plus une période d'attente ; aussi appelé à la fermeture du moteur et de l'environnement
+  // Node. Les trames encore en file référencent le moteur : abandonnées (Abort), elles sont
+  // libérées par deliverTelemetry sans être lues
+  telemetryRunning.store(false);
+  if (telemetryThread.joinable()) {
+    telemetryThread.join();
+    telemetryFunction.Abort();
+  }
+}
+
+bool ASIOHandler::parseFrameRate(Napi::Env env, Napi::Object options, double* frameRate) {
+  if (options.Has("frameRate")) {
+    Napi::Value value = options.Get("frameRate");
+    *frameRate = value.IsNumber() ? value.As<Napi::Number>().DoubleValue() : 0.0;
+    if (!(*frameRate >= 1.0 && *frameRate <= kMaxTelemetryRate)) {
+      Napi::RangeError::New(env, "frameRate doit être compris entre 1 et " + std::to_string(static_cast<int>(kMaxTelemetryRate))).ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  return true;
+}
+
+void ASIOHandler::waitNextFrame(std::chrono::steady_clock::time_point* next, int64_t periodNs) {
+  // Cadence fixe ; après un retard (machine chargée), repartir de maintenant sans rafale
+  *next += std::chrono::nanoseconds(periodNs);
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (*next < now) {
+    *next = now;
+  }
+  std::this_thread::sleep_until(*next);
+}
+
+void ASIOHandler::telemetryLoop() {
+  std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+  while (telemetryRunning.load(std::memory_order_acquire)) {
+    waitNextFrame(&next, telemetryPeriodNs);
+    
+    // Instantanés publiés par le callback : lectures sans verrou
+    TelemetryFrame* frame = new TelemetryFrame{this, inputMeter.snapshot(), callbackStats.snapshot(),
+                                               processing.load(std::memory_order_acquire), monotonicNs()};
+    const napi_status status = telemetryFunction.NonBlockingCall(frame, &ASIOHandler::deliverTelemetry);
+    if (status != napi_ok) {
+      // File pleine (trame ignorée) ou environnement Node en cours de fermeture
+      delete frame;
+      if (status == napi_closing) {
+        break;
+      }
+    }
+  }
+}
+
+void ASIOHandler::deliverTelemetry(Napi::Env env, Napi::Function callback, TelemetryFrame* frame) {
+  std::unique_ptr<TelemetryFrame> owned(frame);
+  if (env == nullptr) {
+    return;
+  }
+  
+  // Le spectre est calculé ici, sur le thread Node (comme GetFFTData), directement
+  // dans le Float32Array de la trame (initialisé à zéro)
+  ASIOHandler* engine = frame->engine;
+  Napi::Float32Array fft = Napi::Float32Array::New(env, engine->telemetryBands);
+  if (frame->processing && engine->telemetryBands > 0) {
+    engine->computeDisplaySpectrum(engine->telemetryBands, fft.Data());
+  }
+  
+  Napi::Object levels = Napi::Object::New(env);
+  levels.Set("rms", Napi::Number::New(env, frame->levels.rms));
+  levels.Set("peak", Napi::Number::New(env, frame->levels.peak));
+  levels.Set("peakHold", Napi::Number::New(env, frame->levels.peakHold));
+  levels.Set("blocks", Napi::Number::New(env, frame->levels.blocks));
+  
+  const CallbackStatsSnapshot& stats = frame->stats;
+  Napi::Object dspLoad = Napi::Object::New(env);
+  dspLoad.Set("current", Napi::Number::New(env, stats.dspLoad));
+  dspLoad.Set("mean", Napi::Number::New(env, stats.meanDspLoad));
+  dspLoad.Set("peak", Napi::Number::New(env, stats.peakDspLoad));
+  
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("timeMs", Napi::Number::New(env, static_cast<double>(frame->timeNs) / 1e6));
+  result.Set("processing", Napi::Boolean::New(env, frame->processing));
+  result.Set("level", Napi::Number::New(env, frame->processing ? displayLevel(frame->levels.rms) : 0.0f));
+  result.Set("levels", levels);
+  result.Set("fft", fft);
+  result.Set("callbacks", Napi::Number::New(env, static_cast<double>(stats.callbacks)));
+  result.Set("overruns", Napi::Number::New(env, static_cast<double>(stats.overruns)));
+  result.Set("lateCallbacks", Napi::Number::New(env, static_cast<double>(stats.lateCallbacks)));
+  result.Set("dspLoad", dspLoad);
+  
+  callback.Call({result});
+}
+
+// Télémétrie en mémoire partagée : la région est un Int32Array sur un SharedArrayBuffer
+// (Atomics.load côté lecteurs), de taille 4 * (32 + bandes) octets ; le nombre de bandes
+// du spectre découle de la taille. Options : { frameRate (1 à 240, défaut 30) }
+Napi::Value ASIOHandler::StartSharedTelemetry(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  
+  if (info.Length() < 1 || !info[0].IsTypedArray() ||
+      info[0].As<Napi::TypedArray>().TypedArrayType() != napi_int32_array) {
+    Napi::TypeError::New(env, "Argument 1 doit être un Int32Array sur un SharedArrayBuffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  Napi::Int32Array array = info[0].As<Napi::Int32Array>();
+  if (array.ElementLength() < kSharedTelemetryHeaderWords ||
+      array.ElementLength() > kSharedTelemetryHeaderWords + kMaxSpectrumBands) {
+    Napi::RangeError::New(env, "La région doit contenir entre " + std::to_string(kSharedTelemetryHeaderWords) + " et " +
+                          std::to_string(kSharedTelemetryHeaderWords + kMaxSpectrumBands) + " mots de 32 bits").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  
+  double frameRate = kDefaultTelemetryRate;
+  if (info.Length() >= 2 && info[1].IsObject()) {
+    if (!parseFrameRate(env, info[1].As<Napi::Object>(), &frameRate)) {
+      return env.Null();
+    }
+  }
+  
+  // Une seule région : la précédente est détachée
+  stopSharedTelemetryThread();
+  const uint32_t bands = static_cast<uint32_t>(array.ElementLength() - kSharedTelemetryHeaderWords);
+  if (!sharedTelemetryRegion.attach(array.Data(), array.ByteLength(), bands)) {
+    Napi::Error::New(env, "Région de télémétrie mal alignée").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  sharedTelemetryArray = Napi::Persistent(array.As<Napi::Object>());
+  sharedSpectrum.assign(bands, 0.0f);
+  sharedTelemetryPeriodNs = static_cast<int64_t>(1e9 / frameRate);
+  sharedTelemetryRunning.store(true);
+  sharedTelemetryThread = std::thread(&ASIOHandler::sharedTelemetryLoop, this);
+  
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("success", Napi::Boolean::New(env, true));
+  result.Set("frameRate", Napi::Number::New(env, frameRate));
+  result.Set("bands", Napi::Number::New(env, bands));
+  result.Set("version", Napi::Number::New(env, kSharedTelemetryVersion));
+  return result;
+}
+
+Napi::Value ASIOHandler::StopSharedTelemetry(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
   
+  stopSharedTelemetryThread();
+  
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("success", Napi::Boolean::New(env, true));
   return result;
 }
 
+void ASIOHandler::stopSharedTelemetryThread() {
+  // Le thread est arrêté avant de relâcher la mémoire ; aussi appelé à la fermeture du moteur
+  // et de l'environnement Node
+  sharedTelemetryRunning.store(false);
+  if (sharedTelemetryThread.joinable()) {
+    sharedTelemetryThread.join();
+  }
+  sharedTelemetryRegion.detach();
+  sharedTelemetryArray.Reset();
+}
+
+void ASIOHandler::sharedTelemetryLoop() {
+  std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+  while (sharedTelemetryRunning.load(std::memory_order_acquire)) {
+    waitNextFrame(&next, sharedTelemetryPeriodNs);
+    
+    const bool running = processing.load(std::memory_order_acquire);
+    const LevelSnapshot levels = inputMeter.snapshot();
+    const CallbackStatsSnapshot stats = callbackStats.snapshot();
+    if (running && !sharedSpectrum.empty()) {
+      computeDisplaySpectrum(static_cast<uint32_t>(sharedSpectrum.size()), sharedSpectrum.data());
+    } else {
+      std::fill(sharedSpectrum.begin(), sharedSpectrum.end(), 0.0f);
+    }
+    
+    SharedTelemetryFrame frame;
+    frame.processing = running;
+    frame.timeUs = static_cast<uint64_t>(monotonicNs() / 1000);
+    frame.level = running ? displayLevel(levels.rms) : 0.0f;
+    frame.rms = levels.rms;
+    frame.peak = levels.peak;
+    frame.peakHold = levels.peakHold;
+    frame.blocks = levels.blocks;
+    frame.callbacks = stats.callbacks;
+    frame.overruns = stats.overruns;
+    frame.lateCallbacks = stats.lateCallbacks;
+    frame.dspLoad = static_cast<float>(stats.dspLoad);
+    frame.meanDspLoad = static_cast<float>(stats.meanDspLoad);
+    frame.peakDspLoad = static_cast<float>(stats.peakDspLoad);
+    sharedTelemetryRegion.publish(frame, sharedSpectrum.data());
+  }
+}
+
 Napi::Object ASIOHandler::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(env, "ASIOHandler", {
     StaticMethod("getDevices", &ASIOHandler::getDevices),
-    StaticMethod("initialize", &ASIOHandler::Initialize),
-    StaticMethod("start", &ASIOHandler::Start),
-    StaticMethod("stop", &ASIOHandler::Stop),
-    StaticMethod("getInputLevel", &ASIOHandler::GetInputLevel),
-    StaticMethod("getFFTData", &ASIOHandler::GetFFTData),
-    StaticMethod("setInversionGain", &ASIOHandler::SetInversionGain)
+    StaticMethod("refreshDevices", &ASIOHandler::RefreshDevices),
+    StaticMethod("processFiles", &ASIOHandler::ProcessFiles),
+    InstanceMethod("initialize", &ASIOHandler::Initialize),
+    InstanceMethod("start", &ASIOHandler::Start),
+    InstanceMethod("stop", &ASIOHandler::Stop),
+    InstanceMethod("close", &ASIOHandler::Close),
+    InstanceMethod("getInputLevel", &ASIOHandler::GetInputLevel),
+    InstanceMethod("getFFTData", &ASIOHandler::GetFFTData),
+    InstanceMethod("getLevels", &ASIOHandler::GetLevels),
+    InstanceMethod("getWaveform", &ASIOHandler::GetWaveform),
+    InstanceMethod("setInversionGain", &ASIOHandler::SetInversionGain),
+    InstanceMethod("setRouting", &ASIOHandler::SetRouting),
+    InstanceMethod("getTimeInfo", &ASIOHandler::GetTimeInfo),
+    InstanceMethod("getStats", &ASIOHandler::GetStats),
+    InstanceMethod("startTelemetry", &ASIOHandler::StartTelemetry),
+    InstanceMethod("stopTelemetry", &ASIOHandler::StopTelemetry),
+    InstanceMethod("startSharedTelemetry", &ASIOHandler::StartSharedTelemetry),
+    InstanceMethod("stopSharedTelemetry", &ASIOHandler::StopSharedTelemetry)
   });
   
+  // Journal : les messages restants sont écrits à la fermeture, après l'arrêt des autres
+  // threads (les crochets sont appelés dans l'ordre inverse de leur ajout)
+  engineLog.start(&writeLogMessage);
+  env.AddCleanupHook(&stopEngineLog);
+  
+  // Les threads des moteurs (télémétrie, horloge du pilote) doivent être arrêtés avant la
+  // destruction de l'environnement, une fois le thread de contrôle arrêté
+  env.AddCleanupHook(&ASIOHandler::stopEngines);
+  env.AddCleanupHook(&ASIOHandler::stopControlThread);
+  
+  // Liste initiale : périphériques simulés, complétée par le premier sondage des pilotes
+  deviceCache = simulatedDevices();
+#ifdef ASIO_INCLUDED
+  queueDeviceProbe(env);
+#endif
+  
   Napi::FunctionReference* constructor = new Napi::FunctionReference();
   *constructor = Napi::Persistent(func);
   
@@ -0,0 +1,231 @@
+// Banc d'essai de FastConvertSamples
+// Pour chaque convertisseur et chaque taille de buffer : débit (Go/s, octets lus + écrits)
+// du portage scalaire du SDK et du niveau SIMD détecté, et vérification que les deux
+// produisent exactement les mêmes octets.
+//
+// Usage : convert_bench [taille ...]   (défaut : 64 256 1024 4096 trames)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "../fast_convert_samples.h"
+
+namespace {
+
+// Buffers d'un essai : deux sources 32 bits (gauche, droite) et deux destinations.
+// Les routines en place travaillent dans dest[0], restauré avant chaque appel.
+struct Buffers {
+  std::vector<int32_t> left;
+  std::vector<int32_t> right;
+  std::vector<unsigned char> dest[2];
+};
+
+struct Case {
+  const char* name;
+  bool inPlace;       // dest[0] est restauré depuis la source avant chaque appel
+  bool floatSource;   // source float dans [-1, 1] (float32toIntNN)
+  size_t inBytes;     // octets lus par trame
+  size_t outBytes;    // octets écrits par trame
+  std::function<void(const FastConvertSamples&, Buffers&, long)> run;
+};
+
+#define SPLIT(fn, T)                                                                               \
+  [](const FastConvertSamples& c, Buffers& b, long n) {                                            \
+    c.fn(b.left.data(), b.right.data(), reinterpret_cast<T*>(b.dest[0].data()),                    \
+         reinterpret_cast<T*>(b.dest[1].data()), n);                                               \
+  }
+#define INTERLEAVED(fn, T)                                                                         \
+  [](const FastConvertSamples& c, Buffers& b, long n) {                                            \
+    c.fn(b.left.data(), b.right.data(), reinterpret_cast<T*>(b.dest[0].data()), n);                \
+  }
+#define MONO(fn, T)                                                                                \
+  [](const FastConvertSamples& c, Buffers& b, long n) {                                            \
+    c.fn(b.left.data(), reinterpret_cast<T*>(b.dest[0].data()), n);                                \
+  }
+#define IN_PLACE(fn, T)                                                                            \
+  [](const FastConvertSamples& c, Buffers& b, long n) {                                            \
+    c.fn(reinterpret_cast<T*>(b.dest[0].data()), n);                                               \
+  }
+
+std::vector<Case> allCases() {
+  return {
+    {"convertMono8", false, false, 4, 1, MONO(convertMono8, char)},
+    {"convertMono8Unsigned", false, false, 4, 1, MONO(convertMono8Unsigned, char)},
+    {"convertMono16", false, false, 4, 2, MONO(convertMono16, short)},
+    {"convertMono16SmallEndian", false, false, 4, 2, MONO(convertMono16SmallEndian, short)},
+    {"convertMono24", false, false, 4, 3, MONO(convertMono24, char)},
+    {"convertMono24SmallEndian", false, false, 4, 3, MONO(convertMono24SmallEndian, char)},
+    {"convertStereo8Interleaved", false, false, 8, 2, INTERLEAVED(convertStereo8Interleaved, char)},
+    {"convertStereo8InterleavedUnsigned", false, false, 8, 2, INTERLEAVED(convertStereo8InterleavedUnsigned, char)},
+    {"convertStereo16Interleaved", false, false, 8, 4, INTERLEAVED(convertStereo16Interleaved, short)},
+    {"convertStereo16InterleavedSmallEndian", false, false, 8, 4, INTERLEAVED(convertStereo16InterleavedSmallEndian, short)},
+    {"convertStereo24Interleaved", false, false, 8, 6, INTERLEAVED(convertStereo24Interleaved, char)},
+    {"convertStereo24InterleavedSmallEndian", false, false, 8, 6, INTERLEAVED(convertStereo24InterleavedSmallEndian, char)},
+    {"convertStereo8", false, false, 8, 2, SPLIT(convertStereo8, char)},
+    {"convertStereo8Unsigned", false, false, 8, 2, SPLIT(convertStereo8Unsigned, char)},
+    {"convertStereo16", false, false, 8, 4, SPLIT(convertStereo16, short)},
+    {"convertStereo16SmallEndian", false, false, 8, 4, SPLIT(convertStereo16SmallEndian, short)},
+    {"convertStereo24", false, false, 8, 6, SPLIT(convertStereo24, char)},
+    {"convertStereo24SmallEndian", false, false, 8, 6, SPLIT(convertStereo24SmallEndian, char)},
+    {"int32msb16to16inPlace", true, false, 4, 2, IN_PLACE(int32msb16to16inPlace, int32_t)},
+    {"int32lsb16to16inPlace", true, false, 4, 2, IN_PLACE(int32lsb16to16inPlace, int32_t)},
+    {"int32msb16shiftedTo16inPlace", true, false, 4, 2,
+     [](const FastConvertSamples& c, Buffers& b, long n) {
+       c.int32msb16shiftedTo16inPlace(reinterpret_cast<int32_t*>(b.dest[0].data()), n, 8);
+     }},
+    {"int24msbto16inPlace", true, false, 3, 2, IN_PLACE(int24msbto16inPlace, unsigned char)},
+    {"shift32 (16 bits)", true, false, 4, 2,
+     [](const FastConvertSamples& c, Buffers& b, long n) { c.shift32(b.dest[0].data(), 8, 2, false, n); }},
+    {"shift32 (24 bits, inversé)", true, false, 4, 3,
+     [](const FastConvertSamples& c, Buffers& b, long n) { c.shift32(b.dest[0].data(), 8, 3, true, n); }},
+    {"shift32 (32 bits)", true, false, 4, 4,
+     [](const FastConvertSamples& c, Buffers& b, long n) { c.shift32(b.dest[0].data(), 8, 4, false, n); }},
+    {"reverseEndian (16 bits)", true, false, 2, 2,
+     [](const FastConvertSamples& c, Buffers& b, long n) { c.reverseEndian(b.dest[0].data(), 2, n); }},
+    {"reverseEndian (24 bits)", true, false, 3, 3,
+     [](const FastConvertSamples& c, Buffers& b, long n) { c.reverseEndian(b.dest[0].data(), 3, n); }},
+    {"reverseEndian (32 bits)", true, false, 4, 4,
+     [](const FastConvertSamples& c, Buffers& b, long n) { c.reverseEndian(b.dest[0].data(), 4, n); }},
+    {"int32to16inPlace", true, false, 4, 2, IN_PLACE(int32to16inPlace, void)},
+    {"int24to16inPlace", true, false, 3, 2, IN_PLACE(int24to16inPlace, void)},
+    {"int32to24inPlace", true, false, 4, 3, IN_PLACE(int32to24inPlace, void)},
+    {"int16to24inPlace", true, false, 2, 3, IN_PLACE(int16to24inPlace, void)},
+    {"int24to32inPlace", true, false, 3, 4, IN_PLACE(int24to32inPlace, void)},
+    {"int16to32inPlace", true, false, 2, 4, IN_PLACE(int16to32inPlace, void)},
+    {"float32toInt16inPlace", true, true, 4, 2, IN_PLACE(float32toInt16inPlace, float)},
+    {"float32toInt24inPlace", true, true, 4, 3, IN_PLACE(float32toInt24inPlace, float)},
+    {"float32toInt32inPlace", true, true, 4, 4, IN_PLACE(float32toInt32inPlace, float)},
+  };
+}
+
+Buffers makeBuffers(long frames, bool floatSource) {
+  std::mt19937 rng(1234);
+  Buffers b;
+  b.left.resize(frames);
+  b.right.resize(frames);
+  if (floatSource) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (long i = 0; i < frames; ++i) {
+      float value = dist(rng);
+      std::memcpy(&b.left[i], &value, sizeof(value));
+    }
+  } else {
+    for (long i = 0; i < frames; ++i) {
+      b.left[i] = static_cast<int32_t>(rng());
+      b.right[i] = static_cast<int32_t>(rng());
+    }
+  }
+  // Jusqu'à 6 octets par trame en sortie (24 bits entrelacé)
+  for (auto& dest : b.dest) {
+    dest.assign(frames * 6, 0);
+  }
+  return b;
+}
+
+volatile unsigned char sink;
+
+void restore(const Case& c, Buffers& b, long frames) {
+  if (c.inPlace) {
+    std::memcpy(b.dest[0].data(), b.left.data(), frames * sizeof(int32_t));
+  }
+}
+
+// Meilleur temps par appel (ns) sur plusieurs mesures d'environ 2 ms ; pour les routines
+// en place, le temps de la restauration du buffer est mesuré à part et retranché.
+double bestNsPerCall(const Case& c, const FastConvertSamples& conv, Buffers& b, long frames) {
+  using Clock = std::chrono::steady_clock;
+  const long calls = std::max(16L, 2000000L / std::max(1L, frames));
+  double best = 1e300;
+  double bestRestore = 1e300;
+  for (int round = 0; round < 7; ++round) {
+    auto t0 = Clock::now();
+    for (long k = 0; k < calls; ++k) {
+      restore(c, b, frames);
+      c.run(conv, b, frames);
+    }
+    auto t1 = Clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count() / calls);
+
+    if (c.inPlace) {
+      t0 = Clock::now();
+      for (long k = 0; k < calls; ++k) {
+        restore(c, b, frames);
+        sink = b.dest[0][static_cast<size_t>(k % frames)];
+      }
+      t1 = Clock::now();
+      bestRestore = std::min(bestRestore, std::chrono::duration<double, std::nano>(t1 - t0).count() / calls);
+    }
+  }
+  if (c.inPlace) {
+    best = std::max(best - bestRestore, 1e-3);
+  }
+  return best;
+}
+
+const char* levelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::AVX512: return "avx512 (sse2 + ssse3)";
+    case SimdLevel::AVX2: return "avx2 (sse2 + ssse3)";
+    case SimdLevel::SSE2: return "sse2";
+    default: return "scalar";
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<long> sizes;
+  for (int i = 1; i < argc; ++i) {
+    const long frames = std::strtol(argv[i], nullptr, 10);
+    if (frames <= 0) {
+      std::fprintf(stderr, "Taille invalide : %s\n", argv[i]);
+      return 2;
+    }
+    sizes.push_back(frames);
+  }
+  if (sizes.empty()) {
+    sizes = {64, 256, 1024, 4096};
+  }
+
+  const FastConvertSamples reference(SimdLevel::Scalar);
+  const FastConvertSamples fast;
+  std::printf("Niveau SIMD : %s\n\n", levelName(fast.level()));
+  std::printf("%-40s %7s %12s %12s %9s\n", "convertisseur", "trames", "scalaire", "simd", "gain");
+
+  int mismatches = 0;
+  for (const Case& c : allCases()) {
+    for (long frames : sizes) {
+      // Vérification : mêmes octets en sortie (et au-delà, pour les routines en place)
+      Buffers expected = makeBuffers(frames, c.floatSource);
+      Buffers actual = expected;
+      restore(c, expected, frames);
+      restore(c, actual, frames);
+      c.run(reference, expected, frames);
+      c.run(fast, actual, frames);
+      const bool same = expected.dest[0] == actual.dest[0] && expected.dest[1] == actual.dest[1];
+      if (!same) {
+        ++mismatches;
+      }
+
+      Buffers work = makeBuffers(frames, c.floatSource);
+      const double bytes = static_cast<double>(frames) * (c.inBytes + c.outBytes);
+      const double scalarNs = bestNsPerCall(c, reference, work, frames);
+      const double simdNs = bestNsPerCall(c, fast, work, frames);
+      std::printf("%-40s %7ld %7.2f Go/s %7.2f Go/s %8.2fx%s\n", c.name, frames, bytes / scalarNs,
+                  bytes / simdNs, scalarNs / simdNs, same ? "" : "  DIFFÉRENT");
+    }
+  }
+
+  if (mismatches > 0) {
+    std::printf("\n%d résultat(s) différent(s) du portage scalaire\n", mismatches);
+    return 1;
+  }
+  return 0;
+}
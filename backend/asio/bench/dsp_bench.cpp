@@ -0,0 +1,227 @@
+// Micro-banc d'essai du noyau DSP (bibliothèque annulateur_dsp)
+// Balaye les tailles de buffer ASIO (32 à 2048) et le nombre de canaux (1 à 18) pour
+// chaque étape du callback : conversion depuis / vers le format du pilote, inversion
+// (matrice de routage et rampe de gain), mesure de niveau et analyse spectrale.
+// Pour chaque point : ns/échantillon, cycles/échantillon (compteur TSC sur x86) et
+// débit en millions d'échantillons par seconde, meilleur de plusieurs mesures.
+//
+// Usage : dsp_bench [--csv] [--sizes 32,64,...] [--channels 1,2,...]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../simd_support.h"
+#if DSP_X86 && !defined(_MSC_VER)
+#include <x86intrin.h>
+#endif
+
+#include "../aligned_buffer.h"
+#include "../dsp_kernels.h"
+#include "../fft_engine.h"
+#include "../level_meter.h"
+#include "../routing_matrix.h"
+#include "../sample_format.h"
+#include "../smoothed_parameter.h"
+
+namespace {
+
+const size_t kSpectrumBands = 32;
+
+uint64_t readCycles() {
+#if DSP_X86
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+std::vector<size_t> parseList(const char* text) {
+  std::vector<size_t> values;
+  for (const char* p = text; *p;) {
+    char* end = nullptr;
+    const unsigned long value = std::strtoul(p, &end, 10);
+    if (end == p || value == 0) {
+      return std::vector<size_t>();
+    }
+    values.push_back(static_cast<size_t>(value));
+    p = *end == ',' ? end + 1 : end;
+  }
+  return values;
+}
+
+// Un point de mesure : une fonction qui traite un bloc complet (blockSize x channels)
+struct Measure {
+  double nsPerSample;
+  double cyclesPerSample;
+};
+
+Measure measure(const std::function<void()>& block, size_t samplesPerCall) {
+  using Clock = std::chrono::steady_clock;
+  // Environ 2 ms par mesure, au moins 8 appels
+  const size_t calls = std::max<size_t>(8, 2000000 / std::max<size_t>(1, samplesPerCall));
+  for (size_t i = 0; i < calls / 4 + 1; i++) {
+    block(); // mise en cache et en régime
+  }
+  double bestNs = 1e300;
+  double bestCycles = 1e300;
+  for (int round = 0; round < 5; round++) {
+    const uint64_t c0 = readCycles();
+    const Clock::time_point t0 = Clock::now();
+    for (size_t i = 0; i < calls; i++) {
+      block();
+    }
+    const Clock::time_point t1 = Clock::now();
+    const uint64_t c1 = readCycles();
+    bestNs = std::min(bestNs, std::chrono::duration<double, std::nano>(t1 - t0).count());
+    bestCycles = std::min(bestCycles, static_cast<double>(c1 - c0));
+  }
+  const double samples = static_cast<double>(calls) * static_cast<double>(samplesPerCall);
+  return Measure{bestNs / samples, bestCycles / samples};
+}
+
+// Données de test et objets du noyau pour une taille de bloc et un nombre de canaux
+struct Fixture {
+  size_t block;
+  size_t channels;
+  std::vector<int32_t> driver;       // buffers pilote Int32LSB, canal après canal
+  std::vector<uint8_t> driverOut;    // buffers pilote Int24LSB en sortie
+  RoutingMatrix routing;
+  SmoothedParameter gain{-1.0f};
+  std::vector<std::unique_ptr<LevelMeter>> meters;
+  SpectrumAnalyzer spectrum;
+  std::vector<float> bands;
+
+  Fixture(size_t blockSize, size_t channelCount) : block(blockSize), channels(channelCount) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> dist(-(1 << 30), 1 << 30);
+    driver.resize(block * channels);
+    for (int32_t& sample : driver) {
+      sample = dist(rng);
+    }
+    driverOut.assign(block * channels * 3, 0);
+
+    // Une route par canal (entrée i -> sortie i), comme une inversion multicanale
+    std::vector<Route> routes;
+    for (size_t c = 0; c < channels; c++) {
+      routes.push_back(Route{static_cast<long>(c), static_cast<long>(c), 1.0f});
+    }
+    routing.configure(routes, block);
+    for (long half = 0; half < 2; half++) {
+      for (size_t c = 0; c < channels; c++) {
+        float* plane = routing.inputPlane(half, c);
+        for (size_t i = 0; i < block; i++) {
+          plane[i] = static_cast<float>(driver[c * block + i]) / 2147483648.0f;
+        }
+      }
+    }
+    gain.configure(48000.0, block, 20.0);
+    gain.reset();
+
+    for (size_t c = 0; c < channels; c++) {
+      meters.emplace_back(new LevelMeter());
+      meters.back()->configure(48000.0, block);
+    }
+    spectrum.configure(block, kSpectrumBands);
+    bands.resize(kSpectrumBands);
+  }
+};
+
+struct Kernel {
+  const char* name;
+  std::function<void(Fixture&)> run;
+};
+
+std::vector<Kernel> kernels(SimdLevel level) {
+  const SampleConverter* in = sampleConverterFor(SampleFormat::Int32LSB, level);
+  const SampleConverter* out = sampleConverterFor(SampleFormat::Int24LSB, level);
+  return {
+    {"conversion Int32LSB -> float", [in](Fixture& f) {
+       for (size_t c = 0; c < f.channels; c++) {
+         in->toFloat(f.driver.data() + c * f.block, f.routing.inputPlane(0, c), f.block);
+       }
+     }},
+    {"inversion (routage + gain)", [](Fixture& f) {
+       f.routing.process(0, f.gain.nextRamp(f.block));
+     }},
+    {"inversion en rampe", [](Fixture& f) {
+       // Cible modifiée à chaque bloc : la rampe linéaire ne s'arrête jamais
+       f.gain.setTarget(f.gain.target() < -0.75f ? -0.5f : -1.0f);
+       f.routing.process(0, f.gain.nextRamp(f.block));
+     }},
+    {"mesure de niveau", [](Fixture& f) {
+       for (size_t c = 0; c < f.channels; c++) {
+         f.meters[c]->process(f.routing.inputPlane(0, c), f.block);
+       }
+     }},
+    {"spectre (FFT + bandes)", [](Fixture& f) {
+       for (size_t c = 0; c < f.channels; c++) {
+         f.spectrum.analyze(f.routing.inputPlane(0, c), f.bands.data());
+       }
+     }},
+    {"conversion float -> Int24LSB", [out](Fixture& f) {
+       for (size_t c = 0; c < f.channels; c++) {
+         out->fromFloat(f.routing.outputPlane(0, c), f.driverOut.data() + c * f.block * 3, f.block);
+       }
+     }},
+  };
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  bool csv = false;
+  std::vector<size_t> sizes = {32, 64, 128, 256, 512, 1024, 2048};
+  std::vector<size_t> channelCounts = {1, 2, 4, 8, 16, 18};
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--csv") {
+      csv = true;
+    } else if ((arg == "--sizes" || arg == "--channels") && i + 1 < argc) {
+      std::vector<size_t> values = parseList(argv[++i]);
+      if (values.empty()) {
+        std::fprintf(stderr, "Liste invalide : %s\n", argv[i]);
+        return 2;
+      }
+      (arg == "--sizes" ? sizes : channelCounts) = values;
+    } else {
+      std::fprintf(stderr, "Usage : dsp_bench [--csv] [--sizes 32,64,...] [--channels 1,2,...]\n");
+      return 2;
+    }
+  }
+
+  const DspKernels& table = selectDspKernels();
+  const std::vector<Kernel> list = kernels(table.level);
+  if (csv) {
+    std::printf("kernel,simd,block,channels,ns_per_sample,cycles_per_sample,msamples_per_s\n");
+  } else {
+    std::printf("Noyaux : %s%s\n\n", table.name, DSP_X86 ? "" : " (cycles non mesurés)");
+    std::printf("%-30s %6s %6s %12s %14s %14s\n", "noyau", "bloc", "canaux", "ns/éch.", "cycles/éch.", "Méch./s");
+  }
+
+  for (const Kernel& kernel : list) {
+    for (size_t block : sizes) {
+      for (size_t channels : channelCounts) {
+        Fixture fixture(block, channels);
+        const Measure m = measure([&]() { kernel.run(fixture); }, block * channels);
+        const double throughput = 1000.0 / m.nsPerSample;
+        if (csv) {
+          std::printf("%s,%s,%zu,%zu,%.4f,%.4f,%.1f\n", kernel.name, table.name, block, channels,
+                      m.nsPerSample, m.cyclesPerSample, throughput);
+        } else {
+          std::printf("%-30s %6zu %6zu %12.4f %14.4f %14.1f\n", kernel.name, block, channels,
+                      m.nsPerSample, m.cyclesPerSample, throughput);
+        }
+      }
+    }
+  }
+  return 0;
+}
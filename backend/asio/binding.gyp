@@ -4,6 +4,22 @@
       "target_name": "asio_addon",
       "sources": [
         "<(module_root_dir)/asio_processor.cpp",
+        "<(module_root_dir)/fft_engine.cpp",
+        "<(module_root_dir)/level_meter.cpp",
+        "<(module_root_dir)/dsp_kernels.cpp",
+        "<(module_root_dir)/smoothed_parameter.cpp",
+        "<(module_root_dir)/routing_matrix.cpp",
+        "<(module_root_dir)/fxlms_canceller.cpp",
+        "<(module_root_dir)/partitioned_convolver.cpp",
+        "<(module_root_dir)/block_clock.cpp",
+        "<(module_root_dir)/callback_stats.cpp",
+        "<(module_root_dir)/sample_format.cpp",
+        "<(module_root_dir)/processing_chain.cpp",
+        "<(module_root_dir)/offline_processor.cpp",
+        "<(module_root_dir)/shared_telemetry.cpp",
+        "<(module_root_dir)/rt_log.cpp",
+        "<(module_root_dir)/realtime_thread.cpp",
+        "<(module_root_dir)/virtual_asio_driver.cpp",
         "<(module_root_dir)/asiodrivers.cpp",
         "<(module_root_dir)/asiolist.cpp",
         "<(module_root_dir)/iasiodrv.cpp"
@@ -0,0 +1,110 @@
+#include "block_clock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+const size_t BlockClock::kHistory;
+
+void BlockClock::configure(double sampleRate, long newBlockSize) {
+  blockSize = newBlockSize;
+  nominalPeriodNs.store(sampleRate > 0.0 ? 1e9 * static_cast<double>(newBlockSize) / sampleRate : 0.0,
+                        std::memory_order_relaxed);
+}
+
+void BlockClock::reset() {
+  lastPosition = 0.0;
+  hasLastPosition = false;
+  written.store(0, std::memory_order_relaxed);
+  dropped.store(0, std::memory_order_relaxed);
+}
+
+void BlockClock::record(double samplePosition, double systemTime, uint32_t flags, long index) {
+  const uint64_t block = written.load(std::memory_order_relaxed);
+
+  // Un saut de position supérieur à un bloc signale des blocs perdus
+  if ((flags & kBlockPositionValid) != 0 && (flags & kBlockEstimated) == 0 && blockSize > 0) {
+    if (hasLastPosition) {
+      const double delta = samplePosition - lastPosition;
+      const double missing = std::floor(delta / static_cast<double>(blockSize) + 0.5) - 1.0;
+      if (missing >= 1.0) {
+        dropped.fetch_add(static_cast<uint64_t>(missing), std::memory_order_relaxed);
+      }
+    }
+    lastPosition = samplePosition;
+    hasLastPosition = true;
+  }
+
+  BlockTimeEntry entry;
+  entry.samplePosition = samplePosition;
+  entry.systemTime = systemTime;
+  entry.block = block;
+  entry.flags = flags;
+  entry.index = static_cast<int32_t>(index);
+  entries[block % kHistory].write(entry);
+  written.store(block + 1, std::memory_order_release);
+}
+
+size_t BlockClock::history(BlockTimeEntry* out, size_t maxEntries) const {
+  const uint64_t end = written.load(std::memory_order_acquire);
+  const uint64_t available = std::min<uint64_t>(end, std::min<size_t>(maxEntries, kHistory));
+  size_t count = 0;
+  for (uint64_t block = end - available; block < end; block++) {
+    const BlockTimeEntry entry = entries[block % kHistory].read();
+    // Entrée réécrite par le callback pendant la lecture : elle appartient à un bloc plus récent
+    if (entry.block != block) {
+      continue;
+    }
+    out[count++] = entry;
+  }
+  return count;
+}
+
+BlockClockStats BlockClock::stats() const {
+  BlockClockStats result = {};
+  result.blocks = written.load(std::memory_order_acquire);
+  result.droppedBlocks = dropped.load(std::memory_order_relaxed);
+  result.nominalPeriodNs = nominalPeriodNs.load(std::memory_order_relaxed);
+
+  std::vector<BlockTimeEntry> recent(kHistory);
+  const size_t count = history(recent.data(), recent.size());
+
+  double intervalSum = 0.0;
+  double deviationSum = 0.0;
+  double deviationMax = 0.0;
+  size_t intervals = 0;
+  for (size_t i = 1; i < count; i++) {
+    const BlockTimeEntry& a = recent[i - 1];
+    const BlockTimeEntry& b = recent[i];
+    if (b.block != a.block + 1 || (a.flags & b.flags & kBlockTimeValid) == 0) {
+      continue;
+    }
+    const double interval = b.systemTime - a.systemTime;
+    const double deviation = std::fabs(interval - result.nominalPeriodNs);
+    intervalSum += interval;
+    deviationSum += deviation;
+    deviationMax = std::max(deviationMax, deviation);
+    intervals++;
+  }
+
+  result.intervals = intervals;
+  if (intervals > 0) {
+    result.meanIntervalNs = intervalSum / static_cast<double>(intervals);
+    result.jitterMeanNs = deviationSum / static_cast<double>(intervals);
+    result.jitterMaxNs = deviationMax;
+  }
+
+  // Fréquence réelle sur toute la fenêtre : positions et temps du pilote uniquement
+  if (count >= 2) {
+    const BlockTimeEntry& first = recent[0];
+    const BlockTimeEntry& last = recent[count - 1];
+    const uint32_t required = kBlockPositionValid | kBlockTimeValid;
+    const bool driverClock = (first.flags & kBlockEstimated) == 0 && (last.flags & kBlockEstimated) == 0;
+    if (driverClock && (first.flags & required) == required && (last.flags & required) == required &&
+        last.systemTime > first.systemTime) {
+      result.measuredSampleRate = 1e9 * (last.samplePosition - first.samplePosition) /
+                                  (last.systemTime - first.systemTime);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,71 @@
+#ifndef __block_clock__
+#define __block_clock__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "seqlock.h"
+
+// Horodatage d'un bloc tel que fourni par bufferSwitchTimeInfo
+struct BlockTimeEntry {
+  double samplePosition;  // position du premier échantillon du bloc
+  double systemTime;      // temps système associé, en nanosecondes
+  uint64_t block;         // numéro de bloc depuis le démarrage
+  uint32_t flags;         // kBlockPositionValid | kBlockTimeValid | kBlockEstimated
+  int32_t index;          // moitié du double buffer (0 ou 1)
+};
+
+static const uint32_t kBlockPositionValid = 1u;
+static const uint32_t kBlockTimeValid = 1u << 1;
+static const uint32_t kBlockEstimated = 1u << 2; // pilote sans time info : horloge locale
+
+// Statistiques dérivées de l'historique (calculées côté lecteur)
+struct BlockClockStats {
+  uint64_t blocks;            // blocs enregistrés
+  uint64_t droppedBlocks;     // blocs perdus (saut de samplePosition)
+  size_t intervals;           // intervalles mesurés dans l'historique
+  double nominalPeriodNs;     // durée théorique d'un bloc
+  double meanIntervalNs;
+  double jitterMeanNs;        // écart absolu moyen à la période nominale
+  double jitterMaxNs;
+  double measuredSampleRate;  // déduite des positions et des temps système (0 si inconnue)
+};
+
+// Historique horodaté des blocs ASIO
+// L'écriture (callback) tient en quelques stores : pas d'appel au pilote, pas
+// d'allocation. L'historique est un anneau préalloué de seqlocks : les lecteurs
+// obtiennent les derniers blocs sans jamais bloquer le callback.
+class BlockClock {
+public:
+  static const size_t kHistory = 256;
+
+  // À l'arrêt
+  void configure(double sampleRate, long blockSize);
+  void reset();
+
+  // Côté callback
+  void record(double samplePosition, double systemTime, uint32_t flags, long index);
+
+  // Côté lecteur : copie jusqu'à maxEntries derniers blocs (du plus ancien au plus récent)
+  size_t history(BlockTimeEntry* entries, size_t maxEntries) const;
+
+  BlockClockStats stats() const;
+
+  uint64_t blocks() const { return written.load(std::memory_order_acquire); }
+
+private:
+  // Lu par stats() pendant qu'un démarrage le reconfigure
+  std::atomic<double> nominalPeriodNs{0.0};
+  long blockSize = 0;
+
+  // État propre au callback
+  double lastPosition = 0.0;
+  bool hasLastPosition = false;
+
+  std::atomic<uint64_t> written{0};
+  std::atomic<uint64_t> dropped{0};
+  SeqLock<BlockTimeEntry> entries[kHistory];
+};
+
+#endif
@@ -0,0 +1,143 @@
+#include "callback_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+void LatencyHistogram::reset() {
+  for (size_t i = 0; i < kBuckets; i++) {
+    counts[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t LatencyHistogram::bucketOf(uint64_t micros) {
+  if (micros < 4) {
+    return static_cast<size_t>(micros);
+  }
+  // Octave (bit de poids fort) puis deux bits suivants pour la sous-classe
+  size_t msb = 2;
+  while ((micros >> (msb + 1)) != 0) {
+    msb++;
+  }
+  const size_t sub = static_cast<size_t>((micros >> (msb - 2)) & 3);
+  return std::min((msb - 1) * 4 + sub, kBuckets - 1);
+}
+
+uint64_t LatencyHistogram::bucketLower(size_t bucket) {
+  if (bucket < 4) {
+    return bucket;
+  }
+  const size_t msb = bucket / 4 + 1;
+  return static_cast<uint64_t>(4 + bucket % 4) << (msb - 2);
+}
+
+void LatencyHistogram::add(uint64_t micros) {
+  // Écrivain unique : lecture puis écriture, sans instruction verrouillée
+  std::atomic<uint64_t>& counter = counts[bucketOf(micros)];
+  counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::total() const {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < kBuckets; i++) {
+    sum += count(i);
+  }
+  return sum;
+}
+
+double LatencyHistogram::quantile(double q) const {
+  const uint64_t n = total();
+  if (n == 0) {
+    return 0.0;
+  }
+  const uint64_t rank = static_cast<uint64_t>(std::ceil(std::max(0.0, std::min(q, 1.0)) * static_cast<double>(n)));
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < kBuckets; i++) {
+    cumulative += count(i);
+    if (cumulative >= std::max<uint64_t>(rank, 1)) {
+      return static_cast<double>(bucketLower(i));
+    }
+  }
+  return static_cast<double>(bucketLower(kBuckets - 1));
+}
+
+void CallbackStats::configure(double sampleRate, size_t blockSize) {
+  periodNs.store(sampleRate > 0.0 ? static_cast<int64_t>(1e9 * static_cast<double>(blockSize) / sampleRate) : 0,
+                 std::memory_order_relaxed);
+}
+
+void CallbackStats::reset() {
+  lastStartNs = 0;
+  callbacks.store(0, std::memory_order_relaxed);
+  overruns.store(0, std::memory_order_relaxed);
+  lateCallbacks.store(0, std::memory_order_relaxed);
+  intervals.store(0, std::memory_order_relaxed);
+  processingSumNs.store(0, std::memory_order_relaxed);
+  intervalSumNs.store(0, std::memory_order_relaxed);
+  lastProcessingNs.store(0, std::memory_order_relaxed);
+  maxProcessingNs.store(0, std::memory_order_relaxed);
+  maxIntervalNs.store(0, std::memory_order_relaxed);
+  processing.reset();
+  interval.reset();
+}
+
+void CallbackStats::record(int64_t startNs, int64_t endNs) {
+  // Écrivain unique : chaque compteur est mis à jour par lecture puis écriture relâchées
+  const int64_t elapsed = std::max<int64_t>(0, endNs - startNs);
+  lastProcessingNs.store(elapsed, std::memory_order_relaxed);
+  processingSumNs.store(processingSumNs.load(std::memory_order_relaxed) + static_cast<uint64_t>(elapsed),
+                        std::memory_order_relaxed);
+  if (elapsed > maxProcessingNs.load(std::memory_order_relaxed)) {
+    maxProcessingNs.store(elapsed, std::memory_order_relaxed);
+  }
+  processing.add(static_cast<uint64_t>(elapsed / 1000));
+  const int64_t period = periodNs.load(std::memory_order_relaxed);
+  if (period > 0 && elapsed > period) {
+    overruns.store(overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  if (lastStartNs != 0) {
+    const int64_t gap = std::max<int64_t>(0, startNs - lastStartNs);
+    intervalSumNs.store(intervalSumNs.load(std::memory_order_relaxed) + static_cast<uint64_t>(gap),
+                        std::memory_order_relaxed);
+    intervals.store(intervals.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (gap > maxIntervalNs.load(std::memory_order_relaxed)) {
+      maxIntervalNs.store(gap, std::memory_order_relaxed);
+    }
+    interval.add(static_cast<uint64_t>(gap / 1000));
+    if (period > 0 && 2 * gap > 3 * period) {
+      lateCallbacks.store(lateCallbacks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+  }
+  lastStartNs = startNs;
+
+  // Publié en dernier : un lecteur qui voit ce compteur voit le bloc (à la cohérence relâchée près)
+  callbacks.store(callbacks.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+CallbackStatsSnapshot CallbackStats::snapshot() const {
+  CallbackStatsSnapshot result = {};
+  result.callbacks = callbacks.load(std::memory_order_acquire);
+  result.overruns = overruns.load(std::memory_order_relaxed);
+  result.lateCallbacks = lateCallbacks.load(std::memory_order_relaxed);
+  result.periodUs = static_cast<double>(periodNs.load(std::memory_order_relaxed)) / 1000.0;
+  result.lastProcessingUs = static_cast<double>(lastProcessingNs.load(std::memory_order_relaxed)) / 1000.0;
+  result.maxProcessingUs = static_cast<double>(maxProcessingNs.load(std::memory_order_relaxed)) / 1000.0;
+  result.maxIntervalUs = static_cast<double>(maxIntervalNs.load(std::memory_order_relaxed)) / 1000.0;
+
+  const double processingSum = static_cast<double>(processingSumNs.load(std::memory_order_relaxed));
+  if (result.callbacks > 0) {
+    result.meanProcessingUs = processingSum / static_cast<double>(result.callbacks) / 1000.0;
+  }
+  const uint64_t intervalCount = intervals.load(std::memory_order_relaxed);
+  if (intervalCount > 0) {
+    result.meanIntervalUs = static_cast<double>(intervalSumNs.load(std::memory_order_relaxed)) /
+                            static_cast<double>(intervalCount) / 1000.0;
+  }
+
+  if (result.periodUs > 0.0) {
+    result.dspLoad = result.lastProcessingUs / result.periodUs;
+    result.meanDspLoad = result.meanProcessingUs / result.periodUs;
+    result.peakDspLoad = result.maxProcessingUs / result.periodUs;
+  }
+  return result;
+}
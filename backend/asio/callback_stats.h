@@ -0,0 +1,89 @@
+#ifndef __callback_stats__
+#define __callback_stats__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Histogramme logarithmique sans verrou (microsecondes)
+// Quatre sous-classes par octave : 0, 1, ..., 7, puis 8-9, 10-11, 12-13, 14-15, 16-19, ...
+// Un seul écrivain (le callback), lecteurs quelconques : chaque case est un compteur
+// atomique indépendant, la lecture est donc cohérente à quelques blocs près.
+class LatencyHistogram {
+public:
+  static const size_t kBuckets = 72; // jusqu'à ~0.5 s
+
+  void reset();
+  void add(uint64_t micros);
+
+  uint64_t count(size_t bucket) const { return counts[bucket].load(std::memory_order_relaxed); }
+  uint64_t total() const;
+
+  // Borne inférieure d'une case, en microsecondes
+  static uint64_t bucketLower(size_t bucket);
+  static size_t bucketOf(uint64_t micros);
+
+  // Quantile approché (borne inférieure de la case qui le contient), en microsecondes
+  double quantile(double q) const;
+
+private:
+  std::atomic<uint64_t> counts[kBuckets];
+};
+
+// Instantané des statistiques du callback
+struct CallbackStatsSnapshot {
+  uint64_t callbacks;        // callbacks chronométrés
+  uint64_t overruns;         // traitement plus long que la période du buffer
+  uint64_t lateCallbacks;    // intervalle supérieur à 1,5 période (callback retardé ou manqué)
+  double periodUs;           // période nominale d'un buffer
+  double lastProcessingUs;
+  double meanProcessingUs;
+  double maxProcessingUs;
+  double meanIntervalUs;
+  double maxIntervalUs;
+  double dspLoad;            // dernier bloc : temps de traitement / période
+  double meanDspLoad;
+  double peakDspLoad;
+};
+
+// Chronométrage de chaque callback avec une horloge monotone
+// record() est appelé par le callback une fois par bloc : quelques opérations
+// atomiques relâchées, pas d'allocation ni de verrou. Le temps de traitement et
+// l'intervalle entre callbacks alimentent chacun un histogramme ; la charge DSP
+// est le rapport entre le temps de traitement et la période du buffer.
+class CallbackStats {
+public:
+  // À l'arrêt
+  void configure(double sampleRate, size_t blockSize);
+  void reset();
+
+  // Côté callback : début et fin du traitement du bloc, en nanosecondes monotones
+  void record(int64_t startNs, int64_t endNs);
+
+  // Côté lecteur
+  CallbackStatsSnapshot snapshot() const;
+  const LatencyHistogram& processingHistogram() const { return processing; }
+  const LatencyHistogram& intervalHistogram() const { return interval; }
+
+private:
+  // Lu par snapshot() pendant qu'un démarrage le reconfigure
+  std::atomic<int64_t> periodNs{0};
+
+  // État propre au callback
+  int64_t lastStartNs = 0;
+
+  std::atomic<uint64_t> callbacks{0};
+  std::atomic<uint64_t> overruns{0};
+  std::atomic<uint64_t> lateCallbacks{0};
+  std::atomic<uint64_t> intervals{0};
+  std::atomic<uint64_t> processingSumNs{0};
+  std::atomic<uint64_t> intervalSumNs{0};
+  std::atomic<int64_t> lastProcessingNs{0};
+  std::atomic<int64_t> maxProcessingNs{0};
+  std::atomic<int64_t> maxIntervalNs{0};
+
+  LatencyHistogram processing;
+  LatencyHistogram interval;
+};
+
+#endif
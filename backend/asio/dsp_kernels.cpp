@@ -0,0 +1,448 @@
+#include "dsp_kernels.h"
+
+#include <atomic>
+#include <cmath>
+
+#include "simd_support.h"
+
+namespace {
+
+// --- Scalaire (repli portable) ---
+
+void scaleScalar(const float* in, float* out, size_t count, float gain) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = in[i] * gain;
+  }
+}
+
+void mulAddScalar(const float* in, float* out, size_t count, float gain) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] += in[i] * gain;
+  }
+}
+
+void linearRampScalar(const float* in, float* out, size_t count, float start, float step) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = in[i] * (start + step * static_cast<float>(i));
+  }
+}
+
+void expRampScalar(const float* in, float* out, size_t count, float target, float distance, float coef) {
+  for (size_t i = 0; i < count; i++) {
+    distance *= coef;
+    out[i] = in[i] * (target + distance);
+  }
+}
+
+void complexMulAddScalar(const float* xRe, const float* xIm, const float* hRe, const float* hIm,
+                         float* yRe, float* yIm, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    yRe[i] += xRe[i] * hRe[i] - xIm[i] * hIm[i];
+    yIm[i] += xRe[i] * hIm[i] + xIm[i] * hRe[i];
+  }
+}
+
+void sumSquaresPeakScalar(const float* in, size_t count, float* sumSquares, float* peak) {
+  float sum = 0.0f;
+  float maxAbs = 0.0f;
+  for (size_t i = 0; i < count; i++) {
+    sum += in[i] * in[i];
+    maxAbs = std::fmax(maxAbs, std::fabs(in[i]));
+  }
+  *sumSquares = sum;
+  *peak = maxAbs;
+}
+
+#if DSP_X86
+
+// Écarts initiaux de chaque voie pour la rampe exponentielle : distance * coef^(k+1)
+// (multipliés ensuite par coef^lanes à chaque vecteur)
+void expRampLanes(float distance, float coef, size_t lanes, float* laneDistance, float* laneCoef) {
+  float d = distance;
+  for (size_t k = 0; k < lanes; k++) {
+    d *= coef;
+    laneDistance[k] = d;
+  }
+  float c = 1.0f;
+  for (size_t k = 0; k < lanes; k++) {
+    c *= coef;
+  }
+  *laneCoef = c;
+}
+
+// --- SSE2 : 4 registres de 4 floats par bloc de 16 ---
+
+DSP_TARGET("sse2")
+void scaleSse2(const float* in, float* out, size_t count, float gain) {
+  const __m128 g = _mm_set1_ps(gain);
+  for (size_t i = 0; i < count; i += 16) {
+    _mm_store_ps(out + i, _mm_mul_ps(_mm_load_ps(in + i), g));
+    _mm_store_ps(out + i + 4, _mm_mul_ps(_mm_load_ps(in + i + 4), g));
+    _mm_store_ps(out + i + 8, _mm_mul_ps(_mm_load_ps(in + i + 8), g));
+    _mm_store_ps(out + i + 12, _mm_mul_ps(_mm_load_ps(in + i + 12), g));
+  }
+}
+
+DSP_TARGET("sse2")
+void mulAddSse2(const float* in, float* out, size_t count, float gain) {
+  const __m128 g = _mm_set1_ps(gain);
+  for (size_t i = 0; i < count; i += 16) {
+    for (size_t j = 0; j < 16; j += 4) {
+      const __m128 acc = _mm_load_ps(out + i + j);
+      _mm_store_ps(out + i + j, _mm_add_ps(acc, _mm_mul_ps(_mm_load_ps(in + i + j), g)));
+    }
+  }
+}
+
+DSP_TARGET("sse2")
+void linearRampSse2(const float* in, float* out, size_t count, float start, float step) {
+  const __m128 s0 = _mm_set1_ps(start);
+  const __m128 st = _mm_set1_ps(step);
+  const __m128 four = _mm_set1_ps(4.0f);
+  __m128 index = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+  for (size_t i = 0; i < count; i += 16) {
+    for (size_t j = 0; j < 16; j += 4) {
+      const __m128 g = _mm_add_ps(s0, _mm_mul_ps(st, index));
+      _mm_store_ps(out + i + j, _mm_mul_ps(_mm_load_ps(in + i + j), g));
+      index = _mm_add_ps(index, four);
+    }
+  }
+}
+
+DSP_TARGET("sse2")
+void expRampSse2(const float* in, float* out, size_t count, float target, float distance, float coef) {
+  alignas(16) float lanes[4];
+  float laneCoef;
+  expRampLanes(distance, coef, 4, lanes, &laneCoef);
+  const __m128 t = _mm_set1_ps(target);
+  const __m128 c = _mm_set1_ps(laneCoef);
+  __m128 d = _mm_load_ps(lanes);
+  for (size_t i = 0; i < count; i += 16) {
+    for (size_t j = 0; j < 16; j += 4) {
+      _mm_store_ps(out + i + j, _mm_mul_ps(_mm_load_ps(in + i + j), _mm_add_ps(t, d)));
+      d = _mm_mul_ps(d, c);
+    }
+  }
+}
+
+DSP_TARGET("sse2")
+void complexMulAddSse2(const float* xRe, const float* xIm, const float* hRe, const float* hIm,
+                       float* yRe, float* yIm, size_t count) {
+  for (size_t i = 0; i < count; i += 4) {
+    const __m128 xr = _mm_load_ps(xRe + i);
+    const __m128 xi = _mm_load_ps(xIm + i);
+    const __m128 hr = _mm_load_ps(hRe + i);
+    const __m128 hi = _mm_load_ps(hIm + i);
+    _mm_store_ps(yRe + i, _mm_add_ps(_mm_load_ps(yRe + i), _mm_sub_ps(_mm_mul_ps(xr, hr), _mm_mul_ps(xi, hi))));
+    _mm_store_ps(yIm + i, _mm_add_ps(_mm_load_ps(yIm + i), _mm_add_ps(_mm_mul_ps(xr, hi), _mm_mul_ps(xi, hr))));
+  }
+}
+
+DSP_TARGET("sse2")
+void sumSquaresPeakSse2(const float* in, size_t count, float* sumSquares, float* peak) {
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  __m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+  __m128 max0 = _mm_setzero_ps(), max1 = _mm_setzero_ps();
+  for (size_t i = 0; i < count; i += 16) {
+    const __m128 a = _mm_load_ps(in + i);
+    const __m128 b = _mm_load_ps(in + i + 4);
+    const __m128 c = _mm_load_ps(in + i + 8);
+    const __m128 d = _mm_load_ps(in + i + 12);
+    sum0 = _mm_add_ps(sum0, _mm_add_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b)));
+    sum1 = _mm_add_ps(sum1, _mm_add_ps(_mm_mul_ps(c, c), _mm_mul_ps(d, d)));
+    max0 = _mm_max_ps(max0, _mm_max_ps(_mm_and_ps(a, absMask), _mm_and_ps(b, absMask)));
+    max1 = _mm_max_ps(max1, _mm_max_ps(_mm_and_ps(c, absMask), _mm_and_ps(d, absMask)));
+  }
+  alignas(16) float sums[4];
+  alignas(16) float maxes[4];
+  _mm_store_ps(sums, _mm_add_ps(sum0, sum1));
+  _mm_store_ps(maxes, _mm_max_ps(max0, max1));
+  *sumSquares = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+  *peak = std::fmax(std::fmax(maxes[0], maxes[1]), std::fmax(maxes[2], maxes[3]));
+}
+
+// --- AVX2 : 2 registres de 8 floats par bloc de 16 ---
+
+DSP_TARGET("avx2")
+void scaleAvx2(const float* in, float* out, size_t count, float gain) {
+  const __m256 g = _mm256_set1_ps(gain);
+  for (size_t i = 0; i < count; i += 16) {
+    _mm256_store_ps(out + i, _mm256_mul_ps(_mm256_load_ps(in + i), g));
+    _mm256_store_ps(out + i + 8, _mm256_mul_ps(_mm256_load_ps(in + i + 8), g));
+  }
+}
+
+DSP_TARGET("avx2")
+void mulAddAvx2(const float* in, float* out, size_t count, float gain) {
+  const __m256 g = _mm256_set1_ps(gain);
+  for (size_t i = 0; i < count; i += 16) {
+    _mm256_store_ps(out + i, _mm256_add_ps(_mm256_load_ps(out + i), _mm256_mul_ps(_mm256_load_ps(in + i), g)));
+    _mm256_store_ps(out + i + 8, _mm256_add_ps(_mm256_load_ps(out + i + 8), _mm256_mul_ps(_mm256_load_ps(in + i + 8), g)));
+  }
+}
+
+DSP_TARGET("avx2")
+void linearRampAvx2(const float* in, float* out, size_t count, float start, float step) {
+  const __m256 s0 = _mm256_set1_ps(start);
+  const __m256 st = _mm256_set1_ps(step);
+  const __m256 eight = _mm256_set1_ps(8.0f);
+  __m256 index = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+  for (size_t i = 0; i < count; i += 16) {
+    const __m256 g0 = _mm256_add_ps(s0, _mm256_mul_ps(st, index));
+    const __m256 g1 = _mm256_add_ps(s0, _mm256_mul_ps(st, _mm256_add_ps(index, eight)));
+    _mm256_store_ps(out + i, _mm256_mul_ps(_mm256_load_ps(in + i), g0));
+    _mm256_store_ps(out + i + 8, _mm256_mul_ps(_mm256_load_ps(in + i + 8), g1));
+    index = _mm256_add_ps(index, _mm256_add_ps(eight, eight));
+  }
+}
+
+DSP_TARGET("avx2")
+void expRampAvx2(const float* in, float* out, size_t count, float target, float distance, float coef) {
+  alignas(32) float lanes[8];
+  float laneCoef;
+  expRampLanes(distance, coef, 8, lanes, &laneCoef);
+  const __m256 t = _mm256_set1_ps(target);
+  const __m256 c = _mm256_set1_ps(laneCoef);
+  __m256 d = _mm256_load_ps(lanes);
+  for (size_t i = 0; i < count; i += 16) {
+    _mm256_store_ps(out + i, _mm256_mul_ps(_mm256_load_ps(in + i), _mm256_add_ps(t, d)));
+    d = _mm256_mul_ps(d, c);
+    _mm256_store_ps(out + i + 8, _mm256_mul_ps(_mm256_load_ps(in + i + 8), _mm256_add_ps(t, d)));
+    d = _mm256_mul_ps(d, c);
+  }
+}
+
+DSP_TARGET("avx2")
+void complexMulAddAvx2(const float* xRe, const float* xIm, const float* hRe, const float* hIm,
+                       float* yRe, float* yIm, size_t count) {
+  for (size_t i = 0; i < count; i += 8) {
+    const __m256 xr = _mm256_load_ps(xRe + i);
+    const __m256 xi = _mm256_load_ps(xIm + i);
+    const __m256 hr = _mm256_load_ps(hRe + i);
+    const __m256 hi = _mm256_load_ps(hIm + i);
+    _mm256_store_ps(yRe + i, _mm256_add_ps(_mm256_load_ps(yRe + i),
+                                           _mm256_sub_ps(_mm256_mul_ps(xr, hr), _mm256_mul_ps(xi, hi))));
+    _mm256_store_ps(yIm + i, _mm256_add_ps(_mm256_load_ps(yIm + i),
+                                           _mm256_add_ps(_mm256_mul_ps(xr, hi), _mm256_mul_ps(xi, hr))));
+  }
+}
+
+DSP_TARGET("avx2")
+void sumSquaresPeakAvx2(const float* in, size_t count, float* sumSquares, float* peak) {
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  __m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+  __m256 max0 = _mm256_setzero_ps(), max1 = _mm256_setzero_ps();
+  for (size_t i = 0; i < count; i += 16) {
+    const __m256 a = _mm256_load_ps(in + i);
+    const __m256 b = _mm256_load_ps(in + i + 8);
+    sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(a, a));
+    sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(b, b));
+    max0 = _mm256_max_ps(max0, _mm256_and_ps(a, absMask));
+    max1 = _mm256_max_ps(max1, _mm256_and_ps(b, absMask));
+  }
+  alignas(32) float sums[8];
+  alignas(32) float maxes[8];
+  _mm256_store_ps(sums, _mm256_add_ps(sum0, sum1));
+  _mm256_store_ps(maxes, _mm256_max_ps(max0, max1));
+  float sum = 0.0f;
+  float maxAbs = 0.0f;
+  for (int i = 0; i < 8; i++) {
+    sum += sums[i];
+    maxAbs = std::fmax(maxAbs, maxes[i]);
+  }
+  *sumSquares = sum;
+  *peak = maxAbs;
+}
+
+// --- AVX-512 : 1 registre de 16 floats par bloc ---
+
+DSP_TARGET("avx512f")
+void scaleAvx512(const float* in, float* out, size_t count, float gain) {
+  const __m512 g = _mm512_set1_ps(gain);
+  for (size_t i = 0; i < count; i += 16) {
+    _mm512_store_ps(out + i, _mm512_mul_ps(_mm512_load_ps(in + i), g));
+  }
+}
+
+DSP_TARGET("avx512f")
+void mulAddAvx512(const float* in, float* out, size_t count, float gain) {
+  const __m512 g = _mm512_set1_ps(gain);
+  for (size_t i = 0; i < count; i += 16) {
+    _mm512_store_ps(out + i, _mm512_fmadd_ps(_mm512_load_ps(in + i), g, _mm512_load_ps(out + i)));
+  }
+}
+
+DSP_TARGET("avx512f")
+void linearRampAvx512(const float* in, float* out, size_t count, float start, float step) {
+  const __m512 s0 = _mm512_set1_ps(start);
+  const __m512 st = _mm512_set1_ps(step);
+  const __m512 sixteen = _mm512_set1_ps(16.0f);
+  __m512 index = _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f,
+                                8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f);
+  for (size_t i = 0; i < count; i += 16) {
+    const __m512 g = _mm512_fmadd_ps(st, index, s0);
+    _mm512_store_ps(out + i, _mm512_mul_ps(_mm512_load_ps(in + i), g));
+    index = _mm512_add_ps(index, sixteen);
+  }
+}
+
+DSP_TARGET("avx512f")
+void expRampAvx512(const float* in, float* out, size_t count, float target, float distance, float coef) {
+  alignas(64) float lanes[16];
+  float laneCoef;
+  expRampLanes(distance, coef, 16, lanes, &laneCoef);
+  const __m512 t = _mm512_set1_ps(target);
+  const __m512 c = _mm512_set1_ps(laneCoef);
+  __m512 d = _mm512_load_ps(lanes);
+  for (size_t i = 0; i < count; i += 16) {
+    _mm512_store_ps(out + i, _mm512_mul_ps(_mm512_load_ps(in + i), _mm512_add_ps(t, d)));
+    d = _mm512_mul_ps(d, c);
+  }
+}
+
+DSP_TARGET("avx512f")
+void complexMulAddAvx512(const float* xRe, const float* xIm, const float* hRe, const float* hIm,
+                         float* yRe, float* yIm, size_t count) {
+  for (size_t i = 0; i < count; i += 16) {
+    const __m512 xr = _mm512_load_ps(xRe + i);
+    const __m512 xi = _mm512_load_ps(xIm + i);
+    const __m512 hr = _mm512_load_ps(hRe + i);
+    const __m512 hi = _mm512_load_ps(hIm + i);
+    _mm512_store_ps(yRe + i, _mm512_fnmadd_ps(xi, hi, _mm512_fmadd_ps(xr, hr, _mm512_load_ps(yRe + i))));
+    _mm512_store_ps(yIm + i, _mm512_fmadd_ps(xi, hr, _mm512_fmadd_ps(xr, hi, _mm512_load_ps(yIm + i))));
+  }
+}
+
+DSP_TARGET("avx512f")
+void sumSquaresPeakAvx512(const float* in, size_t count, float* sumSquares, float* peak) {
+  const __m512i absMask = _mm512_set1_epi32(0x7fffffff);
+  __m512 sum = _mm512_setzero_ps();
+  __m512 maxAbs = _mm512_setzero_ps();
+  for (size_t i = 0; i < count; i += 16) {
+    const __m512 a = _mm512_load_ps(in + i);
+    const __m512 absA = _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(a), absMask));
+    sum = _mm512_fmadd_ps(a, a, sum);
+    maxAbs = _mm512_mask_max_ps(maxAbs, 0xffff, maxAbs, absA);
+  }
+  alignas(64) float sums[16];
+  alignas(64) float maxes[16];
+  _mm512_store_ps(sums, sum);
+  _mm512_store_ps(maxes, maxAbs);
+  float total = 0.0f;
+  float maxValue = 0.0f;
+  for (int i = 0; i < 16; i++) {
+    total += sums[i];
+    maxValue = std::fmax(maxValue, maxes[i]);
+  }
+  *sumSquares = total;
+  *peak = maxValue;
+}
+
+// --- Détection CPUID ---
+
+void cpuid(int leaf, int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuidex(info, leaf, subleaf);
+  for (int i = 0; i < 4; i++) {
+    regs[i] = static_cast<unsigned int>(info[i]);
+  }
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+unsigned long long readXcr0() {
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  unsigned int eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+#endif // DSP_X86
+
+const DspKernels kScalarKernels = {
+  SimdLevel::Scalar, "scalar",
+  scaleScalar, mulAddScalar, linearRampScalar, expRampScalar, complexMulAddScalar, sumSquaresPeakScalar
+};
+#if DSP_X86
+const DspKernels kSse2Kernels = {
+  SimdLevel::SSE2, "sse2",
+  scaleSse2, mulAddSse2, linearRampSse2, expRampSse2, complexMulAddSse2, sumSquaresPeakSse2
+};
+const DspKernels kAvx2Kernels = {
+  SimdLevel::AVX2, "avx2",
+  scaleAvx2, mulAddAvx2, linearRampAvx2, expRampAvx2, complexMulAddAvx2, sumSquaresPeakAvx2
+};
+const DspKernels kAvx512Kernels = {
+  SimdLevel::AVX512, "avx512",
+  scaleAvx512, mulAddAvx512, linearRampAvx512, expRampAvx512, complexMulAddAvx512, sumSquaresPeakAvx512
+};
+#endif
+
+std::atomic<const DspKernels*> activeKernels{&kScalarKernels};
+
+} // namespace
+
+SimdLevel detectSimdLevel() {
+#if DSP_X86
+  unsigned int regs[4];
+  cpuid(0, 0, regs);
+  const unsigned int maxLeaf = regs[0];
+
+  cpuid(1, 0, regs);
+  const bool sse2 = (regs[3] & (1u << 26)) != 0;
+  const bool osxsave = (regs[2] & (1u << 27)) != 0;
+  const bool avx = (regs[2] & (1u << 28)) != 0;
+  if (!sse2) {
+    return SimdLevel::Scalar;
+  }
+
+  // Le système doit sauvegarder les registres étendus (XCR0) pour AVX et AVX-512
+  const unsigned long long xcr0 = osxsave ? readXcr0() : 0;
+  const bool osAvx = (xcr0 & 0x6) == 0x6;
+  const bool osAvx512 = (xcr0 & 0xe6) == 0xe6;
+
+  if (maxLeaf >= 7 && avx && osAvx) {
+    cpuid(7, 0, regs);
+    const bool avx2 = (regs[1] & (1u << 5)) != 0;
+    const bool avx512f = (regs[1] & (1u << 16)) != 0;
+    if (avx512f && osAvx512) {
+      return SimdLevel::AVX512;
+    }
+    if (avx2) {
+      return SimdLevel::AVX2;
+    }
+  }
+  return SimdLevel::SSE2;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+const DspKernels& dspKernelsFor(SimdLevel level) {
+#if DSP_X86
+  switch (level) {
+    case SimdLevel::AVX512: return kAvx512Kernels;
+    case SimdLevel::AVX2: return kAvx2Kernels;
+    case SimdLevel::SSE2: return kSse2Kernels;
+    default: break;
+  }
+#else
+  (void)level;
+#endif
+  return kScalarKernels;
+}
+
+const DspKernels& selectDspKernels() {
+  const DspKernels& kernels = dspKernelsFor(detectSimdLevel());
+  activeKernels.store(&kernels, std::memory_order_release);
+  return kernels;
+}
+
+const DspKernels& dspKernels() {
+  return *activeKernels.load(std::memory_order_acquire);
+}
@@ -0,0 +1,56 @@
+#ifndef __dsp_kernels__
+#define __dsp_kernels__
+
+#include <cstddef>
+
+#include "aligned_buffer.h"
+
+// Bibliothèque de noyaux DSP avec sélection à l'exécution (CPUID)
+// Tous les noyaux exigent des pointeurs alignés sur kBufferAlignment et une
+// longueur multiple de kKernelBlock (voir AlignedBuffer) : aucun prologue ni
+// épilogue scalaire n'est nécessaire.
+
+enum class SimdLevel {
+  Scalar = 0,
+  SSE2,
+  AVX2,
+  AVX512
+};
+
+struct DspKernels {
+  SimdLevel level;
+  const char* name;
+
+  // out[i] = in[i] * gain
+  void (*scale)(const float* in, float* out, size_t count, float gain);
+
+  // Accumulation : out[i] += in[i] * gain
+  void (*mulAdd)(const float* in, float* out, size_t count, float gain);
+
+  // Rampe linéaire : out[i] = in[i] * (start + step * i)
+  void (*linearRamp)(const float* in, float* out, size_t count, float start, float step);
+
+  // Rampe exponentielle (filtre à un pôle) : out[i] = in[i] * (target + distance * coef^(i+1))
+  void (*expRamp)(const float* in, float* out, size_t count, float target, float distance, float coef);
+
+  // Produit complexe accumulé (parties séparées) : y += x * h
+  void (*complexMulAdd)(const float* xRe, const float* xIm, const float* hRe, const float* hIm,
+                        float* yRe, float* yIm, size_t count);
+
+  // Somme des carrés et crête absolue du bloc
+  void (*sumSquaresPeak)(const float* in, size_t count, float* sumSquares, float* peak);
+};
+
+// Meilleur niveau SIMD supporté par le processeur et le système
+SimdLevel detectSimdLevel();
+
+// Table de noyaux pour un niveau donné (repli sur le meilleur niveau compilé inférieur)
+const DspKernels& dspKernelsFor(SimdLevel level);
+
+// Détecte le processeur et installe la table correspondante (appelé par Initialize)
+const DspKernels& selectDspKernels();
+
+// Table active ; scalaire tant que selectDspKernels() n'a pas été appelé
+const DspKernels& dspKernels();
+
+#endif
@@ -0,0 +1,836 @@
+#include "fast_convert_samples.h"
+
+#include <cstring>
+
+#include "simd_support.h"
+
+namespace {
+
+// --- Portage direct du SDK (branche ASIO_LITTLE_ENDIAN) : référence et queues ---
+// Les routines en place reçoivent l'entrée et la sortie séparément pour pouvoir
+// traiter une sous-plage ; appelées avec in == out elles font exactement ce que fait le SDK.
+
+void mono8Scalar(const uint8_t* s, uint8_t* d, long frames, bool unsignedOut) {
+  while (--frames >= 0) {
+    uint8_t a = s[3];
+    if (unsignedOut) {
+      a = static_cast<uint8_t>(a - 0x80u);
+    }
+    s += 4;
+    *d++ = a;
+  }
+}
+
+void mono16Scalar(const uint8_t* s, uint8_t* d, long frames, bool bigEndian) {
+  while (--frames >= 0) {
+    *d++ = bigEndian ? s[3] : s[2];
+    *d++ = bigEndian ? s[2] : s[3];
+    s += 4;
+  }
+}
+
+void mono24Scalar(const uint8_t* s, uint8_t* d, long frames, bool bigEndian) {
+  while (--frames >= 0) {
+    *d++ = bigEndian ? s[3] : s[1];
+    *d++ = s[2];
+    *d++ = bigEndian ? s[1] : s[3];
+    s += 4;
+  }
+}
+
+void stereo8InterleavedScalar(const uint8_t* l, const uint8_t* r, uint8_t* d, long frames, bool unsignedOut) {
+  while (--frames >= 0) {
+    uint8_t a = l[3];
+    uint8_t b = r[3];
+    if (unsignedOut) {
+      a = static_cast<uint8_t>(a - 0x80u);
+      b = static_cast<uint8_t>(b - 0x80u);
+    }
+    l += 4;
+    r += 4;
+    *d++ = a;
+    *d++ = b;
+  }
+}
+
+void stereo16InterleavedScalar(const uint8_t* l, const uint8_t* r, uint8_t* d, long frames, bool bigEndian) {
+  while (--frames >= 0) {
+    *d++ = bigEndian ? l[3] : l[2];
+    *d++ = bigEndian ? l[2] : l[3];
+    *d++ = bigEndian ? r[3] : r[2];
+    *d++ = bigEndian ? r[2] : r[3];
+    l += 4;
+    r += 4;
+  }
+}
+
+void stereo24InterleavedScalar(const uint8_t* l, const uint8_t* r, uint8_t* d, long frames, bool bigEndian) {
+  while (--frames >= 0) {
+    *d++ = bigEndian ? l[3] : l[1];
+    *d++ = l[2];
+    *d++ = bigEndian ? l[1] : l[3];
+    *d++ = bigEndian ? r[3] : r[1];
+    *d++ = r[2];
+    *d++ = bigEndian ? r[1] : r[3];
+    l += 4;
+    r += 4;
+  }
+}
+
+// Mot de 16 bits de poids fort (high) ou faible de chaque entier 32 bits
+void int32HalfTo16Scalar(const uint8_t* in, uint8_t* out, long frames, bool high) {
+  const size_t offset = high ? 2 : 0;
+  while (--frames >= 0) {
+    out[0] = in[offset];
+    out[1] = in[offset + 1];
+    in += 4;
+    out += 2;
+  }
+}
+
+void int32ShiftedTo16Scalar(const int32_t* in, int16_t* out, long frames, long shift) {
+  while (--frames >= 0) {
+    *out++ = static_cast<int16_t>(*in++ >> shift);
+  }
+}
+
+// 24 bits petit-boutiste -> 16 bits : octets 1 et 2 (int24msbto16inPlace, int24to16inPlace)
+void int24To16Scalar(const uint8_t* in, uint8_t* out, long frames) {
+  while (--frames >= 0) {
+    out[0] = in[1];
+    out[1] = in[2];
+    in += 3;
+    out += 2;
+  }
+}
+
+void reverseEndianScalar(uint8_t* a, long byteWidth, long frames) {
+  uint8_t c;
+  if (byteWidth == 2) {
+    while (--frames >= 0) {
+      c = a[0];
+      a[0] = a[1];
+      a[1] = c;
+      a += 2;
+    }
+  } else if (byteWidth == 3) {
+    while (--frames >= 0) {
+      c = a[0];
+      a[0] = a[2];
+      a[2] = c;
+      a += 3;
+    }
+  } else if (byteWidth == 4) {
+    while (--frames >= 0) {
+      c = a[0];
+      a[0] = a[3];
+      a[3] = c;
+      c = a[1];
+      a[1] = a[2];
+      a[2] = c;
+      a += 4;
+    }
+  }
+}
+
+// shift32 après l'inversion éventuelle : décalage à gauche puis 2, 3 ou 4 octets de poids fort
+void shift32Scalar(const uint8_t* in, uint8_t* out, long shiftAmount, long targetByteWidth, long frames) {
+  while (--frames >= 0) {
+    uint32_t a;
+    std::memcpy(&a, in, sizeof(a));
+    a <<= shiftAmount;
+    uint8_t bytes[4];
+    std::memcpy(bytes, &a, sizeof(a));
+    std::memcpy(out, bytes + 4 - targetByteWidth, static_cast<size_t>(targetByteWidth));
+    in += 4;
+    out += targetByteWidth;
+  }
+}
+
+// Expansions en place, parcourues depuis la fin comme dans le SDK
+void int16to24Scalar(const uint8_t* in, uint8_t* out, long frames) {
+  in += frames * 2;
+  out += frames * 3;
+  while (--frames >= 0) {
+    out -= 3;
+    in -= 2;
+    out[2] = in[1];
+    out[1] = in[0];
+    out[0] = 0;
+  }
+}
+
+void int24to32Scalar(const uint8_t* in, uint8_t* out, long frames) {
+  in += frames * 3;
+  out += frames * 4;
+  while (--frames >= 0) {
+    const uint8_t b2 = in[-1];
+    const uint8_t b1 = in[-2];
+    const uint8_t b0 = in[-3];
+    out -= 4;
+    out[3] = b2;
+    out[2] = b1;
+    out[1] = b0;
+    out[0] = 0;
+    in -= 3;
+  }
+}
+
+void int16to32Scalar(const uint8_t* in, uint8_t* out, long frames) {
+  in += frames * 2;
+  out += frames * 4;
+  while (--frames >= 0) {
+    in -= 2;
+    const uint8_t b0 = in[0];
+    const uint8_t b1 = in[1];
+    out -= 4;
+    out[3] = b1;
+    out[2] = b0;
+    out[1] = 0;
+    out[0] = 0;
+  }
+}
+
+// Conversion double -> entier 32 bits par troncature, valeur indéfinie x86 (INT32_MIN)
+// hors limites ou pour NaN : ce que produit le SDK compilé pour x86, et cvttpd2dq
+inline int32_t truncateToInt32(double value) {
+  if (!(value > -2147483649.0 && value < 2147483648.0)) {
+    return INT32_MIN;
+  }
+  return static_cast<int32_t>(value);
+}
+
+const double kScaler16 = static_cast<double>(0x7fffL) + .49999;
+const double kScaler24 = static_cast<double>(0x7fffffL) + .49999;
+const double kScaler32 = static_cast<double>(0x7fffffffL) + .49999;
+
+void float32toInt16Scalar(const float* in, uint8_t* out, long frames) {
+  while (--frames >= 0) {
+    const int16_t value = static_cast<int16_t>(truncateToInt32(static_cast<double>(*in++) * kScaler16));
+    std::memcpy(out, &value, sizeof(value));
+    out += 2;
+  }
+}
+
+// Le SDK écrit les octets 3, 2, 1 du résultat (signe, poids fort, poids moyen) : conservé tel quel
+void float32toInt24Scalar(const float* in, uint8_t* out, long frames) {
+  while (--frames >= 0) {
+    const int32_t a = truncateToInt32(static_cast<double>(*in++) * kScaler24);
+    uint8_t aa[4];
+    std::memcpy(aa, &a, sizeof(a));
+    *out++ = aa[3];
+    *out++ = aa[2];
+    *out++ = aa[1];
+  }
+}
+
+void float32toInt32Scalar(const float* in, uint8_t* out, long frames) {
+  while (--frames >= 0) {
+    const int32_t value = truncateToInt32(static_cast<double>(*in++) * kScaler32);
+    std::memcpy(out, &value, sizeof(value));
+    out += 4;
+  }
+}
+
+#if DSP_X86
+
+// --- SSE2 : décalages arithmétiques puis pack saturé (valeurs déjà dans l'intervalle, donc exact) ---
+
+DSP_TARGET("sse2")
+inline __m128i loadWords(const uint8_t* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+DSP_TARGET("sse2")
+inline void storeWords(uint8_t* p, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+// Octet de poids fort de 16 entiers 32 bits -> 16 octets
+DSP_TARGET("sse2")
+inline __m128i highBytes16(const uint8_t* s) {
+  const __m128i a = _mm_srai_epi32(loadWords(s), 24);
+  const __m128i b = _mm_srai_epi32(loadWords(s + 16), 24);
+  const __m128i c = _mm_srai_epi32(loadWords(s + 32), 24);
+  const __m128i d = _mm_srai_epi32(loadWords(s + 48), 24);
+  return _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+}
+
+// Mot de poids fort de 8 entiers 32 bits -> 8 mots
+DSP_TARGET("sse2")
+inline __m128i highWords8(const uint8_t* s) {
+  return _mm_packs_epi32(_mm_srai_epi32(loadWords(s), 16), _mm_srai_epi32(loadWords(s + 16), 16));
+}
+
+DSP_TARGET("sse2")
+long mono8Sse2(const uint8_t* s, uint8_t* d, long frames, bool unsignedOut) {
+  const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+  long i = 0;
+  for (; i + 16 <= frames; i += 16) {
+    __m128i v = highBytes16(s + 4 * i);
+    if (unsignedOut) {
+      v = _mm_xor_si128(v, bias); // a - 0x80 modulo 256
+    }
+    storeWords(d + i, v);
+  }
+  return i;
+}
+
+DSP_TARGET("sse2")
+long mono16Sse2(const uint8_t* s, uint8_t* d, long frames, bool bigEndian) {
+  long i = 0;
+  for (; i + 8 <= frames; i += 8) {
+    __m128i v = highWords8(s + 4 * i);
+    if (bigEndian) {
+      v = byteSwap16(v);
+    }
+    storeWords(d + 2 * i, v);
+  }
+  return i;
+}
+
+DSP_TARGET("sse2")
+long stereo8InterleavedSse2(const uint8_t* l, const uint8_t* r, uint8_t* d, long frames, bool unsignedOut) {
+  const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+  long i = 0;
+  for (; i + 16 <= frames; i += 16) {
+    __m128i a = highBytes16(l + 4 * i);
+    __m128i b = highBytes16(r + 4 * i);
+    if (unsignedOut) {
+      a = _mm_xor_si128(a, bias);
+      b = _mm_xor_si128(b, bias);
+    }
+    storeWords(d + 2 * i, _mm_unpacklo_epi8(a, b));
+    storeWords(d + 2 * i + 16, _mm_unpackhi_epi8(a, b));
+  }
+  return i;
+}
+
+DSP_TARGET("sse2")
+long stereo16InterleavedSse2(const uint8_t* l, const uint8_t* r, uint8_t* d, long frames, bool bigEndian) {
+  long i = 0;
+  for (; i + 8 <= frames; i += 8) {
+    const __m128i a = highWords8(l + 4 * i);
+    const __m128i b = highWords8(r + 4 * i);
+    __m128i lo = _mm_unpacklo_epi16(a, b);
+    __m128i hi = _mm_unpackhi_epi16(a, b);
+    if (bigEndian) {
+      lo = byteSwap16(lo);
+      hi = byteSwap16(hi);
+    }
+    storeWords(d + 4 * i, lo);
+    storeWords(d + 4 * i + 16, hi);
+  }
+  return i;
+}
+
+// En place 4 -> 2 octets : chaque itération charge 32 octets avant d'en écrire 16 plus bas
+DSP_TARGET("sse2")
+long int32HalfTo16Sse2(const uint8_t* in, uint8_t* out, long frames, bool high) {
+  long i = 0;
+  for (; i + 8 <= frames; i += 8) {
+    __m128i a = loadWords(in + 4 * i);
+    __m128i b = loadWords(in + 4 * i + 16);
+    if (!high) {
+      a = _mm_slli_epi32(a, 16);
+      b = _mm_slli_epi32(b, 16);
+    }
+    storeWords(out + 2 * i, _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16)));
+  }
+  return i;
+}
+
+// (short)(x >> shift) : troncature à 16 bits, pas de saturation
+DSP_TARGET("sse2")
+long int32ShiftedTo16Sse2(const uint8_t* in, uint8_t* out, long frames, long shift) {
+  const __m128i count = _mm_cvtsi32_si128(static_cast<int>(shift));
+  long i = 0;
+  for (; i + 8 <= frames; i += 8) {
+    const __m128i a = _mm_sra_epi32(loadWords(in + 4 * i), count);
+    const __m128i b = _mm_sra_epi32(loadWords(in + 4 * i + 16), count);
+    storeWords(out + 2 * i, _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                                            _mm_srai_epi32(_mm_slli_epi32(b, 16), 16)));
+  }
+  return i;
+}
+
+DSP_TARGET("sse2")
+long reverseEndianSse2(uint8_t* a, long byteWidth, long frames) {
+  const long perVector = 16 / byteWidth;
+  long i = 0;
+  for (; i + perVector <= frames; i += perVector) {
+    const __m128i v = loadWords(a + byteWidth * i);
+    storeWords(a + byteWidth * i, byteWidth == 2 ? byteSwap16(v) : byteSwap32(v));
+  }
+  return i;
+}
+
+// shift32 en largeur 2 ou 4 (la largeur 3 demande pshufb)
+DSP_TARGET("sse2")
+long shift32Sse2(const uint8_t* in, uint8_t* out, long shiftAmount, long targetByteWidth, long frames) {
+  const __m128i count = _mm_cvtsi32_si128(static_cast<int>(shiftAmount));
+  long i = 0;
+  if (targetByteWidth == 2) {
+    for (; i + 8 <= frames; i += 8) {
+      const __m128i a = _mm_sll_epi32(loadWords(in + 4 * i), count);
+      const __m128i b = _mm_sll_epi32(loadWords(in + 4 * i + 16), count);
+      storeWords(out + 2 * i, _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16)));
+    }
+  } else if (targetByteWidth == 4) {
+    for (; i + 4 <= frames; i += 4) {
+      storeWords(out + 4 * i, _mm_sll_epi32(loadWords(in + 4 * i), count));
+    }
+  }
+  return i;
+}
+
+// Expansion en place 2 -> 4 octets, blocs parcourus depuis la fin
+DSP_TARGET("sse2")
+void int16to32Sse2(uint8_t* buffer, long blocks) {
+  const __m128i zero = _mm_setzero_si128();
+  for (long i = (blocks - 1) * 8; i >= 0; i -= 8) {
+    const __m128i v = loadWords(buffer + 2 * i);
+    storeWords(buffer + 4 * i + 16, _mm_unpackhi_epi16(zero, v));
+    storeWords(buffer + 4 * i, _mm_unpacklo_epi16(zero, v));
+  }
+}
+
+// Troncature double -> int32 de 4 floats (cvttpd2dq : INT32_MIN hors limites, comme le SDK sur x86)
+DSP_TARGET("sse2")
+inline __m128i truncateScaled4(const float* in, __m128d scale) {
+  const __m128 v = _mm_loadu_ps(in);
+  const __m128i lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(v), scale));
+  const __m128i hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), scale));
+  return _mm_unpacklo_epi64(lo, hi);
+}
+
+DSP_TARGET("sse2")
+long float32toInt16Sse2(const float* in, uint8_t* out, long frames) {
+  const __m128d scale = _mm_set1_pd(kScaler16);
+  long i = 0;
+  for (; i + 8 <= frames; i += 8) {
+    const __m128i a = truncateScaled4(in + i, scale);
+    const __m128i b = truncateScaled4(in + i + 4, scale);
+    storeWords(out + 2 * i, _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                                            _mm_srai_epi32(_mm_slli_epi32(b, 16), 16)));
+  }
+  return i;
+}
+
+DSP_TARGET("sse2")
+long float32toInt32Sse2(const float* in, uint8_t* out, long frames) {
+  const __m128d scale = _mm_set1_pd(kScaler32);
+  long i = 0;
+  for (; i + 4 <= frames; i += 4) {
+    storeWords(out + 4 * i, truncateScaled4(in + i, scale));
+  }
+  return i;
+}
+
+// --- SSSE3 : formats 24 bits par pshufb ---
+// Les sorties 24 bits sont écrites par blocs de 16 octets qui se chevauchent : les 4 derniers
+// octets de chaque écriture sont recouverts par la suivante ou par la queue scalaire, la boucle
+// s'arrête assez tôt pour ne jamais écrire au-delà de la fin de la sortie.
+
+DSP_TARGET("ssse3")
+inline __m128i bytes24Mask(bool bigEndian) {
+  return bigEndian ? _mm_setr_epi8(3, 2, 1, 7, 6, 5, 11, 10, 9, 15, 14, 13, -1, -1, -1, -1)
+                   : _mm_setr_epi8(1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1);
+}
+
+DSP_TARGET("ssse3")
+long mono24Ssse3(const uint8_t* s, uint8_t* d, long frames, bool bigEndian) {
+  const __m128i mask = bytes24Mask(bigEndian);
+  long i = 0;
+  for (; i + 6 <= frames; i += 4) {
+    storeWords(d + 3 * i, _mm_shuffle_epi8(loadWords(s + 4 * i), mask));
+  }
+  return i;
+}
+
+DSP_TARGET("ssse3")
+long stereo24InterleavedSsse3(const uint8_t* l, const uint8_t* r, uint8_t* d, long frames, bool bigEndian) {
+  const __m128i mask = bytes24Mask(bigEndian);
+  long i = 0;
+  for (; i + 5 <= frames; i += 4) {
+    const __m128i a = loadWords(l + 4 * i);
+    const __m128i b = loadWords(r + 4 * i);
+    storeWords(d + 6 * i, _mm_shuffle_epi8(_mm_unpacklo_epi32(a, b), mask));
+    storeWords(d + 6 * i + 12, _mm_shuffle_epi8(_mm_unpackhi_epi32(a, b), mask));
+  }
+  return i;
+}
+
+// En place 3 -> 2 octets : 16 octets lus (4 échantillons utiles), 8 écrits plus bas
+DSP_TARGET("ssse3")
+long int24To16Ssse3(const uint8_t* in, uint8_t* out, long frames) {
+  const __m128i mask = _mm_setr_epi8(1, 2, 4, 5, 7, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1);
+  long i = 0;
+  for (; i + 6 <= frames; i += 4) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 2 * i), _mm_shuffle_epi8(loadWords(in + 3 * i), mask));
+  }
+  return i;
+}
+
+// Inversion des octets 0 et 2 de 5 échantillons 24 bits ; le 16e octet est réécrit inchangé.
+// Le bloc suivant est chargé avant l'écriture du bloc courant : le relire juste après une
+// écriture qui le chevauche empêcherait la transmission store -> load.
+DSP_TARGET("ssse3")
+long reverseEndian24Ssse3(uint8_t* a, long frames) {
+  const __m128i mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+  if (frames < 6) {
+    return 0;
+  }
+  __m128i v = loadWords(a);
+  long i = 0;
+  for (; i + 11 <= frames; i += 5) {
+    const __m128i next = loadWords(a + 3 * (i + 5));
+    storeWords(a + 3 * i, _mm_shuffle_epi8(v, mask));
+    v = next;
+  }
+  storeWords(a + 3 * i, _mm_shuffle_epi8(v, mask));
+  return i + 5;
+}
+
+// Décalage à gauche puis octets 1 à 3 (shift32 largeur 3, int32to24inPlace), en place 4 -> 3 octets
+DSP_TARGET("ssse3")
+long shift32To24Ssse3(const uint8_t* in, uint8_t* out, long shiftAmount, long frames) {
+  const __m128i count = _mm_cvtsi32_si128(static_cast<int>(shiftAmount));
+  const __m128i mask = bytes24Mask(false);
+  long i = 0;
+  for (; i + 6 <= frames; i += 4) {
+    storeWords(out + 3 * i, _mm_shuffle_epi8(_mm_sll_epi32(loadWords(in + 4 * i), count), mask));
+  }
+  return i;
+}
+
+// Expansions en place 2 -> 3 et 3 -> 4 octets, blocs de 4 échantillons depuis la fin :
+// les écritures d'un bloc ne recouvrent ni les entrées des blocs inférieurs ni les sorties déjà écrites
+DSP_TARGET("ssse3")
+void int16to24Ssse3(uint8_t* buffer, long blocks) {
+  const __m128i mask = _mm_setr_epi8(-1, 0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, -1, -1, -1);
+  for (long i = (blocks - 1) * 4; i >= 0; i -= 4) {
+    const __m128i v = _mm_shuffle_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(buffer + 2 * i)), mask);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(buffer + 3 * i), v);
+    const int32_t tail = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+    std::memcpy(buffer + 3 * i + 8, &tail, sizeof(tail));
+  }
+}
+
+DSP_TARGET("ssse3")
+void int24to32Ssse3(uint8_t* buffer, long blocks) {
+  const __m128i mask = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+  for (long i = (blocks - 1) * 4; i >= 0; i -= 4) {
+    storeWords(buffer + 4 * i, _mm_shuffle_epi8(loadWords(buffer + 3 * i), mask));
+  }
+}
+
+DSP_TARGET("ssse3")
+long float32toInt24Ssse3(const float* in, uint8_t* out, long frames) {
+  const __m128d scale = _mm_set1_pd(kScaler24);
+  const __m128i mask = _mm_setr_epi8(3, 2, 1, 7, 6, 5, 11, 10, 9, 15, 14, 13, -1, -1, -1, -1);
+  long i = 0;
+  for (; i + 6 <= frames; i += 4) {
+    storeWords(out + 3 * i, _mm_shuffle_epi8(truncateScaled4(in + i, scale), mask));
+  }
+  return i;
+}
+
+#endif // DSP_X86
+
+inline const uint8_t* bytes(const void* p) { return static_cast<const uint8_t*>(p); }
+inline uint8_t* bytes(void* p) { return static_cast<uint8_t*>(p); }
+
+} // namespace
+
+FastConvertSamples::FastConvertSamples(SimdLevel level) : simd(level) {
+#if !DSP_X86
+  simd = SimdLevel::Scalar;
+#endif
+}
+
+// Chaque méthode traite d'abord le plus grand préfixe vectorisable, puis la queue
+// avec le portage du SDK ; au niveau Scalar seule la seconde étape s'exécute.
+
+//-------------------------------------------------------------------------------------------
+// mono
+
+void FastConvertSamples::convertMono8(const int32_t* source, char* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = mono8Sse2(bytes(source), bytes(dest), frames, false);
+#endif
+  mono8Scalar(bytes(source + done), bytes(dest + done), frames - done, false);
+}
+
+void FastConvertSamples::convertMono8Unsigned(const int32_t* source, char* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = mono8Sse2(bytes(source), bytes(dest), frames, true);
+#endif
+  mono8Scalar(bytes(source + done), bytes(dest + done), frames - done, true);
+}
+
+void FastConvertSamples::convertMono16(const int32_t* source, short* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = mono16Sse2(bytes(source), bytes(dest), frames, true);
+#endif
+  mono16Scalar(bytes(source + done), bytes(dest + done), frames - done, true);
+}
+
+void FastConvertSamples::convertMono16SmallEndian(const int32_t* source, short* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = mono16Sse2(bytes(source), bytes(dest), frames, false);
+#endif
+  mono16Scalar(bytes(source + done), bytes(dest + done), frames - done, false);
+}
+
+void FastConvertSamples::convertMono24(const int32_t* source, char* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (ssse3()) done = mono24Ssse3(bytes(source), bytes(dest), frames, true);
+#endif
+  mono24Scalar(bytes(source + done), bytes(dest + 3 * done), frames - done, true);
+}
+
+void FastConvertSamples::convertMono24SmallEndian(const int32_t* source, char* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (ssse3()) done = mono24Ssse3(bytes(source), bytes(dest), frames, false);
+#endif
+  mono24Scalar(bytes(source + done), bytes(dest + 3 * done), frames - done, false);
+}
+
+//-------------------------------------------------------------------------------------------
+// stereo interleaved
+
+void FastConvertSamples::convertStereo8Interleaved(const int32_t* left, const int32_t* right, char* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = stereo8InterleavedSse2(bytes(left), bytes(right), bytes(dest), frames, false);
+#endif
+  stereo8InterleavedScalar(bytes(left + done), bytes(right + done), bytes(dest + 2 * done), frames - done, false);
+}
+
+void FastConvertSamples::convertStereo8InterleavedUnsigned(const int32_t* left, const int32_t* right, char* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = stereo8InterleavedSse2(bytes(left), bytes(right), bytes(dest), frames, true);
+#endif
+  stereo8InterleavedScalar(bytes(left + done), bytes(right + done), bytes(dest + 2 * done), frames - done, true);
+}
+
+void FastConvertSamples::convertStereo16Interleaved(const int32_t* left, const int32_t* right, short* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = stereo16InterleavedSse2(bytes(left), bytes(right), bytes(dest), frames, true);
+#endif
+  stereo16InterleavedScalar(bytes(left + done), bytes(right + done), bytes(dest + 2 * done), frames - done, true);
+}
+
+void FastConvertSamples::convertStereo16InterleavedSmallEndian(const int32_t* left, const int32_t* right, short* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = stereo16InterleavedSse2(bytes(left), bytes(right), bytes(dest), frames, false);
+#endif
+  stereo16InterleavedScalar(bytes(left + done), bytes(right + done), bytes(dest + 2 * done), frames - done, false);
+}
+
+void FastConvertSamples::convertStereo24Interleaved(const int32_t* left, const int32_t* right, char* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (ssse3()) done = stereo24InterleavedSsse3(bytes(left), bytes(right), bytes(dest), frames, true);
+#endif
+  stereo24InterleavedScalar(bytes(left + done), bytes(right + done), bytes(dest + 6 * done), frames - done, true);
+}
+
+void FastConvertSamples::convertStereo24InterleavedSmallEndian(const int32_t* left, const int32_t* right, char* dest, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (ssse3()) done = stereo24InterleavedSsse3(bytes(left), bytes(right), bytes(dest), frames, false);
+#endif
+  stereo24InterleavedScalar(bytes(left + done), bytes(right + done), bytes(dest + 6 * done), frames - done, false);
+}
+
+//-------------------------------------------------------------------------------------------
+// stereo split : deux conversions mono
+
+void FastConvertSamples::convertStereo8(const int32_t* left, const int32_t* right, char* dLeft, char* dRight, long frames) const {
+  convertMono8(left, dLeft, frames);
+  convertMono8(right, dRight, frames);
+}
+
+void FastConvertSamples::convertStereo8Unsigned(const int32_t* left, const int32_t* right, char* dLeft, char* dRight, long frames) const {
+  convertMono8Unsigned(left, dLeft, frames);
+  convertMono8Unsigned(right, dRight, frames);
+}
+
+void FastConvertSamples::convertStereo16(const int32_t* left, const int32_t* right, short* dLeft, short* dRight, long frames) const {
+  convertMono16(left, dLeft, frames);
+  convertMono16(right, dRight, frames);
+}
+
+void FastConvertSamples::convertStereo16SmallEndian(const int32_t* left, const int32_t* right, short* dLeft, short* dRight, long frames) const {
+  convertMono16SmallEndian(left, dLeft, frames);
+  convertMono16SmallEndian(right, dRight, frames);
+}
+
+void FastConvertSamples::convertStereo24(const int32_t* left, const int32_t* right, char* dLeft, char* dRight, long frames) const {
+  convertMono24(left, dLeft, frames);
+  convertMono24(right, dRight, frames);
+}
+
+void FastConvertSamples::convertStereo24SmallEndian(const int32_t* left, const int32_t* right, char* dLeft, char* dRight, long frames) const {
+  convertMono24SmallEndian(left, dLeft, frames);
+  convertMono24SmallEndian(right, dRight, frames);
+}
+
+//-------------------------------------------------------------------------------------------
+// in place integer conversions
+
+void FastConvertSamples::int32msb16to16inPlace(int32_t* in, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = int32HalfTo16Sse2(bytes(in), bytes(in), frames, true);
+#endif
+  int32HalfTo16Scalar(bytes(in + done), bytes(in) + 2 * done, frames - done, true);
+}
+
+void FastConvertSamples::int32lsb16to16inPlace(int32_t* in, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = int32HalfTo16Sse2(bytes(in), bytes(in), frames, false);
+#endif
+  int32HalfTo16Scalar(bytes(in + done), bytes(in) + 2 * done, frames - done, false);
+}
+
+void FastConvertSamples::int32msb16shiftedTo16inPlace(int32_t* in, long frames, long shift) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = int32ShiftedTo16Sse2(bytes(in), bytes(in), frames, shift);
+#endif
+  int32ShiftedTo16Scalar(in + done, reinterpret_cast<int16_t*>(in) + done, frames - done, shift);
+}
+
+void FastConvertSamples::int24msbto16inPlace(unsigned char* in, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (ssse3()) done = int24To16Ssse3(in, in, frames);
+#endif
+  int24To16Scalar(in + 3 * done, in + 2 * done, frames - done);
+}
+
+//-------------------------------------------------------------------------------------------
+// integer to integer
+
+void FastConvertSamples::shift32(void* buffer, long shiftAmount, long targetByteWidth, bool revertEndian, long frames) const {
+  // Paramètres hors limites refusés une fois pour toutes, buffer intact : un décalage de 32
+  // ou plus est indéfini en scalaire et donnerait des zéros en SSE
+  if (targetByteWidth < 2 || targetByteWidth > 4 || shiftAmount < 0 || shiftAmount > 31) {
+    return;
+  }
+  if (revertEndian) {
+    reverseEndian(buffer, 4, frames);
+  }
+  long done = 0;
+#if DSP_X86
+  if (targetByteWidth == 3) {
+    if (ssse3()) done = shift32To24Ssse3(bytes(buffer), bytes(buffer), shiftAmount, frames);
+  } else if (sse2()) {
+    done = shift32Sse2(bytes(buffer), bytes(buffer), shiftAmount, targetByteWidth, frames);
+  }
+#endif
+  shift32Scalar(bytes(buffer) + 4 * done, bytes(buffer) + targetByteWidth * done, shiftAmount, targetByteWidth, frames - done);
+}
+
+void FastConvertSamples::reverseEndian(void* buffer, long byteWidth, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (byteWidth == 3) {
+    if (ssse3()) done = reverseEndian24Ssse3(bytes(buffer), frames);
+  } else if ((byteWidth == 2 || byteWidth == 4) && sse2()) {
+    done = reverseEndianSse2(bytes(buffer), byteWidth, frames);
+  }
+#endif
+  reverseEndianScalar(bytes(buffer) + byteWidth * done, byteWidth, frames - done);
+}
+
+void FastConvertSamples::int32to16inPlace(void* buffer, long frames) const {
+  int32msb16to16inPlace(static_cast<int32_t*>(buffer), frames);
+}
+
+void FastConvertSamples::int24to16inPlace(void* buffer, long frames) const {
+  int24msbto16inPlace(static_cast<unsigned char*>(buffer), frames);
+}
+
+void FastConvertSamples::int32to24inPlace(void* buffer, long frames) const {
+  // (a >> 8) puis 3 octets de poids faible = octets 1 à 3 de a
+  shift32(buffer, 0, 3, false, frames);
+}
+
+void FastConvertSamples::int16to24inPlace(void* buffer, long frames) const {
+  long blocks = 0;
+#if DSP_X86
+  if (ssse3()) blocks = frames / 4;
+#endif
+  // Queue d'abord (fin du buffer), puis les blocs vectoriels en descendant
+  const long done = blocks * 4;
+  int16to24Scalar(bytes(buffer) + 2 * done, bytes(buffer) + 3 * done, frames - done);
+#if DSP_X86
+  if (blocks > 0) int16to24Ssse3(bytes(buffer), blocks);
+#endif
+}
+
+void FastConvertSamples::int24to32inPlace(void* buffer, long frames) const {
+  long blocks = 0;
+#if DSP_X86
+  // Le dernier bloc lit 16 octets : il faut au moins 4 échantillons pour rester dans le buffer
+  if (ssse3() && frames >= 4) blocks = frames / 4;
+#endif
+  const long done = blocks * 4;
+  int24to32Scalar(bytes(buffer) + 3 * done, bytes(buffer) + 4 * done, frames - done);
+#if DSP_X86
+  if (blocks > 0) int24to32Ssse3(bytes(buffer), blocks);
+#endif
+}
+
+void FastConvertSamples::int16to32inPlace(void* buffer, long frames) const {
+  long blocks = 0;
+#if DSP_X86
+  if (sse2()) blocks = frames / 8;
+#endif
+  const long done = blocks * 8;
+  int16to32Scalar(bytes(buffer) + 2 * done, bytes(buffer) + 4 * done, frames - done);
+#if DSP_X86
+  if (blocks > 0) int16to32Sse2(bytes(buffer), blocks);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------
+// float to integer
+
+void FastConvertSamples::float32toInt16inPlace(float* buffer, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = float32toInt16Sse2(buffer, bytes(buffer), frames);
+#endif
+  float32toInt16Scalar(buffer + done, bytes(buffer) + 2 * done, frames - done);
+}
+
+void FastConvertSamples::float32toInt24inPlace(float* buffer, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (ssse3()) done = float32toInt24Ssse3(buffer, bytes(buffer), frames);
+#endif
+  float32toInt24Scalar(buffer + done, bytes(buffer) + 3 * done, frames - done);
+}
+
+void FastConvertSamples::float32toInt32inPlace(float* buffer, long frames) const {
+  long done = 0;
+#if DSP_X86
+  if (sse2()) done = float32toInt32Sse2(buffer, bytes(buffer), frames);
+#endif
+  float32toInt32Scalar(buffer + done, bytes(buffer) + 4 * done, frames - done);
+}
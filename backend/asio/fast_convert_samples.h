@@ -0,0 +1,79 @@
+#ifndef __fast_convert_samples__
+#define __fast_convert_samples__
+
+#include <cstdint>
+
+#include "dsp_kernels.h"
+
+// Équivalent vectorisé de ASIOConvertSamples (SDK ASIO, host/ASIOConvertSamples.cpp)
+// Même interface et mêmes résultats octet pour octet que les routines du SDK sur
+// un hôte petit-boutiste (Windows/x86), y compris leurs particularités :
+// troncature vers zéro des conversions float, octets retenus par float32toInt24inPlace.
+// Les échantillons source sont des entiers 32 bits (le "long" 32 bits du SDK sous Windows).
+//
+// Au niveau Scalar, chaque méthode exécute le portage direct (octet par octet) de la
+// routine du SDK, qui sert de référence ; à partir de SSE2 les conversions utilisent
+// décalages et pack, et pshufb (SSSE3, présent sur tout processeur AVX2) pour les
+// formats 24 bits et les inversions d'octets.
+class FastConvertSamples {
+public:
+  explicit FastConvertSamples(SimdLevel level = detectSimdLevel());
+
+  SimdLevel level() const { return simd; }
+
+  // format converters, input 32 bit integer
+  // mono
+  void convertMono8(const int32_t* source, char* dest, long frames) const;
+  void convertMono8Unsigned(const int32_t* source, char* dest, long frames) const;
+  void convertMono16(const int32_t* source, short* dest, long frames) const;
+  void convertMono16SmallEndian(const int32_t* source, short* dest, long frames) const;
+  void convertMono24(const int32_t* source, char* dest, long frames) const;
+  void convertMono24SmallEndian(const int32_t* source, char* dest, long frames) const;
+
+  // stereo interleaved
+  void convertStereo8Interleaved(const int32_t* left, const int32_t* right, char* dest, long frames) const;
+  void convertStereo8InterleavedUnsigned(const int32_t* left, const int32_t* right, char* dest, long frames) const;
+  void convertStereo16Interleaved(const int32_t* left, const int32_t* right, short* dest, long frames) const;
+  void convertStereo16InterleavedSmallEndian(const int32_t* left, const int32_t* right, short* dest, long frames) const;
+  void convertStereo24Interleaved(const int32_t* left, const int32_t* right, char* dest, long frames) const;
+  void convertStereo24InterleavedSmallEndian(const int32_t* left, const int32_t* right, char* dest, long frames) const;
+
+  // stereo split
+  void convertStereo8(const int32_t* left, const int32_t* right, char* dLeft, char* dRight, long frames) const;
+  void convertStereo8Unsigned(const int32_t* left, const int32_t* right, char* dLeft, char* dRight, long frames) const;
+  void convertStereo16(const int32_t* left, const int32_t* right, short* dLeft, short* dRight, long frames) const;
+  void convertStereo16SmallEndian(const int32_t* left, const int32_t* right, short* dLeft, short* dRight, long frames) const;
+  void convertStereo24(const int32_t* left, const int32_t* right, char* dLeft, char* dRight, long frames) const;
+  void convertStereo24SmallEndian(const int32_t* left, const int32_t* right, char* dLeft, char* dRight, long frames) const;
+
+  // integer in place conversions
+  void int32msb16to16inPlace(int32_t* in, long frames) const;
+  void int32lsb16to16inPlace(int32_t* in, long frames) const;
+  void int32msb16shiftedTo16inPlace(int32_t* in, long frames, long shift) const;
+  void int24msbto16inPlace(unsigned char* in, long frames) const;
+
+  // integer to integer
+  // shift32 : shiftAmount de 0 à 31 et targetByteWidth de 2 à 4, sinon buffer inchangé
+  void shift32(void* buffer, long shiftAmount, long targetByteWidth, bool reverseEndian, long frames) const;
+  void reverseEndian(void* buffer, long byteWidth, long frames) const;
+
+  void int32to16inPlace(void* buffer, long frames) const;
+  void int24to16inPlace(void* buffer, long frames) const;
+  void int32to24inPlace(void* buffer, long frames) const;
+  void int16to24inPlace(void* buffer, long frames) const;
+  void int24to32inPlace(void* buffer, long frames) const;
+  void int16to32inPlace(void* buffer, long frames) const;
+
+  // float to integer
+  void float32toInt16inPlace(float* buffer, long frames) const;
+  void float32toInt24inPlace(float* buffer, long frames) const;
+  void float32toInt32inPlace(float* buffer, long frames) const;
+
+private:
+  bool sse2() const { return simd >= SimdLevel::SSE2; }
+  bool ssse3() const { return simd >= SimdLevel::AVX2; }
+
+  SimdLevel simd;
+};
+
+#endif
@@ -0,0 +1,457 @@
+#include "fft_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FFT_HAVE_SSE 1
+#else
+#define FFT_HAVE_SSE 0
+#endif
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Opérations élémentaires sur une voie scalaire ou sur un registre SSE :
+// les papillons sont écrits une seule fois et instanciés pour les deux.
+struct ScalarLane {
+  typedef float V;
+  static const size_t width = 1;
+  static V load(const float* p) { return *p; }
+  static void store(float* p, V v) { *p = v; }
+  static V set(float x) { return x; }
+  static V add(V a, V b) { return a + b; }
+  static V sub(V a, V b) { return a - b; }
+  static V mul(V a, V b) { return a * b; }
+};
+
+#if FFT_HAVE_SSE
+struct SseLane {
+  typedef __m128 V;
+  static const size_t width = 4;
+  static V load(const float* p) { return _mm_loadu_ps(p); }
+  static void store(float* p, V v) { _mm_storeu_ps(p, v); }
+  static V set(float x) { return _mm_set1_ps(x); }
+  static V add(V a, V b) { return _mm_add_ps(a, b); }
+  static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+  static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+};
+#endif
+
+template <class L>
+struct Cx {
+  typename L::V re, im;
+};
+
+template <class L>
+inline Cx<L> cadd(const Cx<L>& a, const Cx<L>& b) {
+  return { L::add(a.re, b.re), L::add(a.im, b.im) };
+}
+
+template <class L>
+inline Cx<L> csub(const Cx<L>& a, const Cx<L>& b) {
+  return { L::sub(a.re, b.re), L::sub(a.im, b.im) };
+}
+
+template <class L>
+inline Cx<L> cscale(const Cx<L>& a, typename L::V s) {
+  return { L::mul(a.re, s), L::mul(a.im, s) };
+}
+
+// Multiplication par un twiddle (wr, wi) diffusé sur toutes les voies
+template <class L>
+inline Cx<L> cmulw(const Cx<L>& a, typename L::V wr, typename L::V wi) {
+  return { L::sub(L::mul(a.re, wr), L::mul(a.im, wi)),
+           L::add(L::mul(a.re, wi), L::mul(a.im, wr)) };
+}
+
+// Multiplication par -i
+template <class L>
+inline Cx<L> cmulNegI(const Cx<L>& a) {
+  return { a.im, L::sub(L::set(0.0f), a.re) };
+}
+
+// Exécute un étage de Stockham pour les sous-transformées q dans [qBegin, qEnd)
+// x[q + s*(p + j*m)] -> y[q + s*(r*p + k)], avec m = length / r
+template <class L>
+void runStage(size_t radix, size_t length, size_t stride,
+              const float* twRe, const float* twIm,
+              const float* genericRe, const float* genericIm,
+              const float* xr, const float* xi, float* yr, float* yi,
+              size_t qBegin, size_t qEnd) {
+  typedef typename L::V V;
+  const size_t m = length / radix;
+  const size_t s = stride;
+
+  for (size_t p = 0; p < m; p++) {
+    const float* wr = twRe + p * (radix - 1);
+    const float* wi = twIm + p * (radix - 1);
+
+    for (size_t q = qBegin; q + L::width <= qEnd; q += L::width) {
+      const size_t in = q + s * p;
+      const size_t out = q + s * radix * p;
+
+      switch (radix) {
+        case 2: {
+          Cx<L> a0 = { L::load(xr + in), L::load(xi + in) };
+          Cx<L> a1 = { L::load(xr + in + s * m), L::load(xi + in + s * m) };
+          Cx<L> b0 = cadd(a0, a1);
+          Cx<L> b1 = cmulw(csub(a0, a1), L::set(wr[0]), L::set(wi[0]));
+          L::store(yr + out, b0.re); L::store(yi + out, b0.im);
+          L::store(yr + out + s, b1.re); L::store(yi + out + s, b1.im);
+          break;
+        }
+        case 3: {
+          const V half = L::set(0.5f);
+          const V sin60 = L::set(0.86602540378443864676f);
+          Cx<L> a0 = { L::load(xr + in), L::load(xi + in) };
+          Cx<L> a1 = { L::load(xr + in + s * m), L::load(xi + in + s * m) };
+          Cx<L> a2 = { L::load(xr + in + 2 * s * m), L::load(xi + in + 2 * s * m) };
+          Cx<L> t1 = cadd(a1, a2);
+          Cx<L> t2 = cscale(cmulNegI(csub(a1, a2)), sin60);
+          Cx<L> b0 = cadd(a0, t1);
+          Cx<L> m1 = csub(a0, cscale(t1, half));
+          Cx<L> b1 = cmulw(cadd(m1, t2), L::set(wr[0]), L::set(wi[0]));
+          Cx<L> b2 = cmulw(csub(m1, t2), L::set(wr[1]), L::set(wi[1]));
+          L::store(yr + out, b0.re); L::store(yi + out, b0.im);
+          L::store(yr + out + s, b1.re); L::store(yi + out + s, b1.im);
+          L::store(yr + out + 2 * s, b2.re); L::store(yi + out + 2 * s, b2.im);
+          break;
+        }
+        case 4: {
+          Cx<L> a0 = { L::load(xr + in), L::load(xi + in) };
+          Cx<L> a1 = { L::load(xr + in + s * m), L::load(xi + in + s * m) };
+          Cx<L> a2 = { L::load(xr + in + 2 * s * m), L::load(xi + in + 2 * s * m) };
+          Cx<L> a3 = { L::load(xr + in + 3 * s * m), L::load(xi + in + 3 * s * m) };
+          Cx<L> t0 = cadd(a0, a2);
+          Cx<L> t1 = csub(a0, a2);
+          Cx<L> t2 = cadd(a1, a3);
+          Cx<L> t3 = cmulNegI(csub(a1, a3));
+          Cx<L> b0 = cadd(t0, t2);
+          Cx<L> b1 = cmulw(cadd(t1, t3), L::set(wr[0]), L::set(wi[0]));
+          Cx<L> b2 = cmulw(csub(t0, t2), L::set(wr[1]), L::set(wi[1]));
+          Cx<L> b3 = cmulw(csub(t1, t3), L::set(wr[2]), L::set(wi[2]));
+          L::store(yr + out, b0.re); L::store(yi + out, b0.im);
+          L::store(yr + out + s, b1.re); L::store(yi + out + s, b1.im);
+          L::store(yr + out + 2 * s, b2.re); L::store(yi + out + 2 * s, b2.im);
+          L::store(yr + out + 3 * s, b3.re); L::store(yi + out + 3 * s, b3.im);
+          break;
+        }
+        case 5: {
+          const V c1 = L::set(0.30901699437494742410f);   // cos(2pi/5)
+          const V c2 = L::set(-0.80901699437494742410f);  // cos(4pi/5)
+          const V s1 = L::set(0.95105651629515357212f);   // sin(2pi/5)
+          const V s2 = L::set(0.58778525229247312917f);   // sin(4pi/5)
+          Cx<L> a0 = { L::load(xr + in), L::load(xi + in) };
+          Cx<L> a1 = { L::load(xr + in + s * m), L::load(xi + in + s * m) };
+          Cx<L> a2 = { L::load(xr + in + 2 * s * m), L::load(xi + in + 2 * s * m) };
+          Cx<L> a3 = { L::load(xr + in + 3 * s * m), L::load(xi + in + 3 * s * m) };
+          Cx<L> a4 = { L::load(xr + in + 4 * s * m), L::load(xi + in + 4 * s * m) };
+          Cx<L> t1 = cadd(a1, a4);
+          Cx<L> t2 = cadd(a2, a3);
+          Cx<L> t3 = csub(a1, a4);
+          Cx<L> t4 = csub(a2, a3);
+          Cx<L> b0 = cadd(a0, cadd(t1, t2));
+          Cx<L> m1 = cadd(a0, cadd(cscale(t1, c1), cscale(t2, c2)));
+          Cx<L> m2 = cadd(a0, cadd(cscale(t1, c2), cscale(t2, c1)));
+          Cx<L> n1 = cmulNegI(cadd(cscale(t3, s1), cscale(t4, s2)));
+          Cx<L> n2 = cmulNegI(csub(cscale(t3, s2), cscale(t4, s1)));
+          Cx<L> b1 = cmulw(cadd(m1, n1), L::set(wr[0]), L::set(wi[0]));
+          Cx<L> b2 = cmulw(cadd(m2, n2), L::set(wr[1]), L::set(wi[1]));
+          Cx<L> b3 = cmulw(csub(m2, n2), L::set(wr[2]), L::set(wi[2]));
+          Cx<L> b4 = cmulw(csub(m1, n1), L::set(wr[3]), L::set(wi[3]));
+          L::store(yr + out, b0.re); L::store(yi + out, b0.im);
+          L::store(yr + out + s, b1.re); L::store(yi + out + s, b1.im);
+          L::store(yr + out + 2 * s, b2.re); L::store(yi + out + 2 * s, b2.im);
+          L::store(yr + out + 3 * s, b3.re); L::store(yi + out + 3 * s, b3.im);
+          L::store(yr + out + 4 * s, b4.re); L::store(yi + out + 4 * s, b4.im);
+          break;
+        }
+        default: {
+          // Radix premier générique : DFT directe, les entrées sont relues pour chaque sortie
+          for (size_t k = 0; k < radix; k++) {
+            Cx<L> acc = { L::set(0.0f), L::set(0.0f) };
+            for (size_t j = 0; j < radix; j++) {
+              const size_t idx = in + s * j * m;
+              Cx<L> a = { L::load(xr + idx), L::load(xi + idx) };
+              const size_t w = (j * k) % radix;
+              acc = cadd(acc, cmulw(a, L::set(genericRe[w]), L::set(genericIm[w])));
+            }
+            if (k > 0) {
+              acc = cmulw(acc, L::set(wr[k - 1]), L::set(wi[k - 1]));
+            }
+            L::store(yr + out + k * s, acc.re);
+            L::store(yi + out + k * s, acc.im);
+          }
+          break;
+        }
+      }
+    }
+  }
+}
+
+// Décomposition de la taille : radix 4 en priorité, puis 2, 3, 5 et les autres facteurs premiers
+std::vector<size_t> factorize(size_t size) {
+  std::vector<size_t> radices;
+  while (size % 4 == 0) { radices.push_back(4); size /= 4; }
+  while (size % 2 == 0) { radices.push_back(2); size /= 2; }
+  for (size_t f = 3; f * f <= size; f += 2) {
+    while (size % f == 0) { radices.push_back(f); size /= f; }
+  }
+  if (size > 1) {
+    radices.push_back(size);
+  }
+  return radices;
+}
+
+} // namespace
+
+std::shared_ptr<const FFTPlan> FFTPlan::get(size_t size) {
+  static std::mutex cacheMutex;
+  static std::unordered_map<size_t, std::shared_ptr<const FFTPlan>> cache;
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  auto it = cache.find(size);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  auto plan = std::make_shared<const FFTPlan>(size);
+  cache.emplace(size, plan);
+  return plan;
+}
+
+FFTPlan::FFTPlan(size_t size)
+  : n(std::max<size_t>(size, 1)) {
+  complexSize = (n % 2 == 0) ? n / 2 : n;
+
+  // Étages de Stockham et leurs twiddles
+  size_t length = complexSize;
+  size_t stride = 1;
+  for (size_t radix : factorize(complexSize)) {
+    Stage stage;
+    stage.radix = radix;
+    stage.length = length;
+    stage.stride = stride;
+
+    const size_t m = length / radix;
+    stage.twiddleRe.resize(m * (radix - 1));
+    stage.twiddleIm.resize(m * (radix - 1));
+    for (size_t p = 0; p < m; p++) {
+      for (size_t k = 1; k < radix; k++) {
+        const double angle = -2.0 * kPi * static_cast<double>(p * k) / static_cast<double>(length);
+        stage.twiddleRe[p * (radix - 1) + k - 1] = static_cast<float>(std::cos(angle));
+        stage.twiddleIm[p * (radix - 1) + k - 1] = static_cast<float>(std::sin(angle));
+      }
+    }
+    if (radix > 5) {
+      stage.genericRe.resize(radix);
+      stage.genericIm.resize(radix);
+      for (size_t w = 0; w < radix; w++) {
+        const double angle = -2.0 * kPi * static_cast<double>(w) / static_cast<double>(radix);
+        stage.genericRe[w] = static_cast<float>(std::cos(angle));
+        stage.genericIm[w] = static_cast<float>(std::sin(angle));
+      }
+    }
+
+    stages.push_back(std::move(stage));
+    length /= radix;
+    stride *= radix;
+  }
+
+  // Twiddles du post-traitement de la transformée réelle empaquetée
+  realTwiddleRe.resize(n / 2 + 1);
+  realTwiddleIm.resize(n / 2 + 1);
+  for (size_t k = 0; k <= n / 2; k++) {
+    const double angle = -2.0 * kPi * static_cast<double>(k) / static_cast<double>(n);
+    realTwiddleRe[k] = static_cast<float>(std::cos(angle));
+    realTwiddleIm[k] = static_cast<float>(std::sin(angle));
+  }
+
+  // Fenêtre de Hann périodique
+  hann.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    hann[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * static_cast<double>(i) / static_cast<double>(n)));
+  }
+}
+
+void FFTPlan::prepare(FFTWorkspace& workspace) const {
+  workspace.re.resize(complexSize);
+  workspace.im.resize(complexSize);
+  workspace.tmpRe.resize(complexSize);
+  workspace.tmpIm.resize(complexSize);
+}
+
+void FFTPlan::complexForward(float* re, float* im, float* tmpRe, float* tmpIm) const {
+  float* xr = re;
+  float* xi = im;
+  float* yr = tmpRe;
+  float* yi = tmpIm;
+
+  for (const Stage& stage : stages) {
+    size_t vectorEnd = 0;
+#if FFT_HAVE_SSE
+    // Les sous-transformées entrelacées sont contiguës : 4 par registre
+    vectorEnd = stage.stride - stage.stride % SseLane::width;
+    if (vectorEnd > 0) {
+      runStage<SseLane>(stage.radix, stage.length, stage.stride,
+                        stage.twiddleRe.data(), stage.twiddleIm.data(),
+                        stage.genericRe.data(), stage.genericIm.data(),
+                        xr, xi, yr, yi, 0, vectorEnd);
+    }
+#endif
+    if (vectorEnd < stage.stride) {
+      runStage<ScalarLane>(stage.radix, stage.length, stage.stride,
+                           stage.twiddleRe.data(), stage.twiddleIm.data(),
+                           stage.genericRe.data(), stage.genericIm.data(),
+                           xr, xi, yr, yi, vectorEnd, stage.stride);
+    }
+    std::swap(xr, yr);
+    std::swap(xi, yi);
+  }
+
+  if (xr != re) {
+    std::copy(xr, xr + complexSize, re);
+    std::copy(xi, xi + complexSize, im);
+  }
+}
+
+void FFTPlan::forward(const float* input, float* outRe, float* outIm, FFTWorkspace& workspace) const {
+  float* zr = workspace.re.data();
+  float* zi = workspace.im.data();
+
+  if (n % 2 != 0) {
+    // Taille impaire : FFT complexe à partie imaginaire nulle
+    std::copy(input, input + n, zr);
+    std::fill(zi, zi + n, 0.0f);
+    complexForward(zr, zi, workspace.tmpRe.data(), workspace.tmpIm.data());
+    std::copy(zr, zr + n / 2 + 1, outRe);
+    std::copy(zi, zi + n / 2 + 1, outIm);
+    return;
+  }
+
+  // Empaquetage des échantillons pairs/impairs dans une FFT complexe de n/2 points
+  const size_t m = complexSize;
+  for (size_t j = 0; j < m; j++) {
+    zr[j] = input[2 * j];
+    zi[j] = input[2 * j + 1];
+  }
+  complexForward(zr, zi, workspace.tmpRe.data(), workspace.tmpIm.data());
+
+  for (size_t k = 0; k <= m; k++) {
+    const size_t a = (k == m) ? 0 : k;
+    const size_t b = (k == 0) ? 0 : m - k;
+    // Z[k] et conj(Z[m-k])
+    const float ar = zr[a], ai = zi[a];
+    const float br = zr[b], bi = -zi[b];
+    const float er = 0.5f * (ar + br), ei = 0.5f * (ai + bi);
+    const float dr = ar - br, di = ai - bi;
+    // O = -i/2 * D
+    const float orr = 0.5f * di, oi = -0.5f * dr;
+    const float wr = realTwiddleRe[k], wi = realTwiddleIm[k];
+    outRe[k] = er + orr * wr - oi * wi;
+    outIm[k] = ei + orr * wi + oi * wr;
+  }
+}
+
+void FFTPlan::inverse(const float* inRe, const float* inIm, float* output, FFTWorkspace& workspace) const {
+  float* zr = workspace.re.data();
+  float* zi = workspace.im.data();
+
+  if (n % 2 != 0) {
+    // Reconstruction du spectre hermitien complet puis FFT inverse complexe
+    for (size_t k = 0; k <= n / 2; k++) {
+      zr[k] = inRe[k];
+      zi[k] = inIm[k];
+    }
+    for (size_t k = n / 2 + 1; k < n; k++) {
+      zr[k] = inRe[n - k];
+      zi[k] = -inIm[n - k];
+    }
+    // IFFT(x) = swap(FFT(swap(x))) : il suffit d'échanger les rôles des parties
+    complexForward(zi, zr, workspace.tmpIm.data(), workspace.tmpRe.data());
+    const float scale = 1.0f / static_cast<float>(n);
+    for (size_t i = 0; i < n; i++) {
+      output[i] = zr[i] * scale;
+    }
+    return;
+  }
+
+  const size_t m = complexSize;
+  for (size_t k = 0; k < m; k++) {
+    // X[k] et conj(X[m-k])
+    const float ar = inRe[k], ai = inIm[k];
+    const float br = inRe[m - k], bi = -inIm[m - k];
+    const float er = 0.5f * (ar + br), ei = 0.5f * (ai + bi);
+    const float tr = 0.5f * (ar - br), ti = 0.5f * (ai - bi);
+    // O = conj(W^k) * T
+    const float wr = realTwiddleRe[k], wi = -realTwiddleIm[k];
+    const float orr = tr * wr - ti * wi, oi = tr * wi + ti * wr;
+    // Z[k] = E + i*O
+    zr[k] = er - oi;
+    zi[k] = ei + orr;
+  }
+
+  complexForward(zi, zr, workspace.tmpIm.data(), workspace.tmpRe.data());
+
+  const float scale = 1.0f / static_cast<float>(m);
+  for (size_t j = 0; j < m; j++) {
+    output[2 * j] = zr[j] * scale;
+    output[2 * j + 1] = zi[j] * scale;
+  }
+}
+
+void SpectrumAnalyzer::configure(size_t fftSize, size_t numBands) {
+  fftSize = std::max<size_t>(fftSize, 2);
+  numBands = std::max<size_t>(numBands, 1);
+  if (plan && plan->size() == fftSize && bandBegin.size() == numBands) {
+    return;
+  }
+
+  plan = FFTPlan::get(fftSize);
+  plan->prepare(workspace);
+  windowed.resize(fftSize);
+  binRe.resize(plan->numBins());
+  binIm.resize(plan->numBins());
+
+  // Bornes logarithmiques entre le premier bin utile (DC exclu) et Nyquist inclus
+  const size_t lo = 1;
+  const size_t hi = plan->numBins();
+  const double ratio = static_cast<double>(hi) / static_cast<double>(lo);
+  bandBegin.resize(numBands);
+  bandEnd.resize(numBands);
+
+  size_t previousEnd = lo;
+  for (size_t b = 0; b < numBands; b++) {
+    const double edgeLow = lo * std::pow(ratio, static_cast<double>(b) / numBands);
+    const double edgeHigh = lo * std::pow(ratio, static_cast<double>(b + 1) / numBands);
+    size_t begin = std::max(static_cast<size_t>(edgeLow), previousEnd);
+    begin = std::min(begin, hi - 1);
+    size_t end = std::max(static_cast<size_t>(edgeHigh), begin + 1);
+    end = std::min(end, hi);
+    bandBegin[b] = begin;
+    bandEnd[b] = end;
+    previousEnd = end;
+  }
+}
+
+void SpectrumAnalyzer::analyze(const float* samples, float* bandPower) {
+  const size_t size = plan->size();
+  const std::vector<float>& window = plan->window();
+  for (size_t i = 0; i < size; i++) {
+    windowed[i] = samples[i] * window[i];
+  }
+
+  plan->forward(windowed.data(), binRe.data(), binIm.data(), workspace);
+
+  for (size_t b = 0; b < bandBegin.size(); b++) {
+    float power = 0.0f;
+    for (size_t k = bandBegin[b]; k < bandEnd[b]; k++) {
+      power += binRe[k] * binRe[k] + binIm[k] * binIm[k];
+    }
+    bandPower[b] = power / static_cast<float>(bandEnd[b] - bandBegin[b]);
+  }
+}
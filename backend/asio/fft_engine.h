@@ -0,0 +1,85 @@
+#ifndef __fft_engine__
+#define __fft_engine__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Moteur FFT à entrée réelle
+// - algorithme de Stockham à radix mixte (4, 2, 3, 5 puis radix premier générique),
+//   ce qui couvre les tailles de buffer ASIO non puissances de deux (96, 192, 480...)
+// - tables de twiddles et de fenêtre de Hann calculées une seule fois par taille
+// - papillons vectorisés (SSE) sur les étages dont le pas le permet
+// - plans partagés via un cache indexé par la taille
+//
+// Un plan est immuable et peut être utilisé par plusieurs threads à la fois ;
+// chaque appelant fournit son propre espace de travail (FFTWorkspace).
+
+struct FFTWorkspace {
+  std::vector<float> re, im, tmpRe, tmpIm;
+};
+
+class FFTPlan {
+public:
+  // Retourne le plan (mis en cache) pour une transformée réelle de `size` points
+  // La création d'un plan alloue : ne jamais l'appeler depuis le callback audio
+  static std::shared_ptr<const FFTPlan> get(size_t size);
+
+  explicit FFTPlan(size_t size);
+
+  size_t size() const { return n; }
+  size_t numBins() const { return n / 2 + 1; }
+
+  // Fenêtre de Hann périodique de `size` points
+  const std::vector<float>& window() const { return hann; }
+
+  // Prépare un espace de travail pour ce plan (allocation, hors callback)
+  void prepare(FFTWorkspace& workspace) const;
+
+  // Transformée directe : `size` réels -> numBins() coefficients complexes (non normalisés)
+  void forward(const float* input, float* outRe, float* outIm, FFTWorkspace& workspace) const;
+
+  // Transformée inverse : numBins() coefficients -> `size` réels (normalisée par 1/size)
+  void inverse(const float* inRe, const float* inIm, float* output, FFTWorkspace& workspace) const;
+
+private:
+  struct Stage {
+    size_t radix;
+    size_t length;  // longueur des sous-transformées traitées par l'étage
+    size_t stride;  // nombre de sous-transformées entrelacées
+    std::vector<float> twiddleRe, twiddleIm; // W_length^(p*k), rangés [p][k-1]
+    std::vector<float> genericRe, genericIm; // W_radix^w pour les radix premiers > 5
+  };
+
+  // FFT complexe (sens direct) de `complexSize` points, résultat dans (re, im)
+  void complexForward(float* re, float* im, float* tmpRe, float* tmpIm) const;
+
+  size_t n;
+  size_t complexSize;         // n/2 si n est pair (empaquetage réel), sinon n
+  std::vector<Stage> stages;
+  std::vector<float> realTwiddleRe, realTwiddleIm; // W_n^k pour le post-traitement réel
+  std::vector<float> hann;
+};
+
+// Analyseur de spectre par bandes d'affichage
+// Les intervalles de bins de chaque bande (espacement logarithmique) sont précalculés :
+// une requête coûte une FFT plus un parcours de table.
+class SpectrumAnalyzer {
+public:
+  // Reconfigure l'analyseur si la taille ou le nombre de bandes change (allocation)
+  void configure(size_t fftSize, size_t numBands);
+
+  size_t fftSize() const { return plan ? plan->size() : 0; }
+  size_t numBands() const { return bandBegin.size(); }
+
+  // Calcule la puissance moyenne de chaque bande à partir de fftSize() échantillons
+  void analyze(const float* samples, float* bandPower);
+
+private:
+  std::shared_ptr<const FFTPlan> plan;
+  FFTWorkspace workspace;
+  std::vector<float> windowed, binRe, binIm;
+  std::vector<size_t> bandBegin, bandEnd;
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "fxlms_canceller.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "dsp_kernels.h"
+
+// Lissage de la puissance par bin (un pôle, par bloc)
+static const float kPowerSmoothing = 0.9f;
+
+// Régularisation du pas normalisé : fraction de la puissance moyenne + plancher absolu
+static const float kPowerRegularization = 0.01f;
+static const float kPowerFloor = 1e-10f;
+
+void FxlmsCanceller::configure(size_t blockSize, const FxlmsConfig& config) {
+  block = std::max<size_t>(blockSize, 1);
+  partitions = std::max<size_t>((config.taps + block - 1) / block, 1);
+  bins = block + 1;
+  binStride = paddedLength(bins);
+
+  plan = FFTPlan::get(2 * block);
+  plan->prepare(workspace);
+
+  const size_t spectra = partitions * binStride;
+  refRe.resize(spectra);
+  refIm.resize(spectra);
+  filteredRe.resize(spectra);
+  filteredIm.resize(spectra);
+  weightRe.resize(spectra);
+  weightIm.resize(spectra);
+
+  power.resize(bins);
+  normalizer.resize(bins);
+  accRe.resize(bins);
+  accIm.resize(bins);
+  errRe.resize(bins);
+  errIm.resize(bins);
+
+  refFrame.resize(2 * block);
+  filteredFrame.resize(2 * block);
+  timeScratch.resize(2 * block);
+  filteredBlock.resize(block);
+
+  // Chemin secondaire : FIR fourni, sinon impulsion retardée (les partitions nulles
+  // du retard ne coûtent rien au convolueur)
+  if (!config.secondaryPath.empty()) {
+    secondaryPath.configure(block, config.secondaryPath.data(), config.secondaryPath.size());
+  } else {
+    std::vector<float> impulse(config.secondaryDelay + 1, 0.0f);
+    impulse[config.secondaryDelay] = config.secondaryGain;
+    secondaryPath.configure(block, impulse.data(), impulse.size());
+  }
+
+  mu.configure(0.0, block, 0.0);
+  mu.setTarget(config.stepSize);
+  reset();
+}
+
+void FxlmsCanceller::reset() {
+  refRe.zero();
+  refIm.zero();
+  filteredRe.zero();
+  filteredIm.zero();
+  weightRe.zero();
+  weightIm.zero();
+  power.zero();
+  refFrame.zero();
+  filteredFrame.zero();
+  secondaryPath.reset();
+  head = 0;
+  constrainNext = 0;
+  mu.reset();
+}
+
+void FxlmsCanceller::process(const float* reference, const float* error, float* output) {
+  if (partitions == 0) {
+    return;
+  }
+
+  // 1. Spectre de la trame de référence [bloc précédent, bloc courant] en tête de FDL
+  head = head + 1 == partitions ? 0 : head + 1;
+  std::memmove(refFrame.data(), refFrame.data() + block, block * sizeof(float));
+  std::memcpy(refFrame.data() + block, reference, block * sizeof(float));
+  plan->forward(refFrame.data(), refRe.data() + slotOf(0), refIm.data() + slotOf(0), workspace);
+
+  // 2. Filtrage : Y = somme des W_p * X_(k-p), puis overlap-save (seconde moitié)
+  const DspKernels& kernels = dspKernels();
+  accRe.zero();
+  accIm.zero();
+  for (size_t p = 0; p < partitions; p++) {
+    kernels.complexMulAdd(refRe.data() + slotOf(p), refIm.data() + slotOf(p),
+                          weightRe.data() + p * binStride, weightIm.data() + p * binStride,
+                          accRe.data(), accIm.data(), binStride);
+  }
+  plan->inverse(accRe.data(), accIm.data(), timeScratch.data(), workspace);
+  std::memcpy(output, timeScratch.data() + block, block * sizeof(float));
+
+  // 3. Référence filtrée par le chemin secondaire estimé, dans sa propre FDL
+  secondaryPath.process(reference, filteredBlock.data());
+  std::memmove(filteredFrame.data(), filteredFrame.data() + block, block * sizeof(float));
+  std::memcpy(filteredFrame.data() + block, filteredBlock.data(), block * sizeof(float));
+  float* fr0 = filteredRe.data() + slotOf(0);
+  float* fi0 = filteredIm.data() + slotOf(0);
+  plan->forward(filteredFrame.data(), fr0, fi0, workspace);
+
+  // 4. Pas normalisé par bin : mu / (P * (puissance lissée + régularisation))
+  float* pw = power.data();
+  float meanPower = 0.0f;
+  for (size_t k = 0; k < bins; k++) {
+    pw[k] = kPowerSmoothing * pw[k] + (1.0f - kPowerSmoothing) * (fr0[k] * fr0[k] + fi0[k] * fi0[k]);
+    meanPower += pw[k];
+  }
+  meanPower /= static_cast<float>(bins);
+  // Le pas est réparti sur les P partitions : la correction totale du filtre reste
+  // indépendante de sa longueur
+  const float stepSize = mu.nextBlock(block) / static_cast<float>(partitions);
+  const float regularization = kPowerRegularization * meanPower + kPowerFloor;
+  float* norm = normalizer.data();
+  for (size_t k = 0; k < bins; k++) {
+    norm[k] = stepSize / (pw[k] + regularization);
+  }
+
+  // 5. Spectre de l'erreur : trame [0, e] (overlap-save du gradient)
+  std::memset(timeScratch.data(), 0, block * sizeof(float));
+  std::memcpy(timeScratch.data() + block, error, block * sizeof(float));
+  plan->forward(timeScratch.data(), errRe.data(), errIm.data(), workspace);
+
+  // 6. Mise à jour : W_p -= norm * conj(X'_(k-p)) * E, sans contrainte
+  const float* er = errRe.data();
+  const float* ei = errIm.data();
+  for (size_t p = 0; p < partitions; p++) {
+    const float* fr = filteredRe.data() + slotOf(p);
+    const float* fi = filteredIm.data() + slotOf(p);
+    float* wr = weightRe.data() + p * binStride;
+    float* wi = weightIm.data() + p * binStride;
+    for (size_t k = 0; k < bins; k++) {
+      wr[k] -= norm[k] * (fr[k] * er[k] + fi[k] * ei[k]);
+      wi[k] -= norm[k] * (fr[k] * ei[k] - fi[k] * er[k]);
+    }
+  }
+
+  // 7. Contrainte à tour de rôle : la partition choisie est ramenée à B taps
+  //    (IFFT, mise à zéro de la seconde moitié, FFT)
+  float* wr = weightRe.data() + constrainNext * binStride;
+  float* wi = weightIm.data() + constrainNext * binStride;
+  plan->inverse(wr, wi, timeScratch.data(), workspace);
+  std::memset(timeScratch.data() + block, 0, block * sizeof(float));
+  plan->forward(timeScratch.data(), wr, wi, workspace);
+  constrainNext = constrainNext + 1 == partitions ? 0 : constrainNext + 1;
+}
+
+void FxlmsCanceller::memoryRegions(std::vector<MemoryRegion>& regions) const {
+  appendRegion(regions, "fxlms", refRe);
+  appendRegion(regions, "fxlms", refIm);
+  appendRegion(regions, "fxlms", filteredRe);
+  appendRegion(regions, "fxlms", filteredIm);
+  appendRegion(regions, "fxlms", weightRe);
+  appendRegion(regions, "fxlms", weightIm);
+  appendRegion(regions, "fxlms", power);
+  appendRegion(regions, "fxlms", normalizer);
+  appendRegion(regions, "fxlms", accRe);
+  appendRegion(regions, "fxlms", accIm);
+  appendRegion(regions, "fxlms", errRe);
+  appendRegion(regions, "fxlms", errIm);
+  appendRegion(regions, "fxlms", refFrame);
+  appendRegion(regions, "fxlms", filteredFrame);
+  appendRegion(regions, "fxlms", timeScratch);
+  appendRegion(regions, "fxlms", filteredBlock);
+  appendRegion(regions, "fxlms", workspace.re);
+  appendRegion(regions, "fxlms", workspace.im);
+  appendRegion(regions, "fxlms", workspace.tmpRe);
+  appendRegion(regions, "fxlms", workspace.tmpIm);
+  secondaryPath.memoryRegions(regions, "secondaryPath");
+}
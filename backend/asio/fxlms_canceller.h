@@ -0,0 +1,91 @@
+#ifndef __fxlms_canceller__
+#define __fxlms_canceller__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "fft_engine.h"
+#include "partitioned_convolver.h"
+#include "smoothed_parameter.h"
+
+// Paramètres du mode adaptatif
+struct FxlmsConfig {
+  size_t taps = 2048;          // longueur du filtre adaptatif (arrondie au bloc supérieur)
+  float stepSize = 0.5f;       // pas d'adaptation normalisé (0 < mu <= 1)
+  // Modèle du chemin secondaire (haut-parleur -> micro d'erreur) : réponse FIR
+  // mesurée, ou à défaut un retard pur en échantillons et un gain
+  std::vector<float> secondaryPath;
+  size_t secondaryDelay = 0;
+  float secondaryGain = 1.0f;
+};
+
+// Annuleur adaptatif filtered-x LMS en blocs fréquentiels partitionnés
+// (PBFDAF, overlap-save, FFT de 2B points pour des blocs de B échantillons).
+// - le filtre de L taps est découpé en P = L/B partitions ; les spectres des
+//   derniers blocs de référence sont conservés dans une ligne à retard
+//   fréquentielle (FDL), le filtrage coûte P produits complexes par bin et par bloc
+// - la mise à jour utilise la référence filtrée par le modèle FIR du chemin
+//   secondaire (PartitionedConvolver) et un pas normalisé par la puissance de chaque bin
+// - la contrainte de gradient (suppression du repliement circulaire) n'est appliquée
+//   qu'à une partition par bloc, à tour de rôle : deux FFT par bloc au lieu de 2P
+//
+// Le filtre n'ajoute aucune latence au-delà du bloc ASIO.
+class FxlmsCanceller {
+public:
+  // À l'arrêt : alloue toutes les structures pour des blocs de blockSize échantillons
+  void configure(size_t blockSize, const FxlmsConfig& config);
+
+  // À l'arrêt : remet le filtre et l'historique à zéro
+  void reset();
+
+  size_t blockSize() const { return block; }
+  size_t taps() const { return block * partitions; }
+  size_t partitionCount() const { return partitions; }
+
+  // Pas d'adaptation : modifiable depuis n'importe quel thread, lu une fois par bloc
+  SmoothedParameter& stepSize() { return mu; }
+
+  // Côté callback : référence et erreur du bloc courant -> anti-bruit (blockSize échantillons).
+  // Sans allocation ni verrou. output peut être lu par BlockRamp::apply (aligné, rembourré).
+  void process(const float* reference, const float* error, float* output);
+
+  // Plages utilisées par process(), chemin secondaire compris (verrouillage en mémoire)
+  void memoryRegions(std::vector<MemoryRegion>& regions) const;
+
+private:
+  // Accès aux spectres de la ligne à retard (p = 0 : bloc le plus récent)
+  size_t slotOf(size_t p) const { return ((head + partitions - p) % partitions) * binStride; }
+
+  size_t block = 0;
+  size_t partitions = 0;
+  size_t bins = 0;       // B + 1
+  size_t binStride = 0;  // bins arrondi à kKernelBlock
+  size_t head = 0;
+  size_t constrainNext = 0;
+
+  std::shared_ptr<const FFTPlan> plan;
+  FFTWorkspace workspace;
+
+  // Spectres (parties réelle et imaginaire séparées), [partition][bin]
+  AlignedBuffer<float> refRe, refIm;           // FDL de la référence
+  AlignedBuffer<float> filteredRe, filteredIm; // FDL de la référence filtrée
+  AlignedBuffer<float> weightRe, weightIm;     // filtre adaptatif
+
+  AlignedBuffer<float> power;                  // puissance lissée par bin
+  AlignedBuffer<float> normalizer;             // mu / (puissance + régularisation)
+  AlignedBuffer<float> accRe, accIm;           // accumulateur / gradient
+  AlignedBuffer<float> errRe, errIm;
+
+  // Trames temporelles de 2B échantillons (bloc précédent puis bloc courant)
+  AlignedBuffer<float> refFrame, filteredFrame, timeScratch;
+  AlignedBuffer<float> filteredBlock;
+
+  // Modèle du chemin secondaire
+  PartitionedConvolver secondaryPath;
+
+  SmoothedParameter mu;
+};
+
+#endif
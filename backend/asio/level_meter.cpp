@@ -0,0 +1,65 @@
+#include "level_meter.h"
+
+#include <cmath>
+
+#include "dsp_kernels.h"
+
+void LevelMeter::configure(double sampleRate, size_t blockSize,
+                           double attackMs, double releaseMs, double holdMs) {
+  if (sampleRate <= 0.0 || blockSize == 0) {
+    return;
+  }
+
+  // Coefficients d'un filtre à un pôle évalué une fois par bloc
+  const double blockMs = 1000.0 * static_cast<double>(blockSize) / sampleRate;
+  attackCoef = static_cast<float>(std::exp(-blockMs / attackMs));
+  releaseCoef = static_cast<float>(std::exp(-blockMs / releaseMs));
+  holdBlocks = static_cast<unsigned int>(holdMs / blockMs);
+}
+
+void LevelMeter::reset() {
+  rms = 0.0f;
+  peak = 0.0f;
+  peakHold = 0.0f;
+  holdCounter = 0;
+  blocks = 0;
+  published.write(LevelSnapshot{0.0f, 0.0f, 0.0f, 0});
+}
+
+void LevelMeter::process(const float* block, size_t count) {
+  if (count == 0) {
+    return;
+  }
+
+  // Réduction SIMD sur le bloc rembourré : le rembourrage nul ne change ni la
+  // somme des carrés ni la crête
+  float sumSquares = 0.0f;
+  float blockPeak = 0.0f;
+  dspKernels().sumSquaresPeak(block, paddedLength(count), &sumSquares, &blockPeak);
+
+  // Un seul test par bloc : un bloc contenant NaN/Inf est ignoré
+  if (!std::isfinite(sumSquares) || !std::isfinite(blockPeak)) {
+    return;
+  }
+
+  const float blockRms = std::sqrt(sumSquares / static_cast<float>(count));
+
+  // Balistique : attaque rapide, relâchement lent
+  const float rmsCoef = blockRms > rms ? attackCoef : releaseCoef;
+  rms = blockRms + rmsCoef * (rms - blockRms);
+  const float peakCoef = blockPeak > peak ? attackCoef : releaseCoef;
+  peak = blockPeak + peakCoef * (peak - blockPeak);
+
+  // Maintien de crête puis décroissance au rythme du relâchement
+  if (blockPeak >= peakHold) {
+    peakHold = blockPeak;
+    holdCounter = holdBlocks;
+  } else if (holdCounter > 0) {
+    holdCounter--;
+  } else {
+    peakHold *= releaseCoef;
+  }
+
+  blocks++;
+  published.write(LevelSnapshot{rms, peak, peakHold, blocks});
+}
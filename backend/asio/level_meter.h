@@ -0,0 +1,52 @@
+#ifndef __level_meter__
+#define __level_meter__
+
+#include <cstddef>
+
+#include "seqlock.h"
+
+// Niveaux publiés par le callback (valeurs linéaires, 1.0 = pleine échelle)
+struct LevelSnapshot {
+  float rms;       // RMS lissé (balistique attaque/relâchement)
+  float peak;      // crête lissée
+  float peakHold;  // crête maintenue puis décroissante
+  unsigned int blocks; // nombre de blocs mesurés
+};
+
+// Mesure de niveau incrémentale
+// process() est appelé depuis le callback audio pour chaque bloc : une seule
+// réduction (somme des carrés + crête) sur le bloc, la balistique est appliquée
+// une fois par bloc, puis le résultat est publié dans un seqlock.
+// snapshot() ne coûte que quelques lectures quelle que soit la taille du buffer.
+class LevelMeter {
+public:
+  // À appeler à l'arrêt : calcule les coefficients de balistique pour la durée d'un bloc
+  void configure(double sampleRate, size_t blockSize,
+                 double attackMs = 10.0, double releaseMs = 300.0, double holdMs = 1500.0);
+
+  // Remet les niveaux à zéro (à l'arrêt)
+  void reset();
+
+  // Côté callback : sans verrou ni allocation
+  // block doit être aligné sur kBufferAlignment et nul jusqu'à paddedLength(count)
+  void process(const float* block, size_t count);
+
+  // Côté lecteur : dernier instantané publié
+  LevelSnapshot snapshot() const { return published.read(); }
+
+private:
+  float attackCoef = 0.0f;
+  float releaseCoef = 0.0f;
+  unsigned int holdBlocks = 0;
+
+  // État propre au callback
+  float rms = 0.0f;
+  float peak = 0.0f;
+  float peakHold = 0.0f;
+  unsigned int holdCounter = 0;
+  unsigned int blocks = 0;
+
+  SeqLock<LevelSnapshot> published;
+};
+
+#endif
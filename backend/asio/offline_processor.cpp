@@ -0,0 +1,511 @@
+#include "offline_processor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "aligned_buffer.h"
+#include "dsp_kernels.h"
+
+namespace {
+
+// En-tête WAV canonique écrit en sortie (RIFF, fmt de 16 octets, data)
+const uint64_t kWavHeaderSize = 44;
+
+const uint16_t kWavePcm = 1;
+const uint16_t kWaveFloat = 3;
+const uint16_t kWaveExtensible = 0xfffe;
+
+uint16_t readU16(const uint8_t* p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void writeU16(uint8_t* p, uint16_t value) {
+  p[0] = static_cast<uint8_t>(value);
+  p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void writeU32(uint8_t* p, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    p[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+bool isFloatFormat(SampleFormat format) {
+  return format == SampleFormat::Float32LSB || format == SampleFormat::Float64LSB;
+}
+
+void writeWavHeader(uint8_t* p, SampleFormat format, size_t bytesPerSample, uint32_t channels,
+                    uint32_t sampleRate, uint64_t dataBytes) {
+  const uint32_t blockAlign = static_cast<uint32_t>(bytesPerSample * channels);
+  std::memcpy(p, "RIFF", 4);
+  writeU32(p + 4, static_cast<uint32_t>(36 + dataBytes));
+  std::memcpy(p + 8, "WAVEfmt ", 8);
+  writeU32(p + 16, 16);
+  writeU16(p + 20, isFloatFormat(format) ? kWaveFloat : kWavePcm);
+  writeU16(p + 22, static_cast<uint16_t>(channels));
+  writeU32(p + 24, sampleRate);
+  writeU32(p + 28, sampleRate * blockAlign);
+  writeU16(p + 32, static_cast<uint16_t>(blockAlign));
+  writeU16(p + 34, static_cast<uint16_t>(8 * bytesPerSample));
+  std::memcpy(p + 36, "data", 4);
+  writeU32(p + 40, static_cast<uint32_t>(dataBytes));
+}
+
+#ifdef _WIN32
+std::wstring widePath(const std::string& path) {
+  const int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+  std::wstring wide(length > 0 ? static_cast<size_t>(length) : 1, L'\0');
+  if (length > 0) {
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wide[0], length);
+  }
+  return wide;
+}
+#endif
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------
+// MappedFile
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::openRead(const std::string& path, std::string* error) {
+  close();
+  file = CreateFileW(widePath(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                     FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    file = nullptr;
+    *error = "Impossible d'ouvrir " + path;
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+    *error = "Fichier vide ou illisible : " + path;
+    close();
+    return false;
+  }
+  mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  bytes = mapping ? static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+  if (!bytes) {
+    *error = "Impossible de projeter " + path + " en mémoire";
+    close();
+    return false;
+  }
+  length = static_cast<uint64_t>(fileSize.QuadPart);
+  return true;
+}
+
+bool MappedFile::create(const std::string& path, uint64_t size, std::string* error) {
+  close();
+  file = CreateFileW(widePath(path).c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                     FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    file = nullptr;
+    *error = "Impossible de créer " + path;
+    return false;
+  }
+  // La projection fixe la taille du fichier
+  mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                               static_cast<DWORD>(size & 0xffffffffu), nullptr);
+  bytes = mapping ? static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0)) : nullptr;
+  if (!bytes) {
+    *error = "Impossible de projeter " + path + " en mémoire";
+    close();
+    return false;
+  }
+  length = size;
+  return true;
+}
+
+bool MappedFile::sameFile(const std::string& path) const {
+  if (!file) {
+    return false;
+  }
+  HANDLE other = CreateFileW(widePath(path).c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                             nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (other == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  BY_HANDLE_FILE_INFORMATION a;
+  BY_HANDLE_FILE_INFORMATION b;
+  const bool same = GetFileInformationByHandle(file, &a) && GetFileInformationByHandle(other, &b) &&
+                    a.dwVolumeSerialNumber == b.dwVolumeSerialNumber &&
+                    a.nFileIndexHigh == b.nFileIndexHigh && a.nFileIndexLow == b.nFileIndexLow;
+  CloseHandle(other);
+  return same;
+}
+
+void MappedFile::close() {
+  if (bytes) {
+    UnmapViewOfFile(bytes);
+  }
+  if (mapping) {
+    CloseHandle(mapping);
+  }
+  if (file) {
+    CloseHandle(file);
+  }
+  bytes = nullptr;
+  mapping = nullptr;
+  file = nullptr;
+  length = 0;
+}
+
+#else
+
+bool MappedFile::openRead(const std::string& path, std::string* error) {
+  close();
+  fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    *error = "Impossible d'ouvrir " + path + " : " + std::strerror(errno);
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+    *error = "Fichier vide ou illisible : " + path;
+    close();
+    return false;
+  }
+  void* address = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    *error = "Impossible de projeter " + path + " en mémoire : " + std::strerror(errno);
+    close();
+    return false;
+  }
+  bytes = static_cast<uint8_t*>(address);
+  length = static_cast<uint64_t>(status.st_size);
+  // Lecture strictement séquentielle : lecture anticipée agressive
+  posix_madvise(address, static_cast<size_t>(length), POSIX_MADV_SEQUENTIAL);
+  return true;
+}
+
+bool MappedFile::create(const std::string& path, uint64_t size, std::string* error) {
+  close();
+  fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    *error = "Impossible de créer " + path + " : " + std::strerror(errno);
+    return false;
+  }
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    *error = "Impossible de dimensionner " + path + " : " + std::strerror(errno);
+    close();
+    return false;
+  }
+  void* address = mmap(nullptr, static_cast<size_t>(size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    *error = "Impossible de projeter " + path + " en mémoire : " + std::strerror(errno);
+    close();
+    return false;
+  }
+  bytes = static_cast<uint8_t*>(address);
+  length = size;
+  posix_madvise(address, static_cast<size_t>(length), POSIX_MADV_SEQUENTIAL);
+  return true;
+}
+
+bool MappedFile::sameFile(const std::string& path) const {
+  struct stat opened;
+  struct stat other;
+  return fd >= 0 && fstat(fd, &opened) == 0 && ::stat(path.c_str(), &other) == 0 &&
+         opened.st_dev == other.st_dev && opened.st_ino == other.st_ino;
+}
+
+void MappedFile::close() {
+  if (bytes) {
+    munmap(bytes, static_cast<size_t>(length));
+  }
+  if (fd >= 0) {
+    ::close(fd);
+  }
+  bytes = nullptr;
+  length = 0;
+  fd = -1;
+}
+
+#endif
+
+//-------------------------------------------------------------------------------------------
+// WAV
+
+bool parseWav(const uint8_t* data, uint64_t size, WavInfo* info, std::string* error) {
+  if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+    *error = "Fichier WAV invalide (en-tête RIFF/WAVE absent)";
+    return false;
+  }
+
+  bool haveFormat = false;
+  uint16_t tag = 0;
+  uint16_t bits = 0;
+  uint64_t pos = 12;
+  while (pos + 8 <= size) {
+    const uint8_t* chunk = data + pos;
+    const uint64_t chunkSize = readU32(chunk + 4);
+    const uint64_t body = pos + 8;
+
+    if (std::memcmp(chunk, "fmt ", 4) == 0) {
+      if (chunkSize < 16 || body + chunkSize > size) {
+        *error = "Bloc fmt invalide";
+        return false;
+      }
+      tag = readU16(data + body);
+      info->channels = readU16(data + body + 2);
+      info->sampleRate = static_cast<double>(readU32(data + body + 4));
+      bits = readU16(data + body + 14);
+      // WAVE_FORMAT_EXTENSIBLE : le vrai format est dans les 2 premiers octets du sous-format
+      if (tag == kWaveExtensible && chunkSize >= 40) {
+        tag = readU16(data + body + 24);
+      }
+      haveFormat = true;
+    } else if (std::memcmp(chunk, "data", 4) == 0) {
+      if (!haveFormat) {
+        *error = "Bloc data avant le bloc fmt";
+        return false;
+      }
+      SampleFormat format;
+      if (tag == kWavePcm && bits == 16) {
+        format = SampleFormat::Int16LSB;
+      } else if (tag == kWavePcm && bits == 24) {
+        format = SampleFormat::Int24LSB;
+      } else if (tag == kWavePcm && bits == 32) {
+        format = SampleFormat::Int32LSB;
+      } else if (tag == kWaveFloat && bits == 32) {
+        format = SampleFormat::Float32LSB;
+      } else if (tag == kWaveFloat && bits == 64) {
+        format = SampleFormat::Float64LSB;
+      } else {
+        *error = "Format WAV non supporté (code " + std::to_string(tag) + ", " + std::to_string(bits) + " bits)";
+        return false;
+      }
+      if (info->channels == 0 || info->sampleRate <= 0.0) {
+        *error = "Nombre de canaux ou fréquence d'échantillonnage invalide";
+        return false;
+      }
+      // Un bloc data tronqué (enregistrement interrompu) est lu jusqu'à la fin du fichier
+      const uint64_t available = std::min<uint64_t>(chunkSize, size - body);
+      info->format = format;
+      info->dataOffset = body;
+      info->frames = available / (static_cast<uint64_t>(bits / 8) * info->channels);
+      return true;
+    }
+    // Les blocs sont alignés sur 2 octets
+    pos = body + chunkSize + (chunkSize & 1);
+  }
+
+  *error = haveFormat ? "Bloc data absent" : "Bloc fmt absent";
+  return false;
+}
+
+bool offlineFormatFromName(const std::string& name, SampleFormat* format) {
+  if (name == "int16") {
+    *format = SampleFormat::Int16LSB;
+  } else if (name == "int24") {
+    *format = SampleFormat::Int24LSB;
+  } else if (name == "int32") {
+    *format = SampleFormat::Int32LSB;
+  } else if (name == "float32") {
+    *format = SampleFormat::Float32LSB;
+  } else if (name == "float64") {
+    *format = SampleFormat::Float64LSB;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+//-------------------------------------------------------------------------------------------
+// Traitement
+
+OfflineResult processFile(const OfflineJob& job) {
+  OfflineResult result;
+
+  MappedFile input;
+  if (!input.openRead(job.input, &result.error)) {
+    return result;
+  }
+  // La création tronque la sortie : sur le fichier d'entrée, la projection perdrait ses pages
+  if (input.sameFile(job.output)) {
+    result.error = "Le fichier de sortie est le fichier d'entrée : " + job.output;
+    return result;
+  }
+  WavInfo info;
+  if (!parseWav(input.data(), input.size(), &info, &result.error)) {
+    result.error = job.input + " : " + result.error;
+    return result;
+  }
+  result.frames = info.frames;
+  result.inputChannels = info.channels;
+  result.sampleRate = info.sampleRate;
+
+  if (job.blockSize == 0 || job.blockSize > 65536) {
+    result.error = "Taille de bloc invalide : " + std::to_string(job.blockSize);
+    return result;
+  }
+
+  // Validation des routes contre les canaux du fichier
+  ChainSettings settings = job.settings;
+  if (settings.routes.empty()) {
+    settings.routes.push_back(Route{0, 0, 1.0f});
+  }
+  long lastOutput = 0;
+  for (const Route& route : settings.routes) {
+    if (route.input < 0 || route.input >= static_cast<long>(info.channels)) {
+      result.error = "Canal d'entrée inexistant dans " + job.input + " : " + std::to_string(route.input);
+      return result;
+    }
+    lastOutput = std::max(lastOutput, route.output);
+  }
+  const long outputChannels = job.outputChannels > 0 ? job.outputChannels : lastOutput + 1;
+  if (lastOutput >= outputChannels || outputChannels > 256) {
+    result.error = "Nombre de canaux de sortie invalide : " + std::to_string(outputChannels);
+    return result;
+  }
+  if (settings.mode == ProcessingMode::Fxlms && settings.routes.size() != 1) {
+    result.error = "Le mode fxlms n'accepte qu'une route (référence -> haut-parleur)";
+    return result;
+  }
+  if (settings.mode == ProcessingMode::Fxlms &&
+      (settings.errorChannel < 0 || settings.errorChannel >= static_cast<long>(info.channels) ||
+       settings.errorChannel == settings.routes[0].input)) {
+    result.error = "Canal du micro d'erreur invalide : " + std::to_string(settings.errorChannel);
+    return result;
+  }
+  result.outputChannels = static_cast<uint32_t>(outputChannels);
+
+  const SimdLevel level = dspKernels().level;
+  const SampleConverter* reader = sampleConverterFor(info.format, level);
+  const SampleConverter* writer = sampleConverterFor(job.keepFormat ? info.format : job.outputFormat, level);
+  if (!reader || !writer) {
+    result.error = "Format d'échantillon non supporté";
+    return result;
+  }
+
+  const uint64_t dataBytes = info.frames * writer->bytesPerSample * static_cast<uint64_t>(outputChannels);
+  if (dataBytes > 0xffffffffull - 36) {
+    result.error = "Fichier de sortie trop volumineux pour le format WAV (4 Go)";
+    return result;
+  }
+  MappedFile output;
+  if (!output.create(job.output, kWavHeaderSize + dataBytes, &result.error)) {
+    return result;
+  }
+  writeWavHeader(output.data(), writer->format, writer->bytesPerSample, static_cast<uint32_t>(outputChannels),
+                 static_cast<uint32_t>(info.sampleRate), dataBytes);
+
+  // Même chaîne que le callback, configurée comme au démarrage
+  const size_t block = job.blockSize;
+  ProcessingChain chain;
+  chain.configure(settings, info.sampleRate, block);
+  RoutingMatrix& routing = chain.routing();
+  const std::vector<long>& inputs = routing.inputChannels();
+
+  // Plan de chaque canal de sortie du fichier (-1 : canal non routé, silence)
+  std::vector<long> outputSlots(static_cast<size_t>(outputChannels), -1);
+  for (size_t slot = 0; slot < routing.outputChannels().size(); slot++) {
+    outputSlots[static_cast<size_t>(routing.outputChannels()[slot])] = static_cast<long>(slot);
+  }
+
+  // Blocs entrelacés convertis d'un seul appel, puis répartis dans les plans
+  AlignedBuffer<float> interleavedIn(block * info.channels);
+  AlignedBuffer<float> interleavedOut(block * static_cast<size_t>(outputChannels));
+  const uint8_t* source = input.data() + info.dataOffset;
+  uint8_t* destination = output.data() + kWavHeaderSize;
+  const size_t inFrameBytes = reader->bytesPerSample * info.channels;
+  const size_t outFrameBytes = writer->bytesPerSample * static_cast<size_t>(outputChannels);
+
+  const auto start = std::chrono::steady_clock::now();
+  long index = 0;
+  for (uint64_t position = 0; position < info.frames; position += block, index++) {
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(block, info.frames - position));
+    const long half = index & 1;
+
+    reader->toFloat(source + position * inFrameBytes, interleavedIn.data(), count * info.channels);
+    for (size_t slot = 0; slot < inputs.size(); slot++) {
+      float* plane = routing.inputPlane(half, slot);
+      const float* from = interleavedIn.data() + inputs[slot];
+      for (size_t i = 0; i < count; i++) {
+        plane[i] = from[i * info.channels];
+      }
+      // Dernier bloc incomplet : complété par du silence
+      std::fill(plane + count, plane + block, 0.0f);
+    }
+
+    chain.process(half);
+
+    for (size_t channel = 0; channel < outputSlots.size(); channel++) {
+      float* to = interleavedOut.data() + channel;
+      if (outputSlots[channel] < 0) {
+        for (size_t i = 0; i < count; i++) {
+          to[i * outputSlots.size()] = 0.0f;
+        }
+      } else {
+        const float* plane = routing.outputPlane(half, static_cast<size_t>(outputSlots[channel]));
+        for (size_t i = 0; i < count; i++) {
+          to[i * outputSlots.size()] = plane[i];
+        }
+      }
+    }
+    writer->fromFloat(interleavedOut.data(), destination + position * outFrameBytes, count * outputSlots.size());
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  result.realtimeFactor = result.seconds > 0.0 ? (info.frames / info.sampleRate) / result.seconds : 0.0;
+  result.success = true;
+  return result;
+}
+
+std::vector<OfflineResult> processFiles(const std::vector<OfflineJob>& jobs, unsigned threads) {
+  std::vector<OfflineResult> results(jobs.size());
+  unsigned workers = threads;
+  if (workers == 0) {
+    workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  workers = static_cast<unsigned>(std::min<size_t>(workers, jobs.size()));
+
+  // Chaque thread prend le fichier suivant jusqu'à épuisement du lot
+  std::atomic<size_t> next{0};
+  auto work = [&]() {
+    for (size_t i = next.fetch_add(1); i < jobs.size(); i = next.fetch_add(1)) {
+      results[i] = processFile(jobs[i]);
+    }
+  };
+  if (workers <= 1) {
+    work();
+    return results;
+  }
+  std::vector<std::thread> pool;
+  pool.reserve(workers);
+  for (unsigned i = 0; i < workers; i++) {
+    pool.emplace_back(work);
+  }
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  return results;
+}
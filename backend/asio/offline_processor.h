@@ -0,0 +1,92 @@
+#ifndef __offline_processor__
+#define __offline_processor__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "processing_chain.h"
+#include "sample_format.h"
+
+// Fichier projeté en mémoire : lecture seule, ou création en lecture/écriture
+// à une taille fixée d'avance. Les pages sont lues et écrites par le système à
+// la demande, sans copie intermédiaire.
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool openRead(const std::string& path, std::string* error);
+  bool create(const std::string& path, uint64_t size, std::string* error);
+  void close();
+
+  // Vrai si path désigne le fichier ouvert (même volume et même inode / index,
+  // liens et chemins relatifs compris) ; faux si path n'existe pas
+  bool sameFile(const std::string& path) const;
+
+  const uint8_t* data() const { return bytes; }
+  uint8_t* data() { return bytes; }
+  uint64_t size() const { return length; }
+
+private:
+  uint8_t* bytes = nullptr;
+  uint64_t length = 0;
+#ifdef _WIN32
+  void* file = nullptr;
+  void* mapping = nullptr;
+#else
+  int fd = -1;
+#endif
+};
+
+// Description d'un fichier WAV (PCM 16/24/32 bits ou float 32/64 bits, entrelacé)
+struct WavInfo {
+  SampleFormat format;    // formats petit-boutistes ASIO équivalents (Int16LSB, ...)
+  uint32_t channels;
+  double sampleRate;
+  uint64_t frames;
+  uint64_t dataOffset;    // début des échantillons dans le fichier
+};
+
+// Lecture de l'en-tête RIFF/WAVE (fmt, WAVE_FORMAT_EXTENSIBLE compris)
+bool parseWav(const uint8_t* data, uint64_t size, WavInfo* info, std::string* error);
+
+// Traitement d'un fichier : chaque canal du fichier d'entrée joue le rôle d'une
+// entrée du pilote, chaque canal du fichier de sortie celui d'une sortie
+struct OfflineJob {
+  std::string input;
+  std::string output;
+  ChainSettings settings;     // routes vides : 1re entrée -> 1re sortie
+  size_t blockSize = 1024;    // taille de bloc simulée (celle du pilote à reproduire)
+  bool keepFormat = true;     // sortie au format de l'entrée, sinon outputFormat
+  SampleFormat outputFormat = SampleFormat::Float32LSB;
+  long outputChannels = 0;    // 0 : dernière sortie routée + 1
+};
+
+struct OfflineResult {
+  bool success = false;
+  std::string error;
+  uint64_t frames = 0;
+  uint32_t inputChannels = 0;
+  uint32_t outputChannels = 0;
+  double sampleRate = 0.0;
+  double seconds = 0.0;         // durée du traitement
+  double realtimeFactor = 0.0;  // durée audio / durée du traitement
+};
+
+// Traite un fichier aussi vite que le processeur le permet, avec la même chaîne
+// (ProcessingChain) et les mêmes convertisseurs que le callback ASIO
+OfflineResult processFile(const OfflineJob& job);
+
+// Traite un lot de fichiers, chacun avec sa propre chaîne.
+// threads : nombre de fichiers traités en parallèle (1 : séquentiel, 0 : un thread
+// par fichier dans la limite des cœurs disponibles). Résultats dans l'ordre des tâches.
+std::vector<OfflineResult> processFiles(const std::vector<OfflineJob>& jobs, unsigned threads);
+
+// Format de sortie par nom ("int16", "int24", "int32", "float32", "float64")
+bool offlineFormatFromName(const std::string& name, SampleFormat* format);
+
+#endif
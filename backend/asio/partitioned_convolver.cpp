@@ -0,0 +1,94 @@
+#include "partitioned_convolver.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "dsp_kernels.h"
+
+void PartitionedConvolver::configure(size_t blockSize, const float* impulse, size_t length) {
+  block = std::max<size_t>(blockSize, 1);
+  taps = std::max<size_t>(length, 1);
+  partitions = (taps + block - 1) / block;
+  bins = block + 1;
+  stride = paddedLength(bins);
+
+  plan = FFTPlan::get(2 * block);
+  plan->prepare(workspace);
+
+  filterRe.resize(partitions * stride);
+  filterIm.resize(partitions * stride);
+  spectraRe.resize(partitions * stride);
+  spectraIm.resize(partitions * stride);
+  accRe.resize(bins);
+  accIm.resize(bins);
+  frame.resize(2 * block);
+  timeScratch.resize(2 * block);
+
+  // H_p = FFT([h_p, 0]) : la seconde moitié nulle rend la convolution circulaire linéaire
+  activePartitions.clear();
+  for (size_t p = 0; p < partitions; p++) {
+    timeScratch.zero();
+    const size_t begin = p * block;
+    const size_t count = impulse && begin < length ? std::min(block, length - begin) : 0;
+    bool nonZero = false;
+    for (size_t i = 0; i < count; i++) {
+      timeScratch[i] = impulse[begin + i];
+      nonZero = nonZero || impulse[begin + i] != 0.0f;
+    }
+    if (nonZero) {
+      plan->forward(timeScratch.data(), filterRe.data() + p * stride, filterIm.data() + p * stride, workspace);
+      activePartitions.push_back(p);
+    }
+  }
+
+  reset();
+}
+
+void PartitionedConvolver::reset() {
+  spectraRe.zero();
+  spectraIm.zero();
+  frame.zero();
+  head = 0;
+}
+
+void PartitionedConvolver::process(const float* input, float* output) {
+  if (partitions == 0) {
+    return;
+  }
+
+  // Trame [bloc précédent, bloc courant] transformée une seule fois, en tête de FDL
+  head = head + 1 == partitions ? 0 : head + 1;
+  std::memmove(frame.data(), frame.data() + block, block * sizeof(float));
+  std::memcpy(frame.data() + block, input, block * sizeof(float));
+  plan->forward(frame.data(), spectraRe.data() + slotOf(0), spectraIm.data() + slotOf(0), workspace);
+
+  // Somme des produits H_p * X_(k-p) puis une seule FFT inverse
+  const DspKernels& kernels = dspKernels();
+  accRe.zero();
+  accIm.zero();
+  for (size_t p : activePartitions) {
+    kernels.complexMulAdd(spectraRe.data() + slotOf(p), spectraIm.data() + slotOf(p),
+                          filterRe.data() + p * stride, filterIm.data() + p * stride,
+                          accRe.data(), accIm.data(), stride);
+  }
+  plan->inverse(accRe.data(), accIm.data(), timeScratch.data(), workspace);
+
+  // Overlap-save : seule la seconde moitié est exempte de repliement
+  std::memcpy(output, timeScratch.data() + block, block * sizeof(float));
+}
+
+void PartitionedConvolver::memoryRegions(std::vector<MemoryRegion>& regions, const char* name) const {
+  appendRegion(regions, name, filterRe);
+  appendRegion(regions, name, filterIm);
+  appendRegion(regions, name, spectraRe);
+  appendRegion(regions, name, spectraIm);
+  appendRegion(regions, name, accRe);
+  appendRegion(regions, name, accIm);
+  appendRegion(regions, name, frame);
+  appendRegion(regions, name, timeScratch);
+  appendRegion(regions, name, activePartitions);
+  appendRegion(regions, name, workspace.re);
+  appendRegion(regions, name, workspace.im);
+  appendRegion(regions, name, workspace.tmpRe);
+  appendRegion(regions, name, workspace.tmpIm);
+}
@@ -0,0 +1,60 @@
+#ifndef __partitioned_convolver__
+#define __partitioned_convolver__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "fft_engine.h"
+
+// Convolution FIR à partitions uniformes, overlap-save (UPOLS)
+// - la réponse impulsionnelle de M taps est découpée en P = M/B partitions de la
+//   taille du bloc ASIO ; chaque partition est transformée une fois (FFT de 2B points)
+// - chaque bloc d'entrée est transformé une seule fois et rangé dans une ligne à
+//   retard fréquentielle (FDL) ; la sortie est la somme des produits H_p * X_(k-p),
+//   suivie d'une seule FFT inverse
+// - les partitions entièrement nulles (retards purs) sont ignorées
+//
+// Coût par bloc : 2 FFT + P produits complexes par bin, contre B * M multiplications
+// en forme directe. Aucune latence au-delà du bloc lui-même.
+class PartitionedConvolver {
+public:
+  // À l'arrêt : découpe et transforme la réponse impulsionnelle (allocation)
+  void configure(size_t blockSize, const float* impulse, size_t length);
+
+  // À l'arrêt : vide l'historique
+  void reset();
+
+  size_t blockSize() const { return block; }
+  size_t length() const { return taps; }
+  size_t partitionCount() const { return partitions; }
+
+  // Côté callback : un bloc de blockSize échantillons, sans allocation ni verrou.
+  // input et output peuvent être confondus.
+  void process(const float* input, float* output);
+
+  // Plages utilisées par process() (verrouillage en mémoire), libellées `name`
+  void memoryRegions(std::vector<MemoryRegion>& regions, const char* name) const;
+
+private:
+  size_t slotOf(size_t p) const { return ((head + partitions - p) % partitions) * stride; }
+
+  size_t block = 0;
+  size_t taps = 0;
+  size_t partitions = 0;
+  size_t bins = 0;
+  size_t stride = 0;
+  size_t head = 0;
+
+  std::shared_ptr<const FFTPlan> plan;
+  FFTWorkspace workspace;
+
+  AlignedBuffer<float> filterRe, filterIm;    // H_p, [partition][bin]
+  AlignedBuffer<float> spectraRe, spectraIm;  // FDL des trames d'entrée
+  AlignedBuffer<float> accRe, accIm;
+  AlignedBuffer<float> frame, timeScratch;
+  std::vector<size_t> activePartitions;       // partitions non nulles
+};
+
+#endif
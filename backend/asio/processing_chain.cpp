@@ -0,0 +1,58 @@
+#include "processing_chain.h"
+
+ProcessingChain::ProcessingChain() : gain(-1.0f) {}
+
+void ProcessingChain::configureRouting(const std::vector<Route>& routes, size_t newBlockSize) {
+  matrix.configure(routes, newBlockSize);
+  blockSize = newBlockSize;
+  currentMode = ProcessingMode::Inversion;
+}
+
+void ProcessingChain::configure(const ChainSettings& settings, double sampleRate, size_t newBlockSize) {
+  blockSize = newBlockSize;
+  if (settings.mode == ProcessingMode::Fxlms) {
+    matrix.configure(settings.routes, blockSize, std::vector<long>(1, settings.errorChannel));
+    errorSlot = matrix.inputSlot(settings.errorChannel);
+    routeGain = settings.routes[0].gain;
+    fxlms.configure(blockSize, settings.fxlms);
+    antiNoise.resize(blockSize);
+  } else {
+    matrix.configure(settings.routes, blockSize);
+  }
+  currentMode = settings.mode;
+
+  gain.configure(sampleRate, blockSize, settings.rampMs, settings.rampShape);
+  gain.setTarget(-settings.gain);
+  gain.reset();
+}
+
+void ProcessingChain::reset() {
+  if (currentMode == ProcessingMode::Fxlms) {
+    fxlms.reset();
+  }
+  gain.reset();
+}
+
+void ProcessingChain::process(long half) {
+  // Gain lu une fois par bloc et interpolé dans le bloc
+  const BlockRamp ramp = gain.nextRamp(blockSize);
+
+  if (currentMode == ProcessingMode::Fxlms) {
+    // Anti-bruit adaptatif calculé à partir de la référence et du micro d'erreur ;
+    // le gain (négatif pour l'inversion) ne fait ici que doser le niveau de sortie,
+    // avec le gain de la route comme en mode inversion
+    fxlms.process(matrix.inputPlane(half, 0), matrix.inputPlane(half, errorSlot), antiNoise.data());
+    ramp.apply(antiNoise.data(), matrix.outputPlane(half, 0), -routeGain);
+  } else {
+    // Inversion de phase de tous les canaux routés, chaque sortie en une passe
+    matrix.process(half, ramp);
+  }
+}
+
+void ProcessingChain::memoryRegions(std::vector<MemoryRegion>& regions) const {
+  matrix.memoryRegions(regions);
+  if (currentMode == ProcessingMode::Fxlms) {
+    fxlms.memoryRegions(regions);
+    appendRegion(regions, "fxlms", antiNoise);
+  }
+}
@@ -0,0 +1,76 @@
+#ifndef __processing_chain__
+#define __processing_chain__
+
+#include <cstddef>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "fxlms_canceller.h"
+#include "routing_matrix.h"
+#include "smoothed_parameter.h"
+
+// Mode de traitement
+enum class ProcessingMode { Inversion, Fxlms };
+
+// Paramètres complets de la chaîne (routes déjà validées ; une seule route en mode fxlms)
+struct ChainSettings {
+  ProcessingMode mode = ProcessingMode::Inversion;
+  std::vector<Route> routes;
+  long errorChannel = -1;     // fxlms : canal du micro d'erreur (capturé sans être routé)
+  FxlmsConfig fxlms;
+  float gain = 1.0f;          // facteur d'inversion : sortie = -gain * entrée
+  double rampMs = 20.0;
+  RampShape rampShape = RampShape::Linear;
+};
+
+// Chaîne DSP d'un bloc, indépendante de la source des échantillons
+// Les plans float de la matrice de routage sont remplis par l'appelant (buffers du
+// pilote ASIO, fichier WAV...), process() calcule les plans de sortie de la même
+// moitié du double buffer. Le callback ASIO et le traitement hors ligne exécutent
+// ainsi exactement le même code.
+class ProcessingChain {
+public:
+  ProcessingChain();
+
+  // À l'arrêt : routage seul, en mode inversion (gain inchangé)
+  void configureRouting(const std::vector<Route>& routes, size_t blockSize);
+
+  // À l'arrêt : chaîne complète, gain positionné sans rampe
+  void configure(const ChainSettings& settings, double sampleRate, size_t blockSize);
+
+  // À l'arrêt : remet le filtre adaptatif et le gain à leur état initial
+  void reset();
+
+  RoutingMatrix& routing() { return matrix; }
+  const RoutingMatrix& routing() const { return matrix; }
+  ProcessingMode mode() const { return currentMode; }
+  const FxlmsCanceller& canceller() const { return fxlms; }
+
+  // Gain appliqué en sortie (négatif : inversion de phase), modifiable depuis n'importe quel thread
+  SmoothedParameter& outputGain() { return gain; }
+
+  // Côté callback : traite un bloc de la moitié half, sans allocation ni verrou
+  void process(long half);
+
+  // Plages utilisées par process() dans le mode courant (verrouillage en mémoire)
+  void memoryRegions(std::vector<MemoryRegion>& regions) const;
+
+  // Plan sur lequel portent les analyses (première entrée routée)
+  const float* analysisInput(long half) const { return matrix.inputPlane(half, 0); }
+
+private:
+  RoutingMatrix matrix;
+  ProcessingMode currentMode = ProcessingMode::Inversion;
+  size_t blockSize = 0;
+
+  // Mode adaptatif : l'unique route définit référence -> haut-parleur et son gain,
+  // errorSlot désigne le plan du micro d'erreur
+  FxlmsCanceller fxlms;
+  AlignedBuffer<float> antiNoise;
+  size_t errorSlot = 0;
+  float routeGain = 1.0f;
+
+  SmoothedParameter gain;
+};
+
+#endif
@@ -0,0 +1,260 @@
+#include "realtime_thread.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// Pile touchée par le thread de traitement avant son premier bloc
+static const size_t kStackPrefaultBytes = 128 * 1024;
+static const size_t kPageBytes = 4096;
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#elif defined(_MSC_VER)
+__declspec(noinline)
+#endif
+static size_t prefaultStack() {
+  volatile unsigned char stack[kStackPrefaultBytes];
+  for (size_t i = 0; i < kStackPrefaultBytes; i += kPageBytes) {
+    stack[i] = 0;
+  }
+#if defined(__GNUC__)
+  // Tableau utilisé aux yeux du compilateur : ni avertissement ni écritures supprimées
+  asm volatile("" : : "r"(stack) : "memory");
+#endif
+  return kStackPrefaultBytes;
+}
+
+int realtimeCpuCount() {
+  return static_cast<int>(std::thread::hardware_concurrency());
+}
+
+RealtimeThreadReport applyRealtimeThread(const RealtimeOptions& options) {
+  RealtimeThreadReport report;
+
+#ifdef _WIN32
+  // Pas d'équivalent direct de SCHED_FIFO : priorité la plus haute de la classe du processus
+  if (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+    report.priorityApplied = true;
+  } else {
+    report.priorityError = "SetThreadPriority a échoué (erreur " + std::to_string(GetLastError()) + ")";
+  }
+  if (options.cpu >= 0) {
+    if (options.cpu < static_cast<int>(8 * sizeof(DWORD_PTR)) &&
+        SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << options.cpu) != 0) {
+      report.affinityApplied = true;
+    } else {
+      report.affinityError = "SetThreadAffinityMask a échoué pour le cœur " + std::to_string(options.cpu);
+    }
+  }
+#else
+  sched_param param = {};
+  param.sched_priority = options.priority;
+  const int priorityResult = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+  if (priorityResult == 0) {
+    report.priorityApplied = true;
+  } else {
+    report.priorityError = std::string("SCHED_FIFO refusé : ") + std::strerror(priorityResult);
+  }
+  if (options.cpu >= 0) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(options.cpu, &set);
+    const int affinityResult = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (affinityResult == 0) {
+      report.affinityApplied = true;
+    } else {
+      report.affinityError = "Affinité refusée pour le cœur " + std::to_string(options.cpu) + " : " +
+                             std::strerror(affinityResult);
+    }
+#else
+    report.affinityError = "Affinité non supportée sur cette plateforme";
+#endif
+  }
+#endif
+
+  report.stackPrefaulted = prefaultStack();
+  return report;
+}
+
+#ifdef __linux__
+// VmLck de /proc/self/status, en octets
+static size_t lockedProcessBytes() {
+  FILE* status = std::fopen("/proc/self/status", "r");
+  if (status == nullptr) {
+    return 0;
+  }
+  char line[256];
+  unsigned long kilobytes = 0;
+  while (std::fgets(line, sizeof(line), status) != nullptr) {
+    if (std::sscanf(line, "VmLck: %lu kB", &kilobytes) == 1) {
+      break;
+    }
+  }
+  std::fclose(status);
+  return static_cast<size_t>(kilobytes) * 1024;
+}
+#endif
+
+// Pages verrouillées par lockMemoryRegions : nombre de plages qui les retiennent
+static std::mutex regionMutex;
+static std::map<uintptr_t, size_t> pageHolders;
+
+static uintptr_t pageSize() {
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return static_cast<uintptr_t>(info.dwPageSize);
+#else
+  const long size = sysconf(_SC_PAGESIZE);
+  return size > 0 ? static_cast<uintptr_t>(size) : kPageBytes;
+#endif
+}
+
+static bool lockPages(uintptr_t begin, uintptr_t end, std::string* error) {
+#ifdef _WIN32
+  if (VirtualLock(reinterpret_cast<void*>(begin), end - begin)) {
+    return true;
+  }
+  *error = "VirtualLock a échoué (erreur " + std::to_string(GetLastError()) + ")";
+#else
+  if (mlock(reinterpret_cast<const void*>(begin), end - begin) == 0) {
+    return true;
+  }
+  *error = std::string("mlock a échoué : ") + std::strerror(errno);
+#endif
+  return false;
+}
+
+static void unlockPages(uintptr_t begin, uintptr_t end) {
+#ifdef _WIN32
+  VirtualUnlock(reinterpret_cast<void*>(begin), end - begin);
+#else
+  munlock(reinterpret_cast<const void*>(begin), end - begin);
+#endif
+}
+
+void lockMemoryRegions(const std::vector<MemoryRegion>& regions, std::vector<MemoryRegion>* locked,
+                       RealtimeMemoryReport* report) {
+  std::lock_guard<std::mutex> lock(regionMutex);
+  const uintptr_t page = pageSize();
+  report->locked = true;
+  for (const MemoryRegion& region : regions) {
+    // Une entrée du rapport par libellé
+    RealtimeRegionReport* entry = nullptr;
+    for (RealtimeRegionReport& candidate : report->regions) {
+      if (candidate.name == region.name) {
+        entry = &candidate;
+      }
+    }
+    if (entry == nullptr) {
+      report->regions.push_back(RealtimeRegionReport());
+      entry = &report->regions.back();
+      entry->name = region.name;
+      entry->locked = true;
+    }
+    entry->bytes += region.bytes;
+    
+    const uintptr_t address = reinterpret_cast<uintptr_t>(region.data);
+    const uintptr_t begin = address & ~(page - 1);
+    const uintptr_t end = (address + region.bytes + page - 1) & ~(page - 1);
+    std::string error;
+    if (!lockPages(begin, end, &error)) {
+      entry->locked = false;
+      report->locked = false;
+      if (report->error.empty()) {
+        report->error = error + " (" + region.name + ")";
+      }
+      continue;
+    }
+    for (uintptr_t p = begin; p < end; p += page) {
+      pageHolders[p]++;
+    }
+    
+    // Une lecture par page : chargée maintenant plutôt qu'au premier bloc
+    const volatile unsigned char* bytes = static_cast<const volatile unsigned char*>(region.data);
+    for (size_t offset = 0; offset < region.bytes; offset += page) {
+      static_cast<void>(bytes[offset]);
+    }
+    locked->push_back(region);
+    report->lockedBytes += region.bytes;
+  }
+}
+
+void unlockMemoryRegions(const std::vector<MemoryRegion>& locked) {
+  std::lock_guard<std::mutex> lock(regionMutex);
+  const uintptr_t page = pageSize();
+  for (const MemoryRegion& region : locked) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(region.data);
+    const uintptr_t begin = address & ~(page - 1);
+    const uintptr_t end = (address + region.bytes + page - 1) & ~(page - 1);
+    
+    // Pages libérées par leur dernier détenteur, déverrouillées par plages contiguës
+    uintptr_t runBegin = 0;
+    uintptr_t runEnd = 0;
+    for (uintptr_t p = begin; p < end; p += page) {
+      auto holder = pageHolders.find(p);
+      if (holder == pageHolders.end() || --holder->second > 0) {
+        continue;
+      }
+      pageHolders.erase(holder);
+      if (runEnd != p) {
+        if (runEnd != runBegin) {
+          unlockPages(runBegin, runEnd);
+        }
+        runBegin = p;
+      }
+      runEnd = p + page;
+    }
+    if (runEnd != runBegin) {
+      unlockPages(runBegin, runEnd);
+    }
+  }
+}
+
+void lockProcessMemory(RealtimeMemoryReport* report) {
+#ifdef _WIN32
+  report->processError = "Verrouillage de la mémoire du processus non supporté sous Windows";
+#else
+  rlimit limit = {};
+  report->future = getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur == RLIM_INFINITY;
+  if (mlockall(MCL_CURRENT | (report->future ? MCL_FUTURE : 0)) == 0) {
+    report->processLocked = true;
+  } else {
+    report->future = false;
+    report->processError = std::string("mlockall a échoué : ") + std::strerror(errno);
+  }
+#ifdef __linux__
+  report->processLockedBytes = lockedProcessBytes();
+#endif
+#endif
+}
+
+void unlockProcessMemory() {
+#ifndef _WIN32
+  // munlockall déverrouille aussi les régions des moteurs : celles encore détenues
+  // sont reverrouillées
+  std::lock_guard<std::mutex> lock(regionMutex);
+  munlockall();
+  const uintptr_t page = pageSize();
+  std::string error;
+  for (const auto& holder : pageHolders) {
+    lockPages(holder.first, holder.first + page, &error);
+  }
+#endif
+}
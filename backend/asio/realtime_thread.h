@@ -0,0 +1,71 @@
+#ifndef __realtime_thread__
+#define __realtime_thread__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "aligned_buffer.h"
+
+// Réglages temps réel du thread de traitement et de la mémoire du moteur
+// Linux : SCHED_FIFO, pthread_setaffinity_np, mlock. Windows : priorité
+// THREAD_PRIORITY_TIME_CRITICAL, SetThreadAffinityMask et VirtualLock.
+// Chaque réglage peut échouer (droits insuffisants, RLIMIT_MEMLOCK) sans empêcher le
+// traitement : les rapports indiquent ce qui a effectivement été appliqué.
+struct RealtimeOptions {
+  bool enabled = false;
+  int priority = 80;        // priorité SCHED_FIFO (1 à 99)
+  int cpu = -1;             // cœur du thread de traitement, -1 : pas d'affinité
+  bool lockMemory = true;   // régions du moteur verrouillées en mémoire et chargées
+  bool lockProcess = false; // en plus, tout le processus (mlockall), sur demande explicite
+};
+
+struct RealtimeThreadReport {
+  bool priorityApplied = false;
+  std::string priorityError;
+  bool affinityApplied = false;
+  std::string affinityError;
+  size_t stackPrefaulted = 0; // octets de pile touchés avant le premier bloc
+};
+
+struct RealtimeRegionReport {
+  std::string name;
+  size_t bytes = 0;           // octets des plages de la région
+  bool locked = false;        // toutes ses plages verrouillées
+};
+
+struct RealtimeMemoryReport {
+  bool locked = false;        // toutes les régions du moteur verrouillées
+  std::string error;          // premier échec de verrouillage
+  size_t lockedBytes = 0;     // octets des régions verrouillées
+  std::vector<RealtimeRegionReport> regions;
+
+  // mlockall (option lockProcess)
+  bool processLocked = false;
+  bool future = false;        // allocations suivantes verrouillées aussi (MCL_FUTURE)
+  std::string processError;
+  size_t processLockedBytes = 0; // mémoire verrouillée du processus (VmLck), 0 si inconnue
+};
+
+// Thread appelant, avant son premier bloc : priorité, affinité, pile préchargée
+RealtimeThreadReport applyRealtimeThread(const RealtimeOptions& options);
+
+// Verrouille (mlock) les pages de chaque plage et les touche une à une : plus de défaut
+// de page ni d'échange sur disque pendant le traitement. Les plages effectivement
+// verrouillées sont ajoutées à `locked`, à rendre par unlockMemoryRegions.
+// Les verrous ne se cumulent pas au niveau du système : les pages partagées entre plages
+// ou entre moteurs sont comptées et ne sont déverrouillées qu'au dernier détenteur.
+void lockMemoryRegions(const std::vector<MemoryRegion>& regions, std::vector<MemoryRegion>* locked,
+                       RealtimeMemoryReport* report);
+void unlockMemoryRegions(const std::vector<MemoryRegion>& locked);
+
+// Verrouille toutes les pages actuelles du processus (mlockall). Les pages futures ne
+// sont verrouillées que si RLIMIT_MEMLOCK est illimité : sinon le tas de Node pourrait
+// ne plus pouvoir grandir. unlockProcessMemory conserve les régions encore détenues.
+void lockProcessMemory(RealtimeMemoryReport* report);
+void unlockProcessMemory();
+
+// Nombre de cœurs connus (0 si inconnu)
+int realtimeCpuCount();
+
+#endif
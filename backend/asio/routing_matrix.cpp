@@ -0,0 +1,127 @@
+#include "routing_matrix.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "dsp_kernels.h"
+
+namespace {
+
+size_t slotOf(std::vector<long>& channels, long channel) {
+  std::vector<long>::iterator it = std::find(channels.begin(), channels.end(), channel);
+  if (it != channels.end()) {
+    return static_cast<size_t>(it - channels.begin());
+  }
+  channels.push_back(channel);
+  return channels.size() - 1;
+}
+
+} // namespace
+
+size_t RoutingMatrix::inputSlot(long channel) const {
+  return static_cast<size_t>(std::find(inputs.begin(), inputs.end(), channel) - inputs.begin());
+}
+
+void RoutingMatrix::configure(const std::vector<Route>& newRoutes, size_t blockSize,
+                              const std::vector<long>& extraInputs) {
+  routeList = newRoutes;
+  inputs.clear();
+  outputs.clear();
+  ops.clear();
+
+  // Attribuer un plan à chaque canal utilisé
+  std::vector<Op> linked;
+  linked.reserve(routeList.size());
+  for (const Route& route : routeList) {
+    Op op;
+    op.kind = OpKind::Assign;
+    op.input = static_cast<uint32_t>(slotOf(inputs, route.input));
+    op.output = static_cast<uint32_t>(slotOf(outputs, route.output));
+    op.gain = route.gain;
+    linked.push_back(op);
+  }
+
+  for (long channel : extraInputs) {
+    slotOf(inputs, channel);
+  }
+
+  // Regrouper les routes par sortie pour que chaque plan de sortie soit écrit d'un seul tenant
+  std::stable_sort(linked.begin(), linked.end(),
+                   [](const Op& a, const Op& b) { return a.output < b.output; });
+
+  for (size_t begin = 0; begin < linked.size();) {
+    size_t end = begin;
+    while (end < linked.size() && linked[end].output == linked[begin].output) {
+      end++;
+    }
+
+    // Les routes de gain nul ne coûtent rien
+    std::vector<Op> active;
+    for (size_t i = begin; i < end; i++) {
+      if (linked[i].gain != 0.0f) {
+        active.push_back(linked[i]);
+      }
+    }
+
+    if (active.empty()) {
+      Op clear = linked[begin];
+      clear.kind = OpKind::Clear;
+      ops.push_back(clear);
+    } else if (active.size() == 1) {
+      active[0].kind = OpKind::RampWrite;
+      ops.push_back(active[0]);
+    } else {
+      for (size_t i = 0; i < active.size(); i++) {
+        active[i].kind = i == 0 ? OpKind::Assign : OpKind::Accumulate;
+        ops.push_back(active[i]);
+      }
+      Op finish = active[0];
+      finish.kind = OpKind::RampInPlace;
+      ops.push_back(finish);
+    }
+    begin = end;
+  }
+
+  // Plans contigus : stride multiple de kKernelBlock, donc chaque plan reste aligné
+  stride = paddedLength(blockSize);
+  for (int half = 0; half < 2; half++) {
+    inputPlanes[half].resize(stride * inputs.size());
+    outputPlanes[half].resize(stride * outputs.size());
+  }
+}
+
+void RoutingMatrix::process(long half, const BlockRamp& ramp) {
+  const DspKernels& kernels = dspKernels();
+  const float* in = inputPlanes[half & 1].data();
+  float* out = outputPlanes[half & 1].data();
+
+  for (const Op& op : ops) {
+    const float* source = in + op.input * stride;
+    float* destination = out + op.output * stride;
+    switch (op.kind) {
+      case OpKind::RampWrite:
+        ramp.apply(source, destination, op.gain);
+        break;
+      case OpKind::Assign:
+        kernels.scale(source, destination, stride, op.gain);
+        break;
+      case OpKind::Accumulate:
+        kernels.mulAdd(source, destination, stride, op.gain);
+        break;
+      case OpKind::RampInPlace:
+        ramp.apply(destination, destination);
+        break;
+      case OpKind::Clear:
+        std::memset(destination, 0, stride * sizeof(float));
+        break;
+    }
+  }
+}
+
+void RoutingMatrix::memoryRegions(std::vector<MemoryRegion>& regions) const {
+  for (long half = 0; half < 2; half++) {
+    appendRegion(regions, "planes", inputPlanes[half]);
+    appendRegion(regions, "planes", outputPlanes[half]);
+  }
+  appendRegion(regions, "planes", ops);
+}
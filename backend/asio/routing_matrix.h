@@ -0,0 +1,77 @@
+#ifndef __routing_matrix__
+#define __routing_matrix__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "aligned_buffer.h"
+#include "smoothed_parameter.h"
+
+// Une liaison entrée -> sortie (numéros de canaux ASIO, à partir de 0)
+struct Route {
+  long input;
+  long output;
+  float gain;
+};
+
+// Matrice de routage N entrées -> M sorties
+// Les canaux actifs sont stockés en plans contigus (un plan par canal, aligné sur
+// une ligne de cache et rembourré à kKernelBlock), doublés pour le double buffering ASIO.
+// configure() compile les routes en une liste d'opérations triée par sortie :
+// le callback exécute cette liste d'une traite, sans recherche ni branchement par canal.
+class RoutingMatrix {
+public:
+  // À l'arrêt : routes déjà validées (canaux existants, pas de doublon).
+  // extraInputs : entrées capturées sans être routées (ex. micro d'erreur)
+  void configure(const std::vector<Route>& newRoutes, size_t blockSize,
+                 const std::vector<long>& extraInputs = std::vector<long>());
+
+  const std::vector<Route>& routes() const { return routeList; }
+
+  // Canaux ASIO actifs, dans l'ordre des plans (ordre de première apparition)
+  const std::vector<long>& inputChannels() const { return inputs; }
+  const std::vector<long>& outputChannels() const { return outputs; }
+
+  // Index du plan d'une entrée active
+  size_t inputSlot(long channel) const;
+
+  // Plan d'un canal actif pour la moitié half (0 ou 1) du double buffer
+  float* inputPlane(long half, size_t slot) { return inputPlanes[half & 1].data() + slot * stride; }
+  float* outputPlane(long half, size_t slot) { return outputPlanes[half & 1].data() + slot * stride; }
+  const float* inputPlane(long half, size_t slot) const { return inputPlanes[half & 1].data() + slot * stride; }
+
+  // Côté callback : calcule toutes les sorties de la moitié half.
+  // sortie = trajectoire de gain * somme(gain de route * entrée)
+  void process(long half, const BlockRamp& ramp);
+
+  // Plans float des deux moitiés (verrouillage en mémoire)
+  void memoryRegions(std::vector<MemoryRegion>& regions) const;
+
+private:
+  enum class OpKind : uint8_t {
+    RampWrite,   // sortie à une seule route : rampe et gain de route en une passe
+    Assign,      // première route d'un mélange : out = in * gain
+    Accumulate,  // routes suivantes : out += in * gain
+    RampInPlace, // fin de mélange : out *= rampe
+    Clear        // sortie sans route active (gain nul) : silence
+  };
+
+  struct Op {
+    OpKind kind;
+    uint32_t input;
+    uint32_t output;
+    float gain;
+  };
+
+  std::vector<Route> routeList;
+  std::vector<long> inputs;
+  std::vector<long> outputs;
+  std::vector<Op> ops;
+
+  size_t stride = 0;
+  AlignedBuffer<float> inputPlanes[2];
+  AlignedBuffer<float> outputPlanes[2];
+};
+
+#endif
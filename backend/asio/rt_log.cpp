@@ -0,0 +1,180 @@
+#include "rt_log.h"
+
+#include <cinttypes>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+const char* logLevelName(LogLevel level) {
+  switch (level) {
+    case LogLevel::Debug: return "debug";
+    case LogLevel::Info: return "info";
+    case LogLevel::Warning: return "avertissement";
+    case LogLevel::Error: return "erreur";
+  }
+  return "";
+}
+
+std::string formatLogRecord(const LogRecord& record) {
+  std::string message;
+  size_t next = 0;
+  for (const char* c = record.format; *c != '\0'; c++) {
+    if (c[0] != '{' || c[1] != '}' || next >= record.count) {
+      message += *c;
+      continue;
+    }
+    const LogArgument& argument = record.arguments[next++];
+    char number[32];
+    switch (argument.type) {
+      case LogArgument::kSigned:
+        std::snprintf(number, sizeof(number), "%" PRId64, argument.i);
+        message += number;
+        break;
+      case LogArgument::kUnsigned:
+        std::snprintf(number, sizeof(number), "%" PRIu64, argument.u);
+        message += number;
+        break;
+      case LogArgument::kReal:
+        std::snprintf(number, sizeof(number), "%g", argument.d);
+        message += number;
+        break;
+      case LogArgument::kText:
+        message += record.text + argument.offset;
+        break;
+    }
+    c++;
+  }
+  return message;
+}
+
+RtLogger::RtLogger(size_t minCapacity) {
+  size_t capacity = 2;
+  while (capacity < minCapacity) {
+    capacity <<= 1;
+  }
+  slots.reset(new Slot[capacity]);
+  mask = capacity - 1;
+  for (size_t i = 0; i < capacity; i++) {
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+RtLogger::~RtLogger() {
+  stop();
+}
+
+LogRecord* RtLogger::claim(size_t* position) {
+  size_t p = enqueuePosition.load(std::memory_order_relaxed);
+  for (;;) {
+    Slot& slot = slots[p & mask];
+    const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(p);
+    if (difference == 0) {
+      // Case libre : la réserver avant un autre producteur
+      if (enqueuePosition.compare_exchange_weak(p, p + 1, std::memory_order_relaxed)) {
+        *position = p;
+        return &slot.record;
+      }
+    } else if (difference < 0) {
+      // Case pas encore lue par le consommateur : file pleine
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    } else {
+      p = enqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void RtLogger::publish(size_t position) {
+  slots[position & mask].sequence.store(position + 1, std::memory_order_release);
+}
+
+void RtLogger::encodeText(LogRecord* record, size_t* textUsed, const char* text, size_t length) {
+  LogArgument& argument = record->arguments[record->count++];
+  argument.type = LogArgument::kText;
+
+  // Plus de place : chaîne vide (le dernier octet est le terminateur de la chaîne précédente)
+  if (*textUsed >= kLogTextBytes) {
+    argument.offset = static_cast<uint32_t>(kLogTextBytes - 1);
+    return;
+  }
+
+  // Chaîne tronquée à la place restante (terminateur compris)
+  const size_t available = kLogTextBytes - *textUsed;
+  const size_t n = length < available - 1 ? length : available - 1;
+  argument.offset = static_cast<uint32_t>(*textUsed);
+  std::memcpy(record->text + *textUsed, text, n);
+  record->text[*textUsed + n] = '\0';
+  *textUsed += n + 1;
+}
+
+size_t RtLogger::drain(const LogSink& sink) {
+  size_t count = 0;
+  for (;;) {
+    const size_t p = dequeuePosition.load(std::memory_order_relaxed);
+    Slot& slot = slots[p & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != p + 1) {
+      break;
+    }
+    const LogRecord& record = slot.record;
+    if (sink) {
+      sink(record.level, formatLogRecord(record));
+    }
+    // Case rendue aux producteurs pour le tour suivant
+    slot.sequence.store(p + mask + 1, std::memory_order_release);
+    dequeuePosition.store(p + 1, std::memory_order_relaxed);
+    count++;
+  }
+  return count;
+}
+
+void RtLogger::start(LogSink sink, int periodMs) {
+  stop();
+  drainSink = std::move(sink);
+  drainStopping = false;
+  drainThread = std::thread(&RtLogger::drainLoop, this, periodMs);
+}
+
+void RtLogger::stop() {
+  if (!drainThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(drainMutex);
+    drainStopping = true;
+  }
+  drainCondition.notify_one();
+  drainThread.join();
+}
+
+void RtLogger::drainLoop(int periodMs) {
+  // Le journal ne doit jamais prendre de temps processeur au callback audio
+#ifdef _WIN32
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(SCHED_IDLE)
+  sched_param param = {};
+  pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+
+  uint64_t reported = droppedCount();
+  bool stopping = false;
+  while (!stopping) {
+    {
+      std::unique_lock<std::mutex> lock(drainMutex);
+      drainCondition.wait_for(lock, std::chrono::milliseconds(periodMs), [this] { return drainStopping; });
+      stopping = drainStopping;
+    }
+    drain(drainSink);
+
+    const uint64_t lost = droppedCount();
+    if (lost != reported && drainSink) {
+      drainSink(LogLevel::Warning, std::to_string(lost - reported) + " message(s) du journal perdu(s) (file pleine)");
+      reported = lost;
+    }
+  }
+}
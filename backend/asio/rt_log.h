@@ -0,0 +1,154 @@
+#ifndef __rt_log__
+#define __rt_log__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+enum class LogLevel : uint8_t { Debug, Info, Warning, Error };
+
+const char* logLevelName(LogLevel level);
+
+static const size_t kMaxLogArguments = 4;
+static const size_t kLogTextBytes = 96;
+
+// Argument d'un message : entier, réel, ou texte copié dans l'enregistrement
+struct LogArgument {
+  enum Type : uint8_t { kSigned, kUnsigned, kReal, kText };
+  Type type;
+  union {
+    int64_t i;
+    uint64_t u;
+    double d;
+    uint32_t offset; // kText : début de la chaîne dans LogRecord::text
+  };
+};
+
+// Enregistrement de taille fixe : le format n'est appliqué que par le thread du journal
+// format doit être une chaîne littérale (pointeur conservé) ; chaque "{}" y est remplacé
+// par l'argument suivant. Les chaînes passées en argument sont copiées dans text et
+// tronquées si elles ne tiennent pas.
+struct LogRecord {
+  int64_t timeNs;           // horloge monotone au moment de l'appel
+  const char* format;
+  LogLevel level;
+  uint8_t count;
+  LogArgument arguments[kMaxLogArguments];
+  char text[kLogTextBytes];
+};
+
+// Message formaté (sans niveau ni horodatage)
+std::string formatLogRecord(const LogRecord& record);
+
+// Sortie des messages formatés (thread du journal uniquement)
+using LogSink = std::function<void(LogLevel level, const std::string& message)>;
+
+// Journal utilisable depuis le callback audio
+// File circulaire préallouée à plusieurs producteurs (callback, thread de contrôle, thread
+// Node) et un seul consommateur : chaque case porte un numéro de séquence qui indique si
+// elle est libre ou publiée. log() réserve une case par compare-and-swap, y copie les
+// arguments et la publie : ni allocation, ni verrou, ni appel système. Si la file est
+// pleine, le message est perdu et comptabilisé. Le formatage et l'écriture ont lieu sur
+// un thread de faible priorité qui vide la file périodiquement.
+class RtLogger {
+public:
+  explicit RtLogger(size_t minCapacity = 1024);
+  ~RtLogger();
+
+  RtLogger(const RtLogger&) = delete;
+  RtLogger& operator=(const RtLogger&) = delete;
+
+  // Côté producteurs (tout thread) : false si la file est pleine
+  template <typename... Args>
+  bool log(LogLevel level, const char* format, const Args&... args) {
+    static_assert(sizeof...(Args) <= kMaxLogArguments, "Trop d'arguments pour un message du journal");
+    size_t position;
+    LogRecord* record = claim(&position);
+    if (record == nullptr) {
+      return false;
+    }
+    record->timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+    record->format = format;
+    record->level = level;
+    record->count = 0;
+    size_t textUsed = 0;
+    int expand[] = {0, (encode(record, &textUsed, args), 0)...};
+    (void)expand;
+    publish(position);
+    return true;
+  }
+
+  // Thread du journal : vide la file toutes les periodMs millisecondes (et à l'arrêt)
+  void start(LogSink sink, int periodMs = 20);
+  void stop();
+  bool running() const { return drainThread.joinable(); }
+
+  // Côté consommateur unique (thread du journal, ou appelant si le thread n'est pas lancé)
+  size_t drain(const LogSink& sink);
+
+  size_t capacity() const { return mask + 1; }
+  uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    LogRecord record;
+  };
+
+  LogRecord* claim(size_t* position);
+  void publish(size_t position);
+  void drainLoop(int periodMs);
+
+  static void encodeText(LogRecord* record, size_t* textUsed, const char* text, size_t length);
+
+  template <typename T>
+  static void encode(LogRecord* record, size_t*, const T& value) {
+    LogArgument& argument = record->arguments[record->count++];
+    if (std::is_floating_point<T>::value) {
+      argument.type = LogArgument::kReal;
+      argument.d = static_cast<double>(value);
+    } else if (std::is_signed<T>::value) {
+      argument.type = LogArgument::kSigned;
+      argument.i = static_cast<int64_t>(value);
+    } else {
+      argument.type = LogArgument::kUnsigned;
+      argument.u = static_cast<uint64_t>(value);
+    }
+  }
+  static void encode(LogRecord* record, size_t* textUsed, const char* value) {
+    encodeText(record, textUsed, value != nullptr ? value : "(null)", value != nullptr ? std::strlen(value) : 6);
+  }
+  static void encode(LogRecord* record, size_t* textUsed, const std::string& value) {
+    encodeText(record, textUsed, value.data(), value.size());
+  }
+  template <size_t N>
+  static void encode(LogRecord* record, size_t* textUsed, const char (&value)[N]) {
+    encode(record, textUsed, static_cast<const char*>(value));
+  }
+
+  std::unique_ptr<Slot[]> slots;
+  size_t mask = 0;
+
+  // Positions sur des lignes de cache distinctes (producteurs / consommateur)
+  alignas(64) std::atomic<size_t> enqueuePosition{0};
+  alignas(64) std::atomic<size_t> dequeuePosition{0};
+  alignas(64) std::atomic<uint64_t> dropped{0};
+
+  std::thread drainThread;
+  std::mutex drainMutex;
+  std::condition_variable drainCondition;
+  bool drainStopping = false;
+  LogSink drainSink;
+};
+
+#endif
@@ -0,0 +1,422 @@
+#include "sample_format.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "simd_support.h"
+
+namespace {
+
+// --- Scalaire (repli portable et queues des versions SIMD) ---
+
+inline uint16_t swap16(uint16_t v) {
+  return static_cast<uint16_t>((v << 8) | (v >> 8));
+}
+
+inline uint32_t swap32(uint32_t v) {
+  return (v >> 24) | ((v >> 8) & 0xff00u) | ((v << 8) & 0xff0000u) | (v << 24);
+}
+
+inline uint64_t swap64(uint64_t v) {
+  return (static_cast<uint64_t>(swap32(static_cast<uint32_t>(v))) << 32) | swap32(static_cast<uint32_t>(v >> 32));
+}
+
+// Pleine échelle d'un entier de Bits bits et plus grande valeur positive représentable
+// en float (2^31 - 1 ne l'est pas : on s'arrête au float juste inférieur)
+template <int Bits>
+inline float fullScale() {
+  return static_cast<float>(1u << (Bits - 1));
+}
+
+template <int Bits>
+inline float positiveLimit() {
+  return Bits == 32 ? 2147483520.0f : fullScale<Bits>() - 1.0f;
+}
+
+// Float -> entier : mise à l'échelle, écrêtage (NaN -> minimum), arrondi au plus proche.
+// Même ordre d'opérations que les versions SIMD (max puis min, puis conversion).
+template <int Bits>
+inline int32_t quantize(float x) {
+  float v = x * fullScale<Bits>();
+  const float low = -fullScale<Bits>();
+  const float high = positiveLimit<Bits>();
+  v = v > low ? v : low;
+  v = v < high ? v : high;
+  return static_cast<int32_t>(std::lrint(v));
+}
+
+template <bool Swap>
+void int16ToFloatScalar(const void* in, float* out, size_t count) {
+  const uint16_t* src = static_cast<const uint16_t*>(in);
+  const float scale = 1.0f / fullScale<16>();
+  for (size_t i = 0; i < count; i++) {
+    const uint16_t raw = Swap ? swap16(src[i]) : src[i];
+    out[i] = static_cast<float>(static_cast<int16_t>(raw)) * scale;
+  }
+}
+
+template <bool Swap>
+void floatToInt16Scalar(const float* in, void* out, size_t count) {
+  uint16_t* dst = static_cast<uint16_t*>(out);
+  for (size_t i = 0; i < count; i++) {
+    const uint16_t raw = static_cast<uint16_t>(quantize<16>(in[i]));
+    dst[i] = Swap ? swap16(raw) : raw;
+  }
+}
+
+// Conteneur 32 bits, Bits bits significatifs alignés à droite (signe étendu)
+template <int Bits, bool Swap>
+void int32ToFloatScalar(const void* in, float* out, size_t count) {
+  const uint32_t* src = static_cast<const uint32_t*>(in);
+  const float scale = 1.0f / fullScale<Bits>();
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t raw = Swap ? swap32(src[i]) : src[i];
+    out[i] = static_cast<float>(static_cast<int32_t>(raw)) * scale;
+  }
+}
+
+template <int Bits, bool Swap>
+void floatToInt32Scalar(const float* in, void* out, size_t count) {
+  uint32_t* dst = static_cast<uint32_t*>(out);
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t raw = static_cast<uint32_t>(quantize<Bits>(in[i]));
+    dst[i] = Swap ? swap32(raw) : raw;
+  }
+}
+
+// 24 bits compacts : 3 octets par échantillon, poids faible en tête (LSB) ou en queue (MSB)
+template <bool Msb>
+void int24ToFloatScalar(const void* in, float* out, size_t count) {
+  const uint8_t* src = static_cast<const uint8_t*>(in);
+  const float scale = 1.0f / fullScale<24>();
+  for (size_t i = 0; i < count; i++, src += 3) {
+    const uint32_t b0 = Msb ? src[2] : src[0];
+    const uint32_t b1 = src[1];
+    const uint32_t b2 = Msb ? src[0] : src[2];
+    const int32_t value = static_cast<int32_t>((b0 << 8) | (b1 << 16) | (b2 << 24)) >> 8;
+    out[i] = static_cast<float>(value) * scale;
+  }
+}
+
+template <bool Msb>
+void floatToInt24Scalar(const float* in, void* out, size_t count) {
+  uint8_t* dst = static_cast<uint8_t*>(out);
+  for (size_t i = 0; i < count; i++, dst += 3) {
+    const uint32_t value = static_cast<uint32_t>(quantize<24>(in[i]));
+    dst[Msb ? 2 : 0] = static_cast<uint8_t>(value);
+    dst[1] = static_cast<uint8_t>(value >> 8);
+    dst[Msb ? 0 : 2] = static_cast<uint8_t>(value >> 16);
+  }
+}
+
+template <bool Swap>
+void float32ToFloatScalar(const void* in, float* out, size_t count) {
+  if (!Swap) {
+    std::memcpy(out, in, count * sizeof(float));
+    return;
+  }
+  const uint32_t* src = static_cast<const uint32_t*>(in);
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t raw = swap32(src[i]);
+    std::memcpy(out + i, &raw, sizeof(float));
+  }
+}
+
+template <bool Swap>
+void floatToFloat32Scalar(const float* in, void* out, size_t count) {
+  if (!Swap) {
+    std::memcpy(out, in, count * sizeof(float));
+    return;
+  }
+  uint32_t* dst = static_cast<uint32_t*>(out);
+  for (size_t i = 0; i < count; i++) {
+    uint32_t raw;
+    std::memcpy(&raw, in + i, sizeof(float));
+    dst[i] = swap32(raw);
+  }
+}
+
+template <bool Swap>
+void float64ToFloatScalar(const void* in, float* out, size_t count) {
+  const uint64_t* src = static_cast<const uint64_t*>(in);
+  for (size_t i = 0; i < count; i++) {
+    const uint64_t raw = Swap ? swap64(src[i]) : src[i];
+    double value;
+    std::memcpy(&value, &raw, sizeof(double));
+    out[i] = static_cast<float>(value);
+  }
+}
+
+template <bool Swap>
+void floatToFloat64Scalar(const float* in, void* out, size_t count) {
+  uint64_t* dst = static_cast<uint64_t*>(out);
+  for (size_t i = 0; i < count; i++) {
+    const double value = static_cast<double>(in[i]);
+    uint64_t raw;
+    std::memcpy(&raw, &value, sizeof(double));
+    dst[i] = Swap ? swap64(raw) : raw;
+  }
+}
+
+#if DSP_X86
+
+// --- SSE2 : 8 échantillons 16 bits ou 4 échantillons 32 bits par registre ---
+
+// Mise à l'échelle et écrêtage vectoriels, identiques à quantize()
+template <int Bits>
+DSP_TARGET("sse2")
+inline __m128i quantizeSse2(__m128 x) {
+  __m128 v = _mm_mul_ps(x, _mm_set1_ps(fullScale<Bits>()));
+  v = _mm_max_ps(v, _mm_set1_ps(-fullScale<Bits>()));
+  v = _mm_min_ps(v, _mm_set1_ps(positiveLimit<Bits>()));
+  return _mm_cvtps_epi32(v);
+}
+
+template <bool Swap>
+DSP_TARGET("sse2")
+void int16ToFloatSse2(const void* in, float* out, size_t count) {
+  const int16_t* src = static_cast<const int16_t*>(in);
+  const __m128 scale = _mm_set1_ps(1.0f / fullScale<16>());
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (Swap) {
+      v = byteSwap16(v);
+    }
+    // Extension de signe : chaque mot dupliqué puis décalé arithmétiquement
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+  int16ToFloatScalar<Swap>(src + i, out + i, count - i);
+}
+
+template <bool Swap>
+DSP_TARGET("sse2")
+void floatToInt16Sse2(const float* in, void* out, size_t count) {
+  int16_t* dst = static_cast<int16_t*>(out);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i lo = quantizeSse2<16>(_mm_loadu_ps(in + i));
+    const __m128i hi = quantizeSse2<16>(_mm_loadu_ps(in + i + 4));
+    __m128i v = _mm_packs_epi32(lo, hi);
+    if (Swap) {
+      v = byteSwap16(v);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+  }
+  floatToInt16Scalar<Swap>(in + i, dst + i, count - i);
+}
+
+template <int Bits, bool Swap>
+DSP_TARGET("sse2")
+void int32ToFloatSse2(const void* in, float* out, size_t count) {
+  const int32_t* src = static_cast<const int32_t*>(in);
+  const __m128 scale = _mm_set1_ps(1.0f / fullScale<Bits>());
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+    if (Swap) {
+      a = byteSwap32(a);
+      b = byteSwap32(b);
+    }
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(a), scale));
+    _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(b), scale));
+  }
+  int32ToFloatScalar<Bits, Swap>(src + i, out + i, count - i);
+}
+
+template <int Bits, bool Swap>
+DSP_TARGET("sse2")
+void floatToInt32Sse2(const float* in, void* out, size_t count) {
+  int32_t* dst = static_cast<int32_t*>(out);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i a = quantizeSse2<Bits>(_mm_loadu_ps(in + i));
+    __m128i b = quantizeSse2<Bits>(_mm_loadu_ps(in + i + 4));
+    if (Swap) {
+      a = byteSwap32(a);
+      b = byteSwap32(b);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), a);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), b);
+  }
+  floatToInt32Scalar<Bits, Swap>(in + i, dst + i, count - i);
+}
+
+DSP_TARGET("sse2")
+void float32MsbToFloatSse2(const void* in, float* out, size_t count) {
+  const uint32_t* src = static_cast<const uint32_t*>(in);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i v = byteSwap32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    _mm_storeu_ps(out + i, _mm_castsi128_ps(v));
+  }
+  float32ToFloatScalar<true>(src + i, out + i, count - i);
+}
+
+DSP_TARGET("sse2")
+void floatToFloat32MsbSse2(const float* in, void* out, size_t count) {
+  uint32_t* dst = static_cast<uint32_t*>(out);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i v = byteSwap32(_mm_castps_si128(_mm_loadu_ps(in + i)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+  }
+  floatToFloat32Scalar<true>(in + i, dst + i, count - i);
+}
+
+DSP_TARGET("sse2")
+void float64ToFloatSse2(const void* in, float* out, size_t count) {
+  const double* src = static_cast<const double*>(in);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+    const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+    _mm_storeu_ps(out + i, _mm_movelh_ps(lo, hi));
+  }
+  float64ToFloatScalar<false>(src + i, out + i, count - i);
+}
+
+DSP_TARGET("sse2")
+void floatToFloat64Sse2(const float* in, void* out, size_t count) {
+  double* dst = static_cast<double*>(out);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 v = _mm_loadu_ps(in + i);
+    _mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+    _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+  }
+  floatToFloat64Scalar<false>(in + i, dst + i, count - i);
+}
+
+// --- SSSE3 : 24 bits compacts par pshufb (4 échantillons = 12 octets par registre) ---
+
+template <bool Msb>
+DSP_TARGET("ssse3")
+void int24ToFloatSsse3(const void* in, float* out, size_t count) {
+  const uint8_t* src = static_cast<const uint8_t*>(in);
+  // Octets de chaque échantillon placés dans les 3 octets de poids fort d'un mot 32 bits
+  const __m128i spread = Msb
+    ? _mm_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9)
+    : _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+  const __m128 scale = _mm_set1_ps(1.0f / fullScale<24>());
+  size_t i = 0;
+  // Chaque chargement lit 16 octets pour en utiliser 12 : on s'arrête avant la fin du buffer
+  for (; i + 6 <= count; i += 4) {
+    const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i));
+    const __m128i value = _mm_srai_epi32(_mm_shuffle_epi8(raw, spread), 8);
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(value), scale));
+  }
+  int24ToFloatScalar<Msb>(src + 3 * i, out + i, count - i);
+}
+
+template <bool Msb>
+DSP_TARGET("ssse3")
+void floatToInt24Ssse3(const float* in, void* out, size_t count) {
+  uint8_t* dst = static_cast<uint8_t*>(out);
+  // Les 3 octets utiles de chaque mot 32 bits regroupés dans les 12 premiers octets
+  const __m128i gather = Msb
+    ? _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+    : _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128i packed = _mm_shuffle_epi8(quantizeSse2<24>(_mm_loadu_ps(in + i)), gather);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 3 * i), packed);
+    const int32_t tail = _mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+    std::memcpy(dst + 3 * i + 8, &tail, sizeof(tail));
+  }
+  floatToInt24Scalar<Msb>(in + i, dst + 3 * i, count - i);
+}
+
+#endif // DSP_X86
+
+const SampleConverter kScalarConverters[] = {
+  {SampleFormat::Int16MSB, "Int16MSB", "scalar", 2, int16ToFloatScalar<true>, floatToInt16Scalar<true>},
+  {SampleFormat::Int24MSB, "Int24MSB", "scalar", 3, int24ToFloatScalar<true>, floatToInt24Scalar<true>},
+  {SampleFormat::Int32MSB, "Int32MSB", "scalar", 4, int32ToFloatScalar<32, true>, floatToInt32Scalar<32, true>},
+  {SampleFormat::Float32MSB, "Float32MSB", "scalar", 4, float32ToFloatScalar<true>, floatToFloat32Scalar<true>},
+  {SampleFormat::Float64MSB, "Float64MSB", "scalar", 8, float64ToFloatScalar<true>, floatToFloat64Scalar<true>},
+  {SampleFormat::Int32MSB16, "Int32MSB16", "scalar", 4, int32ToFloatScalar<16, true>, floatToInt32Scalar<16, true>},
+  {SampleFormat::Int32MSB18, "Int32MSB18", "scalar", 4, int32ToFloatScalar<18, true>, floatToInt32Scalar<18, true>},
+  {SampleFormat::Int32MSB20, "Int32MSB20", "scalar", 4, int32ToFloatScalar<20, true>, floatToInt32Scalar<20, true>},
+  {SampleFormat::Int32MSB24, "Int32MSB24", "scalar", 4, int32ToFloatScalar<24, true>, floatToInt32Scalar<24, true>},
+  {SampleFormat::Int16LSB, "Int16LSB", "scalar", 2, int16ToFloatScalar<false>, floatToInt16Scalar<false>},
+  {SampleFormat::Int24LSB, "Int24LSB", "scalar", 3, int24ToFloatScalar<false>, floatToInt24Scalar<false>},
+  {SampleFormat::Int32LSB, "Int32LSB", "scalar", 4, int32ToFloatScalar<32, false>, floatToInt32Scalar<32, false>},
+  {SampleFormat::Float32LSB, "Float32LSB", "scalar", 4, float32ToFloatScalar<false>, floatToFloat32Scalar<false>},
+  {SampleFormat::Float64LSB, "Float64LSB", "scalar", 8, float64ToFloatScalar<false>, floatToFloat64Scalar<false>},
+  {SampleFormat::Int32LSB16, "Int32LSB16", "scalar", 4, int32ToFloatScalar<16, false>, floatToInt32Scalar<16, false>},
+  {SampleFormat::Int32LSB18, "Int32LSB18", "scalar", 4, int32ToFloatScalar<18, false>, floatToInt32Scalar<18, false>},
+  {SampleFormat::Int32LSB20, "Int32LSB20", "scalar", 4, int32ToFloatScalar<20, false>, floatToInt32Scalar<20, false>},
+  {SampleFormat::Int32LSB24, "Int32LSB24", "scalar", 4, int32ToFloatScalar<24, false>, floatToInt32Scalar<24, false>}
+};
+
+#if DSP_X86
+// Float32LSB reste une copie (memcpy est déjà vectorisé) ; Float64MSB, rare, reste scalaire
+const SampleConverter kSse2Converters[] = {
+  {SampleFormat::Int16MSB, "Int16MSB", "sse2", 2, int16ToFloatSse2<true>, floatToInt16Sse2<true>},
+  {SampleFormat::Int32MSB, "Int32MSB", "sse2", 4, int32ToFloatSse2<32, true>, floatToInt32Sse2<32, true>},
+  {SampleFormat::Float32MSB, "Float32MSB", "sse2", 4, float32MsbToFloatSse2, floatToFloat32MsbSse2},
+  {SampleFormat::Int32MSB16, "Int32MSB16", "sse2", 4, int32ToFloatSse2<16, true>, floatToInt32Sse2<16, true>},
+  {SampleFormat::Int32MSB18, "Int32MSB18", "sse2", 4, int32ToFloatSse2<18, true>, floatToInt32Sse2<18, true>},
+  {SampleFormat::Int32MSB20, "Int32MSB20", "sse2", 4, int32ToFloatSse2<20, true>, floatToInt32Sse2<20, true>},
+  {SampleFormat::Int32MSB24, "Int32MSB24", "sse2", 4, int32ToFloatSse2<24, true>, floatToInt32Sse2<24, true>},
+  {SampleFormat::Int16LSB, "Int16LSB", "sse2", 2, int16ToFloatSse2<false>, floatToInt16Sse2<false>},
+  {SampleFormat::Int32LSB, "Int32LSB", "sse2", 4, int32ToFloatSse2<32, false>, floatToInt32Sse2<32, false>},
+  {SampleFormat::Float64LSB, "Float64LSB", "sse2", 8, float64ToFloatSse2, floatToFloat64Sse2},
+  {SampleFormat::Int32LSB16, "Int32LSB16", "sse2", 4, int32ToFloatSse2<16, false>, floatToInt32Sse2<16, false>},
+  {SampleFormat::Int32LSB18, "Int32LSB18", "sse2", 4, int32ToFloatSse2<18, false>, floatToInt32Sse2<18, false>},
+  {SampleFormat::Int32LSB20, "Int32LSB20", "sse2", 4, int32ToFloatSse2<20, false>, floatToInt32Sse2<20, false>},
+  {SampleFormat::Int32LSB24, "Int32LSB24", "sse2", 4, int32ToFloatSse2<24, false>, floatToInt32Sse2<24, false>}
+};
+
+// SSSE3 n'est pas détecté séparément : tout processeur AVX2 le fournit
+const SampleConverter kSsse3Converters[] = {
+  {SampleFormat::Int24MSB, "Int24MSB", "ssse3", 3, int24ToFloatSsse3<true>, floatToInt24Ssse3<true>},
+  {SampleFormat::Int24LSB, "Int24LSB", "ssse3", 3, int24ToFloatSsse3<false>, floatToInt24Ssse3<false>}
+};
+#endif
+
+template <size_t N>
+const SampleConverter* findConverter(const SampleConverter (&table)[N], SampleFormat format) {
+  for (size_t i = 0; i < N; i++) {
+    if (table[i].format == format) {
+      return &table[i];
+    }
+  }
+  return nullptr;
+}
+
+} // namespace
+
+const SampleConverter* sampleConverterFor(SampleFormat format, SimdLevel level) {
+  const SampleConverter* converter = nullptr;
+#if DSP_X86
+  if (level >= SimdLevel::AVX2) {
+    converter = findConverter(kSsse3Converters, format);
+  }
+  if (!converter && level >= SimdLevel::SSE2) {
+    converter = findConverter(kSse2Converters, format);
+  }
+#else
+  (void)level;
+#endif
+  return converter ? converter : findConverter(kScalarConverters, format);
+}
+
+const char* sampleFormatName(long asioSampleType) {
+  const SampleConverter* converter = findConverter(kScalarConverters, static_cast<SampleFormat>(asioSampleType));
+  if (converter) {
+    return converter->name;
+  }
+  switch (asioSampleType) {
+    case 32: return "DSDInt8LSB1";
+    case 33: return "DSDInt8MSB1";
+    case 40: return "DSDInt8NER8";
+    default: return "unknown";
+  }
+}
@@ -0,0 +1,57 @@
+#ifndef __sample_format__
+#define __sample_format__
+
+#include <cstddef>
+
+#include "dsp_kernels.h"
+
+// Formats d'échantillons des buffers du pilote
+// Les valeurs sont celles de ASIOSampleType : un static_cast suffit pour passer de l'un à l'autre.
+enum class SampleFormat : long {
+  Int16MSB = 0,
+  Int24MSB = 1,   // 3 octets par échantillon (aussi utilisé pour 20 bits)
+  Int32MSB = 2,
+  Float32MSB = 3,
+  Float64MSB = 4,
+  Int32MSB16 = 8, // conteneur 32 bits, données alignées à droite sur 16, 18, 20 ou 24 bits
+  Int32MSB18 = 9,
+  Int32MSB20 = 10,
+  Int32MSB24 = 11,
+  Int16LSB = 16,
+  Int24LSB = 17,
+  Int32LSB = 18,
+  Float32LSB = 19,
+  Float64LSB = 20,
+  Int32LSB16 = 24,
+  Int32LSB18 = 25,
+  Int32LSB20 = 26,
+  Int32LSB24 = 27
+};
+
+// Conversion entre un buffer du pilote et un plan float
+// Le traitement reste en float : chaque canal actif reçoit au démarrage le
+// convertisseur de son format, le callback appelle toFloat / fromFloat sans
+// aucun test par échantillon.
+// - pas d'exigence d'alignement ni de longueur côté pilote (queue scalaire)
+// - entiers : pleine échelle = 1.0 ; en sortie, écrêtage à [-1, 1] puis arrondi au plus proche
+struct SampleConverter {
+  SampleFormat format;
+  const char* name;      // nom du format ASIO sans préfixe (ex. "Int32LSB")
+  const char* isa;       // "scalar", "sse2" ou "ssse3"
+  size_t bytesPerSample;
+
+  // Buffer du pilote -> plan float
+  void (*toFloat)(const void* in, float* out, size_t count);
+
+  // Plan float -> buffer du pilote
+  void (*fromFloat)(const float* in, void* out, size_t count);
+};
+
+// Convertisseur le plus rapide disponible pour un niveau SIMD (nullptr si le format
+// n'est pas supporté, ex. DSD)
+const SampleConverter* sampleConverterFor(SampleFormat format, SimdLevel level);
+
+// Nom d'un format ASIO quelconque ("unknown" si inconnu)
+const char* sampleFormatName(long asioSampleType);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef __seqlock__
+#define __seqlock__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Instantané protégé par compteur de séquence (seqlock) à un seul écrivain.
+// L'écrivain (callback audio) ne bloque jamais ; les lecteurs recommencent leur
+// lecture si une écriture a eu lieu entre-temps. La donnée est stockée mot par mot
+// dans des atomiques pour rester définie au sens du modèle mémoire C++.
+template <typename T>
+class SeqLock {
+  static_assert(std::is_trivially_copyable<T>::value, "SeqLock exige un type trivialement copiable");
+
+public:
+  SeqLock() {
+    T initial{};
+    write(initial);
+  }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  // Côté écrivain unique : quelques stores, sans attente
+  void write(const T& value) {
+    uint32_t words[kWords] = {};
+    std::memcpy(words, &value, sizeof(T));
+
+    const uint32_t s = sequence.load(std::memory_order_relaxed);
+    sequence.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; i++) {
+      data[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence.store(s + 2, std::memory_order_release);
+  }
+
+  // Côté lecteur : copie cohérente de la dernière valeur publiée
+  T read() const {
+    uint32_t words[kWords];
+    uint32_t before, after;
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      for (size_t i = 0; i < kWords; i++) {
+        words[i] = data[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1u) != 0 || before != after);
+
+    T value;
+    std::memcpy(&value, words, sizeof(T));
+    return value;
+  }
+
+  // Nombre de publications depuis la création
+  uint32_t version() const { return sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+  static const size_t kWords = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+  alignas(64) std::atomic<uint32_t> sequence{0};
+  std::atomic<uint32_t> data[kWords];
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "shared_telemetry.h"
+
+#include <cstring>
+
+// Les mots de la région sont manipulés comme des std::atomic<uint32_t> : même taille et
+// même représentation qu'un uint32_t, sans verrou (sinon Atomics.load côté JavaScript
+// ne verrait pas les mêmes données)
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "std::atomic<uint32_t> doit avoir la taille d'un mot");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "std::atomic<uint32_t> doit être sans verrou");
+
+bool SharedTelemetryRegion::attach(void* memory, size_t bytes, uint32_t bands) {
+  detach();
+  if (memory == nullptr || reinterpret_cast<uintptr_t>(memory) % alignof(std::atomic<uint32_t>) != 0 ||
+      bytes < sharedTelemetryBytes(bands)) {
+    return false;
+  }
+  words = static_cast<std::atomic<uint32_t>*>(memory);
+  numBands = bands;
+  frames = 0;
+
+  // Région vierge : les lecteurs ne voient aucune trame tant que Frames vaut 0
+  for (size_t i = 0; i < kSharedTelemetryHeaderWords + bands; i++) {
+    store(static_cast<uint32_t>(i), 0);
+  }
+  store(kTelemetryVersion, kSharedTelemetryVersion);
+  store(kTelemetryBands, bands);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return true;
+}
+
+void SharedTelemetryRegion::detach() {
+  words = nullptr;
+  numBands = 0;
+}
+
+void SharedTelemetryRegion::publish(const SharedTelemetryFrame& frame, const float* spectrum) {
+  if (words == nullptr) {
+    return;
+  }
+
+  // Même protocole que SeqLock::write
+  const uint32_t s = words[kTelemetrySequence].load(std::memory_order_relaxed);
+  words[kTelemetrySequence].store(s + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  store(kTelemetryProcessing, frame.processing ? 1u : 0u);
+  store(kTelemetryFrames, ++frames);
+  store64(kTelemetryTimeUsLo, frame.timeUs);
+  storeFloat(kTelemetryLevel, frame.level);
+  storeFloat(kTelemetryRms, frame.rms);
+  storeFloat(kTelemetryPeak, frame.peak);
+  storeFloat(kTelemetryPeakHold, frame.peakHold);
+  store(kTelemetryBlocks, frame.blocks);
+  store64(kTelemetryCallbacksLo, frame.callbacks);
+  store64(kTelemetryOverrunsLo, frame.overruns);
+  store64(kTelemetryLateLo, frame.lateCallbacks);
+  storeFloat(kTelemetryDspLoad, frame.dspLoad);
+  storeFloat(kTelemetryMeanDspLoad, frame.meanDspLoad);
+  storeFloat(kTelemetryPeakDspLoad, frame.peakDspLoad);
+  for (uint32_t i = 0; i < numBands; i++) {
+    storeFloat(static_cast<uint32_t>(kSharedTelemetryHeaderWords) + i, spectrum != nullptr ? spectrum[i] : 0.0f);
+  }
+
+  words[kTelemetrySequence].store(s + 2, std::memory_order_release);
+}
+
+void SharedTelemetryRegion::storeFloat(uint32_t index, float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  store(index, bits);
+}
+
+void SharedTelemetryRegion::store64(uint32_t lo, uint64_t value) {
+  store(lo, static_cast<uint32_t>(value));
+  store(lo + 1, static_cast<uint32_t>(value >> 32));
+}
@@ -0,0 +1,89 @@
+#ifndef __shared_telemetry__
+#define __shared_telemetry__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Région de télémétrie en mémoire partagée (SharedArrayBuffer côté JavaScript)
+// La région est une suite de mots de 32 bits : un en-tête de kSharedTelemetryHeaderWords
+// mots puis le spectre (un float par bande). Un seul écrivain publie sous compteur de
+// séquence, comme SeqLock : le compteur est impair pendant l'écriture. Les lecteurs
+// JavaScript (thread principal ou workers) lisent chaque mot avec Atomics.load sur un
+// Int32Array et recommencent si le compteur a changé ou était impair.
+// Les entiers 64 bits sont stockés en deux mots (poids faible puis poids fort), les
+// valeurs réelles en float 32 bits. backend/shared_telemetry.js lit ce format.
+enum SharedTelemetryField : uint32_t {
+  kTelemetrySequence = 0,   // compteur de séquence (impair pendant l'écriture)
+  kTelemetryVersion = 1,    // version du format (kSharedTelemetryVersion)
+  kTelemetryBands = 2,      // bandes du spectre (fixé à l'attache)
+  kTelemetryProcessing = 3, // 1 si le traitement est en cours
+  kTelemetryFrames = 4,     // trames publiées
+  kTelemetryTimeUsLo = 5,   // horloge monotone de la trame, en microsecondes
+  kTelemetryTimeUsHi = 6,
+  kTelemetryLevel = 8,      // float : niveau affiché (0 à 100)
+  kTelemetryRms = 9,        // float : niveaux linéaires (1.0 = pleine échelle)
+  kTelemetryPeak = 10,
+  kTelemetryPeakHold = 11,
+  kTelemetryBlocks = 12,    // blocs mesurés
+  kTelemetryCallbacksLo = 13,
+  kTelemetryCallbacksHi = 14,
+  kTelemetryOverrunsLo = 15,
+  kTelemetryOverrunsHi = 16,
+  kTelemetryLateLo = 17,
+  kTelemetryLateHi = 18,
+  kTelemetryDspLoad = 19,   // float : charge DSP du dernier bloc, moyenne, crête
+  kTelemetryMeanDspLoad = 20,
+  kTelemetryPeakDspLoad = 21
+};
+
+static const uint32_t kSharedTelemetryVersion = 1;
+static const size_t kSharedTelemetryHeaderWords = 32;
+
+// Taille de la région pour un nombre de bandes, en octets
+inline size_t sharedTelemetryBytes(uint32_t bands) {
+  return (kSharedTelemetryHeaderWords + bands) * sizeof(uint32_t);
+}
+
+// Contenu d'une trame, hors spectre
+struct SharedTelemetryFrame {
+  bool processing;
+  uint64_t timeUs;
+  float level;
+  float rms;
+  float peak;
+  float peakHold;
+  uint32_t blocks;
+  uint64_t callbacks;
+  uint64_t overruns;
+  uint64_t lateCallbacks;
+  float dspLoad;
+  float meanDspLoad;
+  float peakDspLoad;
+};
+
+// Écrivain de la région : la mémoire appartient à l'appelant (SharedArrayBuffer maintenu
+// en vie tant que la région est attachée). publish() est appelé par un seul thread.
+class SharedTelemetryRegion {
+public:
+  // Remet l'en-tête à zéro et fixe le nombre de bandes ; false si la région est trop petite
+  // ou mal alignée
+  bool attach(void* memory, size_t bytes, uint32_t bands);
+  void detach();
+  bool attached() const { return words != nullptr; }
+  uint32_t bands() const { return numBands; }
+
+  // Côté écrivain unique : spectrum contient bands() valeurs (ignoré si bands() vaut 0)
+  void publish(const SharedTelemetryFrame& frame, const float* spectrum);
+
+private:
+  void store(uint32_t index, uint32_t value) { words[index].store(value, std::memory_order_relaxed); }
+  void storeFloat(uint32_t index, float value);
+  void store64(uint32_t lo, uint64_t value);
+
+  std::atomic<uint32_t>* words = nullptr;
+  uint32_t numBands = 0;
+  uint32_t frames = 0;
+};
+
+#endif
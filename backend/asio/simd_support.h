@@ -0,0 +1,40 @@
+#ifndef __simd_support__
+#define __simd_support__
+
+// Détection de l'architecture et attribut de compilation par jeu d'instructions,
+// partagés par les modules qui sélectionnent leurs noyaux à l'exécution
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DSP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define DSP_X86 0
+#endif
+
+// Les fonctions SIMD sont compilées pour leur jeu d'instructions cible sans
+// imposer ce jeu au reste du module (GCC/Clang) ; MSVC accepte les intrinsics directement.
+#if defined(__GNUC__) || defined(__clang__)
+#define DSP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DSP_TARGET(isa)
+#endif
+
+#if DSP_X86
+// Inversion de l'ordre des octets dans chaque mot de 16 ou 32 bits (SSE2)
+DSP_TARGET("sse2")
+inline __m128i byteSwap16(__m128i v) {
+  return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+DSP_TARGET("sse2")
+inline __m128i byteSwap32(__m128i v) {
+  return byteSwap16(_mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xb1), 0xb1));
+}
+#endif
+
+#endif
@@ -0,0 +1,101 @@
+#include "smoothed_parameter.h"
+
+#include <cmath>
+
+#include "dsp_kernels.h"
+
+// Écart en dessous duquel la rampe exponentielle est considérée terminée (~ -120 dB)
+static const float kSettleThreshold = 1e-6f;
+
+SmoothedParameter::SmoothedParameter(float initial)
+  : targetValue(initial), value(initial), rampTarget(initial) {}
+
+void SmoothedParameter::configure(double sampleRate, size_t newBlockSize, double rampMs,
+                                  RampShape newShape) {
+  shape = newShape;
+  blockSize = newBlockSize;
+  rampBlocks = 0;
+  blockCoef = 0.0f;
+  blockDecay = 0.0f;
+  if (sampleRate <= 0.0 || blockSize == 0 || rampMs <= 0.0) {
+    return; // pas de lissage : changement immédiat au bloc suivant
+  }
+
+  const double rampSamples = rampMs * sampleRate / 1000.0;
+  if (shape == RampShape::Linear) {
+    // La rampe se termine sur une frontière de bloc : aucun bloc n'est découpé
+    rampBlocks = static_cast<unsigned int>(std::ceil(rampSamples / static_cast<double>(blockSize)));
+  } else {
+    blockCoef = static_cast<float>(std::exp(-1.0 / rampSamples));
+    blockDecay = static_cast<float>(std::pow(static_cast<double>(blockCoef), static_cast<double>(blockSize)));
+  }
+}
+
+void SmoothedParameter::reset() {
+  value = targetValue.load(std::memory_order_relaxed);
+  rampTarget = value;
+  remainingBlocks = 0;
+}
+
+BlockRamp SmoothedParameter::nextRamp(size_t count) {
+  BlockRamp ramp;
+  ramp.padded = paddedLength(count);
+
+  // Une seule lecture de la cible par bloc
+  const float newTarget = targetValue.load(std::memory_order_relaxed);
+  if (newTarget != rampTarget) {
+    rampTarget = newTarget;
+    remainingBlocks = rampBlocks;
+  }
+
+  if (value != rampTarget && shape == RampShape::Linear && remainingBlocks > 0) {
+    // Pente recalculée à chaque bloc : une nouvelle cible repart de la valeur courante
+    const float step = (rampTarget - value) / static_cast<float>(remainingBlocks * count);
+    ramp.segment = BlockRamp::Segment::Linear;
+    ramp.a = value + step;
+    ramp.b = step;
+    remainingBlocks--;
+    value = remainingBlocks == 0 ? rampTarget : value + step * static_cast<float>(count);
+    return ramp;
+  }
+
+  if (value != rampTarget && shape == RampShape::Exponential && blockCoef > 0.0f) {
+    const float distance = value - rampTarget;
+    ramp.segment = BlockRamp::Segment::Exponential;
+    ramp.value = rampTarget;
+    ramp.a = distance;
+    ramp.b = blockCoef;
+    const float decay = count == blockSize
+      ? blockDecay
+      : std::pow(blockCoef, static_cast<float>(count));
+    const float remaining = distance * decay;
+    value = std::fabs(remaining) < kSettleThreshold ? rampTarget : rampTarget + remaining;
+    return ramp;
+  }
+
+  // Pas de rampe en cours (ou lissage désactivé) : valeur constante
+  value = rampTarget;
+  ramp.value = value;
+  return ramp;
+}
+
+float SmoothedParameter::nextBlock(size_t count) {
+  nextRamp(count);
+  return value;
+}
+
+void BlockRamp::apply(const float* in, float* out, float factor) const {
+  // La trajectoire est linéaire en factor : le facteur est replié dans ses coefficients
+  const DspKernels& kernels = dspKernels();
+  switch (segment) {
+    case Segment::Linear:
+      kernels.linearRamp(in, out, padded, a * factor, b * factor);
+      break;
+    case Segment::Exponential:
+      kernels.expRamp(in, out, padded, value * factor, a * factor, b);
+      break;
+    default:
+      kernels.scale(in, out, padded, value * factor);
+      break;
+  }
+}
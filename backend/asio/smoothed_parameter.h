@@ -0,0 +1,80 @@
+#ifndef __smoothed_parameter__
+#define __smoothed_parameter__
+
+#include <atomic>
+#include <cstddef>
+
+// Forme de la rampe appliquée lors d'un changement de valeur
+enum class RampShape {
+  Linear,      // atteint la cible en rampMs (arrondi au bloc supérieur)
+  Exponential  // filtre à un pôle de constante de temps rampMs
+};
+
+// Trajectoire d'un paramètre sur un bloc, calculée une fois par le callback
+// puis appliquée à autant de canaux que nécessaire
+struct BlockRamp {
+  enum class Segment { Constant, Linear, Exponential };
+
+  Segment segment = Segment::Constant;
+  float value = 0.0f;     // Constant : valeur ; Exponential : cible
+  float a = 0.0f;         // Linear : première valeur ; Exponential : écart initial
+  float b = 0.0f;         // Linear : pente ; Exponential : coefficient par échantillon
+  size_t padded = 0;      // longueur traitée (paddedLength du bloc)
+
+  // out[i] = in[i] * factor * valeur(i) ; in et out peuvent être confondus.
+  // in/out doivent être alignés sur kBufferAlignment et valides sur padded échantillons.
+  void apply(const float* in, float* out, float factor = 1.0f) const;
+};
+
+// Paramètre automatisable sans verrou
+// N'importe quel thread écrit la cible (simple store atomique) ; le callback la lit
+// une seule fois par bloc puis interpole à l'intérieur du bloc, ce qui supprime
+// les marches (clics) aux frontières de blocs.
+// Utilisé pour le gain de sortie et pour tout autre paramètre de la chaîne DSP.
+class SmoothedParameter {
+public:
+  explicit SmoothedParameter(float initial = 0.0f);
+
+  // À l'arrêt : durée et forme de la rampe pour des blocs de blockSize échantillons
+  void configure(double sampleRate, size_t blockSize, double rampMs,
+                 RampShape shape = RampShape::Linear);
+
+  // À l'arrêt : saute directement à la cible (pas de rampe au démarrage)
+  void reset();
+
+  // N'importe quel thread, sans attente
+  void setTarget(float value) { targetValue.store(value, std::memory_order_relaxed); }
+  float target() const { return targetValue.load(std::memory_order_relaxed); }
+
+  // Côté callback : lit la cible, avance d'un bloc de count échantillons et
+  // retourne la trajectoire à appliquer
+  BlockRamp nextRamp(size_t count);
+
+  // Côté callback : out[i] = in[i] * valeur interpolée, sur un bloc de count échantillons.
+  // in/out doivent être alignés sur kBufferAlignment et valides jusqu'à paddedLength(count).
+  void apply(const float* in, float* out, size_t count) { nextRamp(count).apply(in, out); }
+
+  // Côté callback, pour les paramètres évalués une fois par bloc :
+  // avance d'un bloc et retourne la valeur atteinte en fin de bloc
+  float nextBlock(size_t count);
+
+  // Valeur courante (côté callback uniquement)
+  float current() const { return value; }
+
+private:
+  std::atomic<float> targetValue;
+
+  // Configuration (écrite à l'arrêt uniquement)
+  RampShape shape = RampShape::Linear;
+  size_t blockSize = 0;
+  unsigned int rampBlocks = 0;
+  float blockCoef = 0.0f;   // coefficient par échantillon (exponentielle)
+  float blockDecay = 0.0f;  // blockCoef^blockSize
+
+  // État propre au callback
+  float value;
+  float rampTarget;
+  unsigned int remainingBlocks = 0;
+};
+
+#endif
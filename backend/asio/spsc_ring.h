@@ -0,0 +1,89 @@
+#ifndef __spsc_ring__
+#define __spsc_ring__
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// File circulaire sans verrou à un seul producteur et un seul consommateur.
+// Le producteur (callback ASIO) ne bloque jamais : si la file est pleine,
+// les éléments en trop sont simplement ignorés et comptabilisés.
+// La capacité est arrondie à la puissance de deux supérieure pour que
+// les index se calculent par masque.
+template <typename T>
+class SpscRing {
+public:
+  explicit SpscRing(size_t minCapacity = 0) { reset(minCapacity); }
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  // À appeler uniquement lorsque ni le producteur ni le consommateur ne sont actifs
+  void reset(size_t minCapacity) {
+    size_t capacity = 1;
+    while (capacity < minCapacity) {
+      capacity <<= 1;
+    }
+    storage.assign(capacity, T());
+    mask = capacity - 1;
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+    dropped.store(0, std::memory_order_relaxed);
+  }
+
+  size_t capacity() const { return storage.size(); }
+
+  // Stockage des éléments (verrouillage en mémoire), capacity() éléments
+  const T* data() const { return storage.data(); }
+
+  // Côté producteur : écrit au plus `count` éléments, retourne le nombre écrit
+  size_t push(const T* data, size_t count) {
+    const size_t h = head.load(std::memory_order_relaxed);
+    const size_t t = tail.load(std::memory_order_acquire);
+    const size_t space = storage.size() - (h - t);
+    const size_t n = count < space ? count : space;
+
+    for (size_t i = 0; i < n; i++) {
+      storage[(h + i) & mask] = data[i];
+    }
+    head.store(h + n, std::memory_order_release);
+
+    if (n < count) {
+      dropped.fetch_add(count - n, std::memory_order_relaxed);
+    }
+    return n;
+  }
+
+  // Côté consommateur : lit au plus `count` éléments, retourne le nombre lu
+  size_t pop(T* data, size_t count) {
+    const size_t t = tail.load(std::memory_order_relaxed);
+    const size_t h = head.load(std::memory_order_acquire);
+    const size_t available = h - t;
+    const size_t n = count < available ? count : available;
+
+    for (size_t i = 0; i < n; i++) {
+      data[i] = storage[(t + i) & mask];
+    }
+    tail.store(t + n, std::memory_order_release);
+    return n;
+  }
+
+  // Nombre d'éléments disponibles côté consommateur (approximatif côté producteur)
+  size_t size() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+
+  // Nombre d'éléments perdus parce que le consommateur ne suivait pas
+  size_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+  std::vector<T> storage;
+  size_t mask = 0;
+
+  // Index séparés sur des lignes de cache distinctes pour éviter le faux partage
+  alignas(64) std::atomic<size_t> head{0};
+  alignas(64) std::atomic<size_t> tail{0};
+  alignas(64) std::atomic<size_t> dropped{0};
+};
+
+#endif
@@ -0,0 +1,97 @@
+// Vérification du convolueur partitionné contre la convolution directe
+// Réponses impulsionnelles plus courtes et plus longues que le bloc, longueurs non
+// multiples du bloc, retards purs (partitions nulles ignorées), traitement en place :
+// la sortie bloc par bloc doit égaler la somme directe sur tout l'historique.
+//
+// Usage : convolver_test   (code de retour non nul si un cas dépasse la tolérance)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../aligned_buffer.h"
+#include "../partitioned_convolver.h"
+
+namespace {
+
+// Erreur relative à la plus grande sortie directe
+const double kTolerance = 1e-5;
+
+struct Case {
+  const char* name;
+  size_t block;
+  size_t taps;
+  size_t delay;   // taps nuls en tête de la réponse
+  bool inPlace;
+};
+
+double check(const Case& c, std::mt19937& rng) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> impulse(c.delay + c.taps, 0.0f);
+  for (size_t i = c.delay; i < impulse.size(); i++) {
+    impulse[i] = dist(rng);
+  }
+
+  PartitionedConvolver convolver;
+  convolver.configure(c.block, impulse.data(), impulse.size());
+
+  // Assez de blocs pour remplir toute la ligne à retard, plus une marge
+  const size_t blocks = (impulse.size() + c.block - 1) / c.block + 8;
+  std::vector<float> input(blocks * c.block);
+  for (float& sample : input) {
+    sample = dist(rng);
+  }
+
+  AlignedBuffer<float> in(c.block), out(c.block);
+  double peak = 0.0;
+  double error = 0.0;
+  for (size_t b = 0; b < blocks; b++) {
+    std::copy(input.begin() + b * c.block, input.begin() + (b + 1) * c.block, in.data());
+    convolver.process(in.data(), c.inPlace ? in.data() : out.data());
+    const float* result = c.inPlace ? in.data() : out.data();
+    for (size_t i = 0; i < c.block; i++) {
+      const size_t n = b * c.block + i;
+      double expected = 0.0;
+      for (size_t k = 0; k < impulse.size() && k <= n; k++) {
+        expected += static_cast<double>(impulse[k]) * input[n - k];
+      }
+      peak = std::max(peak, std::fabs(expected));
+      error = std::max(error, std::fabs(result[i] - expected));
+    }
+  }
+  return error / std::max(peak, 1e-30);
+}
+
+} // namespace
+
+int main() {
+  const Case cases[] = {
+    {"une partition", 64, 64, 0, false},
+    {"réponse courte", 64, 17, 0, false},
+    {"plusieurs partitions", 64, 300, 0, false},
+    {"bloc ASIO 96", 96, 500, 0, false},
+    {"bloc ASIO 480", 480, 1000, 0, false},
+    {"petit bloc", 32, 1024, 0, false},
+    {"retard pur", 64, 1, 200, false},
+    {"retard + FIR", 128, 90, 300, false},
+    {"en place", 64, 300, 0, true},
+  };
+  std::mt19937 rng(7);
+  int failures = 0;
+  std::printf("%-22s %6s %6s %12s\n", "cas", "bloc", "taps", "erreur");
+  for (const Case& c : cases) {
+    const double error = check(c, rng);
+    const bool ok = error <= kTolerance;
+    if (!ok) {
+      failures++;
+    }
+    std::printf("%-22s %6zu %6zu %12.3e%s\n", c.name, c.block, c.delay + c.taps, error, ok ? "" : "  ÉCHEC");
+  }
+  if (failures > 0) {
+    std::printf("\n%d cas hors tolérance\n", failures);
+    return 1;
+  }
+  return 0;
+}
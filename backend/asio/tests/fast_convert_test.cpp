@@ -0,0 +1,265 @@
+// Vérification de FastConvertSamples
+// - portage scalaire du SDK contre une référence écrite indépendamment (arithmétique
+//   entière sur les échantillons plutôt que copies d'octets) pour les conversions usuelles
+// - chaque niveau SIMD disponible contre le portage scalaire, pour toutes les méthodes,
+//   sur des longueurs impaires (queues scalaires) : octets identiques, y compris après
+//   la sortie des routines en place
+// - shift32 : décalage ou largeur hors limites refusés, buffer intact à tous les niveaux
+//
+// Usage : fast_convert_test   (code de retour non nul au premier écart signalé)
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "../fast_convert_samples.h"
+
+namespace {
+
+int failures = 0;
+
+void fail(const char* what, const char* name, long frames) {
+  failures++;
+  std::printf("ÉCHEC %s : %s, %ld trames\n", what, name, frames);
+}
+
+std::vector<int32_t> randomSamples(long frames, std::mt19937& rng) {
+  std::vector<int32_t> samples(static_cast<size_t>(frames));
+  for (int32_t& sample : samples) {
+    sample = static_cast<int32_t>(rng());
+  }
+  return samples;
+}
+
+// Octets de poids décroissant d'un entier 32 bits
+uint8_t byteOf(int32_t value, int index) {
+  return static_cast<uint8_t>(static_cast<uint32_t>(value) >> (8 * index));
+}
+
+// --- Portage scalaire contre référence indépendante ---
+
+void checkReference(std::mt19937& rng) {
+  const FastConvertSamples sdk(SimdLevel::Scalar);
+  const long frames = 257;
+  const std::vector<int32_t> source = randomSamples(frames, rng);
+
+  // 16 bits de poids fort, gros-boutiste puis petit-boutiste
+  std::vector<uint8_t> out(static_cast<size_t>(frames) * 4);
+  sdk.convertMono16(source.data(), reinterpret_cast<short*>(out.data()), frames);
+  for (long i = 0; i < frames; i++) {
+    if (out[2 * i] != byteOf(source[i], 3) || out[2 * i + 1] != byteOf(source[i], 2)) {
+      fail("référence", "convertMono16", frames);
+      break;
+    }
+  }
+  sdk.convertMono16SmallEndian(source.data(), reinterpret_cast<short*>(out.data()), frames);
+  for (long i = 0; i < frames; i++) {
+    const uint16_t expected = static_cast<uint16_t>(static_cast<uint32_t>(source[i]) >> 16);
+    uint16_t actual;
+    std::memcpy(&actual, out.data() + 2 * i, sizeof(actual));
+    if (actual != expected) {
+      fail("référence", "convertMono16SmallEndian", frames);
+      break;
+    }
+  }
+
+  // 24 bits de poids fort, gros-boutiste
+  sdk.convertMono24(source.data(), reinterpret_cast<char*>(out.data()), frames);
+  for (long i = 0; i < frames; i++) {
+    if (out[3 * i] != byteOf(source[i], 3) || out[3 * i + 1] != byteOf(source[i], 2) ||
+        out[3 * i + 2] != byteOf(source[i], 1)) {
+      fail("référence", "convertMono24", frames);
+      break;
+    }
+  }
+
+  // 8 bits non signés : octet de poids fort décalé de 128
+  sdk.convertMono8Unsigned(source.data(), reinterpret_cast<char*>(out.data()), frames);
+  for (long i = 0; i < frames; i++) {
+    if (out[i] != static_cast<uint8_t>(byteOf(source[i], 3) ^ 0x80u)) {
+      fail("référence", "convertMono8Unsigned", frames);
+      break;
+    }
+  }
+
+  // shift32 largeur 2 : 16 bits de poids fort de x << shift, petit-boutiste
+  for (long shift : {0L, 5L, 16L, 31L}) {
+    std::vector<int32_t> buffer = source;
+    sdk.shift32(buffer.data(), shift, 2, false, frames);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(buffer.data());
+    for (long i = 0; i < frames; i++) {
+      const uint16_t expected = static_cast<uint16_t>((static_cast<uint32_t>(source[i]) << shift) >> 16);
+      uint16_t actual;
+      std::memcpy(&actual, bytes + 2 * i, sizeof(actual));
+      if (actual != expected) {
+        fail("référence", "shift32", frames);
+        break;
+      }
+    }
+  }
+
+  // float -> 16 bits : mise à l'échelle 0x7fff + 0.49999 et troncature vers zéro, comme le SDK
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> floats(static_cast<size_t>(frames));
+  for (float& sample : floats) {
+    sample = dist(rng);
+  }
+  std::vector<float> buffer = floats;
+  sdk.float32toInt16inPlace(buffer.data(), frames);
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(buffer.data());
+  for (long i = 0; i < frames; i++) {
+    const int16_t expected = static_cast<int16_t>(static_cast<int32_t>(std::trunc(static_cast<double>(floats[i]) * 32767.49999)));
+    int16_t actual;
+    std::memcpy(&actual, bytes + 2 * i, sizeof(actual));
+    if (actual != expected) {
+      fail("référence", "float32toInt16inPlace", frames);
+      break;
+    }
+  }
+}
+
+// --- Niveaux SIMD contre portage scalaire ---
+
+// Buffers d'un appel : deux sources 32 bits et deux destinations de 6 octets par trame
+// (24 bits entrelacé). Les routines en place travaillent dans dest[0], copie de left.
+struct Buffers {
+  std::vector<int32_t> left, right;
+  std::vector<unsigned char> dest[2];
+};
+
+struct Method {
+  const char* name;
+  bool floatSource;
+  std::function<void(const FastConvertSamples&, Buffers&, long)> run;
+};
+
+#define SPLIT(fn, T)                                                                               \
+  {#fn, false, [](const FastConvertSamples& c, Buffers& b, long n) {                               \
+     c.fn(b.left.data(), b.right.data(), reinterpret_cast<T*>(b.dest[0].data()),                   \
+          reinterpret_cast<T*>(b.dest[1].data()), n);                                              \
+   }}
+#define INTERLEAVED(fn, T)                                                                         \
+  {#fn, false, [](const FastConvertSamples& c, Buffers& b, long n) {                               \
+     c.fn(b.left.data(), b.right.data(), reinterpret_cast<T*>(b.dest[0].data()), n);               \
+   }}
+#define MONO(fn, T)                                                                                \
+  {#fn, false, [](const FastConvertSamples& c, Buffers& b, long n) {                               \
+     c.fn(b.left.data(), reinterpret_cast<T*>(b.dest[0].data()), n);                               \
+   }}
+#define IN_PLACE(fn, T, isFloat)                                                                   \
+  {#fn, isFloat, [](const FastConvertSamples& c, Buffers& b, long n) {                             \
+     c.fn(reinterpret_cast<T*>(b.dest[0].data()), n);                                              \
+   }}
+
+std::vector<Method> allMethods() {
+  return {
+    MONO(convertMono8, char), MONO(convertMono8Unsigned, char), MONO(convertMono16, short),
+    MONO(convertMono16SmallEndian, short), MONO(convertMono24, char), MONO(convertMono24SmallEndian, char),
+    INTERLEAVED(convertStereo8Interleaved, char), INTERLEAVED(convertStereo8InterleavedUnsigned, char),
+    INTERLEAVED(convertStereo16Interleaved, short), INTERLEAVED(convertStereo16InterleavedSmallEndian, short),
+    INTERLEAVED(convertStereo24Interleaved, char), INTERLEAVED(convertStereo24InterleavedSmallEndian, char),
+    SPLIT(convertStereo8, char), SPLIT(convertStereo8Unsigned, char), SPLIT(convertStereo16, short),
+    SPLIT(convertStereo16SmallEndian, short), SPLIT(convertStereo24, char), SPLIT(convertStereo24SmallEndian, char),
+    IN_PLACE(int32msb16to16inPlace, int32_t, false), IN_PLACE(int32lsb16to16inPlace, int32_t, false),
+    {"int32msb16shiftedTo16inPlace", false,
+     [](const FastConvertSamples& c, Buffers& b, long n) {
+       c.int32msb16shiftedTo16inPlace(reinterpret_cast<int32_t*>(b.dest[0].data()), n, 8);
+     }},
+    IN_PLACE(int24msbto16inPlace, unsigned char, false),
+    {"shift32 (16 bits)", false, [](const FastConvertSamples& c, Buffers& b, long n) { c.shift32(b.dest[0].data(), 8, 2, false, n); }},
+    {"shift32 (24 bits, inversé)", false, [](const FastConvertSamples& c, Buffers& b, long n) { c.shift32(b.dest[0].data(), 3, 3, true, n); }},
+    {"shift32 (32 bits)", false, [](const FastConvertSamples& c, Buffers& b, long n) { c.shift32(b.dest[0].data(), 31, 4, false, n); }},
+    {"reverseEndian (16 bits)", false, [](const FastConvertSamples& c, Buffers& b, long n) { c.reverseEndian(b.dest[0].data(), 2, n); }},
+    {"reverseEndian (24 bits)", false, [](const FastConvertSamples& c, Buffers& b, long n) { c.reverseEndian(b.dest[0].data(), 3, n); }},
+    {"reverseEndian (32 bits)", false, [](const FastConvertSamples& c, Buffers& b, long n) { c.reverseEndian(b.dest[0].data(), 4, n); }},
+    IN_PLACE(int32to16inPlace, void, false), IN_PLACE(int24to16inPlace, void, false),
+    IN_PLACE(int32to24inPlace, void, false), IN_PLACE(int16to24inPlace, void, false),
+    IN_PLACE(int24to32inPlace, void, false), IN_PLACE(int16to32inPlace, void, false),
+    IN_PLACE(float32toInt16inPlace, float, true), IN_PLACE(float32toInt24inPlace, float, true),
+    IN_PLACE(float32toInt32inPlace, float, true),
+  };
+}
+
+Buffers makeBuffers(long frames, bool floatSource, std::mt19937& rng) {
+  Buffers b;
+  b.left = randomSamples(frames, rng);
+  b.right = randomSamples(frames, rng);
+  if (floatSource) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (int32_t& sample : b.left) {
+      const float value = dist(rng);
+      std::memcpy(&sample, &value, sizeof(value));
+    }
+  }
+  // Les expansions en place (16 -> 32 bits) écrivent jusqu'à 4 octets par trame dans
+  // dest[0] ; le reste est rempli d'un motif pour détecter toute écriture au-delà
+  for (std::vector<unsigned char>& dest : b.dest) {
+    dest.assign(static_cast<size_t>(frames) * 6 + 64, 0x5a);
+  }
+  std::memcpy(b.dest[0].data(), b.left.data(), static_cast<size_t>(frames) * sizeof(int32_t));
+  return b;
+}
+
+void checkLevels(std::mt19937& rng) {
+  const FastConvertSamples scalar(SimdLevel::Scalar);
+  const SimdLevel detected = detectSimdLevel();
+  for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (level > detected) {
+      break;
+    }
+    const FastConvertSamples fast(level);
+    for (const Method& method : allMethods()) {
+      for (long frames : {1L, 3L, 7L, 15L, 16L, 17L, 31L, 33L, 67L, 1023L}) {
+        Buffers expected = makeBuffers(frames, method.floatSource, rng);
+        Buffers actual = expected;
+        method.run(scalar, expected, frames);
+        method.run(fast, actual, frames);
+        if (expected.dest[0] != actual.dest[0] || expected.dest[1] != actual.dest[1]) {
+          fail("SIMD différent du scalaire", method.name, frames);
+        }
+      }
+    }
+  }
+}
+
+// --- shift32 hors limites ---
+
+void checkShiftLimits(std::mt19937& rng) {
+  const long frames = 67;
+  const std::vector<int32_t> source = randomSamples(frames, rng);
+  const long invalid[][2] = {{-1, 2}, {32, 2}, {40, 3}, {64, 4}, {8, 1}, {8, 5}};
+  for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (level > detectSimdLevel()) {
+      break;
+    }
+    const FastConvertSamples converter(level);
+    for (const long* parameters : invalid) {
+      for (bool revert : {false, true}) {
+        std::vector<int32_t> buffer = source;
+        converter.shift32(buffer.data(), parameters[0], parameters[1], revert, frames);
+        if (buffer != source) {
+          fail("shift32 hors limites a modifié le buffer", "shift32", frames);
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  std::mt19937 rng(1234);
+  checkReference(rng);
+  checkLevels(rng);
+  checkShiftLimits(rng);
+  if (failures > 0) {
+    std::printf("\n%d écart(s)\n", failures);
+    return 1;
+  }
+  std::printf("FastConvertSamples : %zu méthodes vérifiées\n", allMethods().size());
+  return 0;
+}
@@ -0,0 +1,89 @@
+// Vérification du moteur FFT contre une DFT directe en double précision
+// Pour chaque taille (puissances de deux, tailles ASIO à radix 3 et 5, radix premiers
+// génériques, tailles impaires) : transformée directe comparée à la DFT, puis aller-retour
+// forward -> inverse comparé au signal d'origine.
+//
+// Usage : fft_test   (code de retour non nul si une taille dépasse la tolérance)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../aligned_buffer.h"
+#include "../fft_engine.h"
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Erreurs relatives au plus grand coefficient (float : quelques ulp par étage)
+const double kForwardTolerance = 2e-6;
+const double kRoundTripTolerance = 2e-6;
+
+struct Result {
+  double forward;
+  double roundTrip;
+};
+
+Result check(size_t n, std::mt19937& rng) {
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  AlignedBuffer<float> input(n);
+  for (size_t i = 0; i < n; i++) {
+    input[i] = dist(rng);
+  }
+
+  std::shared_ptr<const FFTPlan> plan = FFTPlan::get(n);
+  FFTWorkspace workspace;
+  plan->prepare(workspace);
+  const size_t bins = plan->numBins();
+  AlignedBuffer<float> re(bins), im(bins), output(n);
+  plan->forward(input.data(), re.data(), im.data(), workspace);
+
+  // DFT directe : X[k] = somme x[t] * exp(-2 pi i k t / n)
+  double peak = 0.0;
+  double forwardError = 0.0;
+  for (size_t k = 0; k < bins; k++) {
+    double sumRe = 0.0;
+    double sumIm = 0.0;
+    for (size_t t = 0; t < n; t++) {
+      const double angle = -2.0 * kPi * static_cast<double>((k * t) % n) / static_cast<double>(n);
+      sumRe += input[t] * std::cos(angle);
+      sumIm += input[t] * std::sin(angle);
+    }
+    peak = std::max(peak, std::hypot(sumRe, sumIm));
+    forwardError = std::max(forwardError, std::hypot(re[k] - sumRe, im[k] - sumIm));
+  }
+
+  plan->inverse(re.data(), im.data(), output.data(), workspace);
+  double roundTripError = 0.0;
+  for (size_t t = 0; t < n; t++) {
+    roundTripError = std::max(roundTripError, std::fabs(static_cast<double>(output[t]) - input[t]));
+  }
+  return Result{forwardError / std::max(peak, 1e-30), roundTripError};
+}
+
+} // namespace
+
+int main() {
+  const size_t sizes[] = {2,  4,  8,   16,  32,  64,  128, 256, 512, 1024, 2048, 4096,
+                          6,  12, 24,  48,  96,  192, 384, 480, 960, 1920, 10,  40,
+                          14, 22, 26,  98,  15,  27,  45,  49,  121, 1000, 2000};
+  std::mt19937 rng(42);
+  int failures = 0;
+  std::printf("%6s %14s %14s\n", "taille", "directe", "aller-retour");
+  for (size_t n : sizes) {
+    const Result result = check(n, rng);
+    const bool ok = result.forward <= kForwardTolerance && result.roundTrip <= kRoundTripTolerance;
+    if (!ok) {
+      failures++;
+    }
+    std::printf("%6zu %14.3e %14.3e%s\n", n, result.forward, result.roundTrip, ok ? "" : "  ÉCHEC");
+  }
+  if (failures > 0) {
+    std::printf("\n%d taille(s) hors tolérance\n", failures);
+    return 1;
+  }
+  return 0;
+}
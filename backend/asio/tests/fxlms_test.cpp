@@ -0,0 +1,105 @@
+// Convergence du FxLMS en boucle fermée
+// Bruit large bande (référence) arrivant au micro d'erreur par un chemin primaire
+// (retards et gains) ; l'anti-bruit y arrive par le chemin secondaire réel, modélisé
+// à l'identique dans la configuration. Le micro d'erreur d'un bloc ne contient l'anti-bruit
+// que des blocs précédents (retard secondaire d'au moins un bloc), comme avec une carte
+// son. Le bruit résiduel des derniers blocs doit être atténué de plus de kMinAttenuationDb.
+//
+// Usage : fxlms_test   (code de retour non nul si un cas ne converge pas)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../aligned_buffer.h"
+#include "../fxlms_canceller.h"
+
+namespace {
+
+const double kMinAttenuationDb = 20.0;
+
+struct Case {
+  const char* name;
+  size_t block;
+  size_t taps;
+  size_t secondaryDelay;
+  float secondaryGain;
+  float stepSize;
+};
+
+// Chemin primaire : deux échos de la référence
+const size_t kPrimaryDelay1 = 400;
+const size_t kPrimaryDelay2 = 460;
+const float kPrimaryGain1 = 0.6f;
+const float kPrimaryGain2 = -0.3f;
+
+double attenuationDb(const Case& c) {
+  FxlmsConfig config;
+  config.taps = c.taps;
+  config.stepSize = c.stepSize;
+  config.secondaryDelay = c.secondaryDelay;
+  config.secondaryGain = c.secondaryGain;
+  FxlmsCanceller canceller;
+  canceller.configure(c.block, config);
+
+  const size_t blocks = 3000;
+  const size_t total = blocks * c.block;
+  std::mt19937 rng(3);
+  std::normal_distribution<float> noise(0.0f, 0.3f);
+  std::vector<float> reference(total);
+  for (float& sample : reference) {
+    sample = noise(rng);
+  }
+  std::vector<float> antiNoise(total, 0.0f);
+
+  AlignedBuffer<float> error(c.block), output(c.block);
+  const size_t measured = 200;
+  double noisePower = 0.0;
+  double residualPower = 0.0;
+  for (size_t b = 0; b < blocks; b++) {
+    const size_t start = b * c.block;
+    for (size_t i = 0; i < c.block; i++) {
+      const size_t n = start + i;
+      float primary = 0.0f;
+      if (n >= kPrimaryDelay1) primary += kPrimaryGain1 * reference[n - kPrimaryDelay1];
+      if (n >= kPrimaryDelay2) primary += kPrimaryGain2 * reference[n - kPrimaryDelay2];
+      // secondaryDelay >= block : seul l'anti-bruit des blocs précédents est entendu
+      const float secondary = n >= c.secondaryDelay ? c.secondaryGain * antiNoise[n - c.secondaryDelay] : 0.0f;
+      error[i] = primary + secondary;
+      if (b >= blocks - measured) {
+        noisePower += static_cast<double>(primary) * primary;
+        residualPower += static_cast<double>(error[i]) * error[i];
+      }
+    }
+    canceller.process(reference.data() + start, error.data(), output.data());
+    std::copy(output.data(), output.data() + c.block, antiNoise.begin() + static_cast<long>(start));
+  }
+  return 10.0 * std::log10(noisePower / std::max(residualPower, 1e-30));
+}
+
+} // namespace
+
+int main() {
+  const Case cases[] = {
+    {"bloc 64", 64, 512, 64, 1.0f, 0.5f},
+    {"bloc 128, gain 0.5", 128, 512, 192, 0.5f, 0.5f},
+    {"bloc 96", 96, 576, 96, 1.0f, 0.3f},
+  };
+  int failures = 0;
+  std::printf("%-20s %6s %6s %14s\n", "cas", "bloc", "taps", "atténuation");
+  for (const Case& c : cases) {
+    const double db = attenuationDb(c);
+    const bool ok = std::isfinite(db) && db >= kMinAttenuationDb;
+    if (!ok) {
+      failures++;
+    }
+    std::printf("%-20s %6zu %6zu %11.1f dB%s\n", c.name, c.block, c.taps, db, ok ? "" : "  ÉCHEC");
+  }
+  if (failures > 0) {
+    std::printf("\n%d cas sans convergence (moins de %.0f dB)\n", failures, kMinAttenuationDb);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,170 @@
+// Vérification des convertisseurs d'échantillons (sample_format.h)
+// - valeurs connues : pleine échelle, écrêtage, boutisme, conteneurs alignés à droite
+// - aller-retour entier -> float -> entier exact pour les formats de 24 bits et moins
+// - chaque niveau SIMD disponible produit exactement les mêmes octets et les mêmes floats
+//   que le scalaire, sur des longueurs impaires (queues scalaires comprises)
+//
+// Usage : sample_format_test   (code de retour non nul au premier écart signalé)
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../sample_format.h"
+
+namespace {
+
+const SampleFormat kFormats[] = {
+  SampleFormat::Int16MSB,   SampleFormat::Int24MSB,   SampleFormat::Int32MSB,   SampleFormat::Float32MSB,
+  SampleFormat::Float64MSB, SampleFormat::Int32MSB16, SampleFormat::Int32MSB18, SampleFormat::Int32MSB20,
+  SampleFormat::Int32MSB24, SampleFormat::Int16LSB,   SampleFormat::Int24LSB,   SampleFormat::Int32LSB,
+  SampleFormat::Float32LSB, SampleFormat::Float64LSB, SampleFormat::Int32LSB16, SampleFormat::Int32LSB18,
+  SampleFormat::Int32LSB20, SampleFormat::Int32LSB24,
+};
+
+struct Known {
+  SampleFormat format;
+  float value;
+  std::vector<uint8_t> bytes;
+};
+
+const Known kKnownValues[] = {
+  {SampleFormat::Int16LSB, 0.5f, {0x00, 0x40}},
+  {SampleFormat::Int16LSB, -1.0f, {0x00, 0x80}},
+  {SampleFormat::Int16LSB, 1.0f, {0xff, 0x7f}},         // écrêté à 32767
+  {SampleFormat::Int16LSB, -3.0f, {0x00, 0x80}},
+  {SampleFormat::Int16MSB, 0.5f, {0x40, 0x00}},
+  {SampleFormat::Int24LSB, 0.5f, {0x00, 0x00, 0x40}},
+  {SampleFormat::Int24MSB, 0.5f, {0x40, 0x00, 0x00}},
+  {SampleFormat::Int24LSB, -0.5f, {0x00, 0x00, 0xc0}},
+  {SampleFormat::Int32LSB, 0.5f, {0x00, 0x00, 0x00, 0x40}},
+  {SampleFormat::Int32LSB, 1.0f, {0x80, 0xff, 0xff, 0x7f}}, // plus grand float sous 2^31
+  {SampleFormat::Int32MSB, -1.0f, {0x80, 0x00, 0x00, 0x00}},
+  {SampleFormat::Int32LSB24, 0.5f, {0x00, 0x00, 0x40, 0x00}},
+  {SampleFormat::Int32LSB24, -0.5f, {0x00, 0x00, 0xc0, 0xff}}, // signe étendu
+  {SampleFormat::Int32MSB16, -0.5f, {0xff, 0xff, 0xc0, 0x00}},
+  {SampleFormat::Int32LSB20, 1.0f, {0xff, 0xff, 0x07, 0x00}},
+  {SampleFormat::Float32LSB, 0.25f, {0x00, 0x00, 0x80, 0x3e}},
+  {SampleFormat::Float32MSB, 0.25f, {0x3e, 0x80, 0x00, 0x00}},
+  {SampleFormat::Float64MSB, 0.25f, {0x3f, 0xd0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+};
+
+int failures = 0;
+
+void fail(const char* what, const SampleConverter* converter, size_t index) {
+  failures++;
+  std::printf("ÉCHEC %s : %s (%s), échantillon %zu\n", what, converter->name, converter->isa, index);
+}
+
+bool isInteger(SampleFormat format) {
+  return format != SampleFormat::Float32MSB && format != SampleFormat::Float32LSB &&
+         format != SampleFormat::Float64MSB && format != SampleFormat::Float64LSB;
+}
+
+void checkKnownValues() {
+  for (const Known& known : kKnownValues) {
+    const SampleConverter* converter = sampleConverterFor(known.format, SimdLevel::Scalar);
+    std::vector<uint8_t> bytes(converter->bytesPerSample, 0xaa);
+    converter->fromFloat(&known.value, bytes.data(), 1);
+    if (bytes != known.bytes) {
+      fail("valeur connue", converter, 0);
+    }
+  }
+}
+
+// Entier -> float -> entier : exact tant que la mantisse float suffit (24 bits)
+void checkRoundTrip(const SampleConverter* converter, std::mt19937& rng) {
+  if (!isInteger(converter->format) || converter->format == SampleFormat::Int32LSB ||
+      converter->format == SampleFormat::Int32MSB) {
+    return;
+  }
+  const size_t count = 1001;
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> source(count), decoded(count);
+  for (float& sample : source) {
+    sample = dist(rng);
+  }
+  std::vector<uint8_t> encoded(count * converter->bytesPerSample), again(encoded.size());
+  converter->fromFloat(source.data(), encoded.data(), count);
+  converter->toFloat(encoded.data(), decoded.data(), count);
+  converter->fromFloat(decoded.data(), again.data(), count);
+  for (size_t i = 0; i < encoded.size(); i++) {
+    if (encoded[i] != again[i]) {
+      fail("aller-retour", converter, i / converter->bytesPerSample);
+      return;
+    }
+  }
+}
+
+// Niveau SIMD contre scalaire : mêmes octets (fromFloat) et mêmes floats (toFloat)
+void checkAgainstScalar(const SampleConverter* converter, const SampleConverter* scalar, std::mt19937& rng) {
+  for (size_t count : {1, 3, 7, 15, 17, 31, 67, 1023}) {
+    std::uniform_real_distribution<float> dist(-1.5f, 1.5f);
+    std::vector<float> source(count);
+    for (float& sample : source) {
+      sample = dist(rng);
+    }
+    // Valeurs limites en tête : zéro, pleine échelle, écrêtage, NaN
+    const float specials[] = {0.0f, -0.0f, 1.0f, -1.0f, 2.0f, -2.0f, 1e-9f, std::numeric_limits<float>::quiet_NaN()};
+    for (size_t i = 0; i < count && i < sizeof(specials) / sizeof(specials[0]); i++) {
+      source[i] = specials[i];
+    }
+    if (!isInteger(converter->format)) {
+      source[count - 1] = 0.5f; // NaN n'a pas de représentation unique en float
+      if (count > 7) source[7] = 0.25f;
+    }
+
+    const size_t bytes = count * converter->bytesPerSample;
+    std::vector<uint8_t> expected(bytes), actual(bytes);
+    scalar->fromFloat(source.data(), expected.data(), count);
+    converter->fromFloat(source.data(), actual.data(), count);
+    if (expected != actual) {
+      fail("fromFloat différent du scalaire", converter, count);
+    }
+
+    std::vector<float> expectedFloat(count), actualFloat(count);
+    scalar->toFloat(expected.data(), expectedFloat.data(), count);
+    converter->toFloat(expected.data(), actualFloat.data(), count);
+    if (std::memcmp(expectedFloat.data(), actualFloat.data(), count * sizeof(float)) != 0) {
+      fail("toFloat différent du scalaire", converter, count);
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  checkKnownValues();
+
+  std::mt19937 rng(11);
+  const SimdLevel detected = detectSimdLevel();
+  for (SampleFormat format : kFormats) {
+    const SampleConverter* scalar = sampleConverterFor(format, SimdLevel::Scalar);
+    if (scalar == nullptr) {
+      std::printf("ÉCHEC format %ld sans convertisseur\n", static_cast<long>(format));
+      failures++;
+      continue;
+    }
+    checkRoundTrip(scalar, rng);
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+      if (level > detected) {
+        break;
+      }
+      const SampleConverter* converter = sampleConverterFor(format, level);
+      if (converter != scalar) {
+        checkAgainstScalar(converter, scalar, rng);
+      }
+    }
+  }
+
+  if (failures > 0) {
+    std::printf("\n%d écart(s)\n", failures);
+    return 1;
+  }
+  std::printf("Convertisseurs d'échantillons : %zu formats vérifiés\n", sizeof(kFormats) / sizeof(kFormats[0]));
+  return 0;
+}
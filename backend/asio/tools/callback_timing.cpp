@@ -0,0 +1,319 @@
+// Chronométrage du callback ASIO sans carte son, avec le pilote virtuel
+// Le thread d'horloge du pilote appelle bufferSwitchTimeInfo à la période réelle du
+// buffer ; le callback exécute le même chemin que le module Node (conversion Int32LSB,
+// ProcessingChain, mesure de niveau, conversion de sortie). En fin d'exécution :
+// temps de traitement, intervalles entre callbacks, charge DSP et charge CPU.
+// Avec --virtual, l'horloge virtuelle du pilote enchaîne les callbacks : S secondes
+// d'audio sont rejouées aussi vite que possible, et l'empreinte des sorties permet de
+// vérifier que deux exécutions donnent des résultats identiques au bit près.
+// --priority P, --cpu N et --mlock appliquent au thread du pilote les réglages temps réel
+// du module (SCHED_FIFO, affinité, mlock des buffers et des plans ; --mlockall : tout le
+// processus) : mesure des petits buffers sous charge.
+//
+// Usage : callback_timing [--seconds S] [--block N] [--rate R] [--channels N] [--fxlms TAPS] [--virtual]
+//                         [--priority P] [--cpu N] [--mlock] [--mlockall]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../block_clock.h"
+#include "../callback_stats.h"
+#include "../dsp_kernels.h"
+#include "../level_meter.h"
+#include "../processing_chain.h"
+#include "../realtime_thread.h"
+#include "../sample_format.h"
+#include "../virtual_asio_driver.h"
+
+namespace {
+
+// État du callback (fonctions libres : les callbacks ASIO sont de simples pointeurs)
+struct Binding {
+  const SampleConverter* converter;
+  void* buffers[2];
+  float* planes[2];
+};
+
+VirtualAsioDriver* driver = nullptr;
+ProcessingChain chain;
+LevelMeter meter;
+BlockClock blockClock;
+CallbackStats stats;
+std::vector<Binding> inputBindings;
+std::vector<Binding> outputBindings;
+size_t blockSize = 0;
+
+// Horloge virtuelle : empreinte FNV-1a de toutes les sorties (thread du pilote uniquement)
+bool hashOutputs = false;
+uint64_t outputHash = 14695981039346656037ull;
+
+int64_t monotonicNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double asio64ToDouble(const ASIOSamples& value) {
+  return static_cast<double>(value.hi) * 4294967296.0 + static_cast<double>(value.lo);
+}
+
+double asio64ToDouble(const ASIOTimeStamp& value) {
+  return static_cast<double>(value.hi) * 4294967296.0 + static_cast<double>(value.lo);
+}
+
+void processBlock(long index) {
+  for (const Binding& binding : inputBindings) {
+    binding.converter->toFloat(binding.buffers[index & 1], binding.planes[index & 1], blockSize);
+  }
+  chain.process(index);
+  meter.process(chain.analysisInput(index), blockSize);
+  for (const Binding& binding : outputBindings) {
+    binding.converter->fromFloat(binding.planes[index & 1], binding.buffers[index & 1], blockSize);
+    if (hashOutputs) {
+      const unsigned char* bytes = static_cast<const unsigned char*>(binding.buffers[index & 1]);
+      for (size_t i = 0; i < blockSize * binding.converter->bytesPerSample; i++) {
+        outputHash = (outputHash ^ bytes[i]) * 1099511628211ull;
+      }
+    }
+  }
+}
+
+ASIOTime* bufferSwitchTimeInfo(ASIOTime* params, long index, ASIOBool) {
+  const int64_t start = monotonicNs();
+  blockClock.record(asio64ToDouble(params->timeInfo.samplePosition), asio64ToDouble(params->timeInfo.systemTime),
+                    kBlockPositionValid | kBlockTimeValid, index);
+  processBlock(index);
+  stats.record(start, monotonicNs());
+  return nullptr;
+}
+
+void bufferSwitch(long index, ASIOBool) {
+  const int64_t start = monotonicNs();
+  processBlock(index);
+  stats.record(start, monotonicNs());
+}
+
+void sampleRateDidChange(ASIOSampleRate) {}
+
+long asioMessage(long selector, long value, void*, double*) {
+  if (selector == kAsioSelectorSupported) {
+    return value == kAsioSupportsTimeInfo ? 1L : 0L;
+  }
+  return selector == kAsioSupportsTimeInfo ? 1L : 0L;
+}
+
+void usage() {
+  std::fprintf(stderr, "Usage : callback_timing [--seconds S] [--block N] [--rate R] [--channels N] [--fxlms TAPS] [--virtual]\n"
+                       "                        [--priority P] [--cpu N] [--mlock] [--mlockall]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  double seconds = 5.0;
+  long block = VirtualAsioDriver::kPreferredBlockFrames;
+  double rate = 48000.0;
+  long channels = 2;
+  size_t fxlmsTaps = 0;
+  RealtimeOptions realtime;
+  realtime.lockMemory = false;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--virtual") {
+      hashOutputs = true;
+      continue;
+    }
+    if (arg == "--mlock") {
+      realtime.lockMemory = true;
+      continue;
+    }
+    if (arg == "--mlockall") {
+      realtime.lockMemory = true;
+      realtime.lockProcess = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      usage();
+      return 2;
+    }
+    if (arg == "--seconds") {
+      seconds = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--block") {
+      block = std::strtol(argv[++i], nullptr, 10);
+    } else if (arg == "--rate") {
+      rate = std::strtod(argv[++i], nullptr);
+    } else if (arg == "--channels") {
+      channels = std::strtol(argv[++i], nullptr, 10);
+    } else if (arg == "--fxlms") {
+      fxlmsTaps = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--priority") {
+      realtime.priority = static_cast<int>(std::strtol(argv[++i], nullptr, 10));
+      realtime.enabled = true;
+    } else if (arg == "--cpu") {
+      realtime.cpu = static_cast<int>(std::strtol(argv[++i], nullptr, 10));
+      realtime.enabled = true;
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (seconds <= 0.0 || channels < 1 || (fxlmsTaps > 0 && channels < 2)) {
+    std::fprintf(stderr, "Paramètres invalides (le mode FxLMS demande au moins 2 canaux)\n");
+    return 2;
+  }
+
+  VirtualAsioDriver virtualDriver(channels, channels, rate);
+  driver = &virtualDriver;
+  if (driver->setSampleRate(rate) != ASE_OK) {
+    std::fprintf(stderr, "Fréquence non supportée : %g\n", rate);
+    return 2;
+  }
+  const DspKernels& kernels = selectDspKernels();
+  const SampleConverter* converter = sampleConverterFor(SampleFormat::Int32LSB, kernels.level);
+
+  // Inversion : entrée i -> sortie i ; FxLMS : référence 0 -> sortie 0, micro d'erreur sur l'entrée 1
+  ChainSettings settings;
+  if (fxlmsTaps > 0) {
+    settings.mode = ProcessingMode::Fxlms;
+    settings.routes.push_back(Route{0, 0, 1.0f});
+    settings.errorChannel = 1;
+    settings.fxlms.taps = fxlmsTaps;
+    settings.fxlms.secondaryDelay = static_cast<size_t>(3 * block);
+  } else {
+    for (long c = 0; c < channels; c++) {
+      settings.routes.push_back(Route{c, c, 1.0f});
+    }
+  }
+  blockSize = static_cast<size_t>(block);
+  chain.configure(settings, rate, blockSize);
+  meter.configure(rate, blockSize);
+  blockClock.configure(rate, block);
+  blockClock.reset();
+  stats.configure(rate, blockSize);
+  stats.reset();
+
+  const std::vector<long>& inputs = chain.routing().inputChannels();
+  const std::vector<long>& outputs = chain.routing().outputChannels();
+  std::vector<ASIOBufferInfo> bufferInfos(inputs.size() + outputs.size(), ASIOBufferInfo());
+  for (size_t i = 0; i < bufferInfos.size(); i++) {
+    const bool isInput = i < inputs.size();
+    bufferInfos[i].isInput = isInput ? ASIOTrue : ASIOFalse;
+    bufferInfos[i].channelNum = isInput ? inputs[i] : outputs[i - inputs.size()];
+  }
+  ASIOCallbacks callbacks;
+  callbacks.bufferSwitch = &bufferSwitch;
+  callbacks.sampleRateDidChange = &sampleRateDidChange;
+  callbacks.asioMessage = &asioMessage;
+  callbacks.bufferSwitchTimeInfo = &bufferSwitchTimeInfo;
+  const uint64_t blockLimit = static_cast<uint64_t>(std::ceil(seconds * rate / static_cast<double>(block)));
+  driver->setClock(hashOutputs ? DriverClock::Virtual : DriverClock::RealTime, blockLimit);
+  if (driver->createBuffers(bufferInfos.data(), static_cast<long>(bufferInfos.size()), block, &callbacks) != ASE_OK) {
+    std::fprintf(stderr, "Taille de bloc refusée par le pilote virtuel : %ld (%ld à %ld)\n", block,
+                 VirtualAsioDriver::kMinBlockFrames, VirtualAsioDriver::kMaxBlockFrames);
+    return 2;
+  }
+  for (size_t i = 0; i < bufferInfos.size(); i++) {
+    const bool isInput = i < inputs.size();
+    const size_t slot = isInput ? i : i - inputs.size();
+    Binding binding;
+    binding.converter = converter;
+    for (long half = 0; half < 2; half++) {
+      binding.buffers[half] = bufferInfos[i].buffers[half];
+      binding.planes[half] = isInput ? chain.routing().inputPlane(half, slot) : chain.routing().outputPlane(half, slot);
+    }
+    (isInput ? inputBindings : outputBindings).push_back(binding);
+  }
+
+  std::printf("Pilote virtuel : %ld canaux, %ld trames à %.0f Hz (%.3f ms), %s, noyaux %s, horloge %s\n", channels,
+              block, rate, 1000.0 * static_cast<double>(block) / rate, fxlmsTaps > 0 ? "FxLMS" : "inversion",
+              kernels.name, hashOutputs ? "virtuelle" : "réelle");
+
+  // Réglages temps réel : mémoire verrouillée une fois tout alloué, thread du pilote réglé
+  // avant son premier bloc (rapport disponible au retour de start())
+  RealtimeMemoryReport memory;
+  std::vector<MemoryRegion> lockedRegions;
+  if (realtime.lockMemory) {
+    std::vector<MemoryRegion> regions;
+    const size_t driverBytes = converter->bytesPerSample * blockSize;
+    for (const std::vector<Binding>* bindings : {&inputBindings, &outputBindings}) {
+      for (const Binding& binding : *bindings) {
+        for (long half = 0; half < 2; half++) {
+          regions.push_back(MemoryRegion{"driverBuffers", binding.buffers[half], driverBytes});
+        }
+      }
+    }
+    chain.memoryRegions(regions);
+    lockMemoryRegions(regions, &lockedRegions, &memory);
+    if (realtime.lockProcess) {
+      lockProcessMemory(&memory);
+    }
+  }
+  RealtimeThreadReport threadReport;
+  if (realtime.enabled) {
+    driver->setThreadSetup([&] { threadReport = applyRealtimeThread(realtime); });
+  }
+
+  const std::clock_t cpuStart = std::clock();
+  const int64_t wallStart = monotonicNs();
+  driver->start();
+  if (realtime.enabled) {
+    std::printf("Thread temps réel : SCHED_FIFO %d %s, cœur %d %s, %zu Kio de pile préchargés\n", realtime.priority,
+                threadReport.priorityApplied ? "appliqué" : threadReport.priorityError.c_str(), realtime.cpu,
+                threadReport.affinityApplied ? "appliqué" : realtime.cpu < 0 ? "non demandé" : threadReport.affinityError.c_str(),
+                threadReport.stackPrefaulted / 1024);
+  }
+  if (realtime.lockMemory) {
+    std::printf("Mémoire : %s (%zu Kio verrouillés)\n", memory.locked ? "verrouillée" : memory.error.c_str(),
+                memory.lockedBytes / 1024);
+    for (const RealtimeRegionReport& region : memory.regions) {
+      std::printf("  %-14s %8zu octets%s\n", region.name.c_str(), region.bytes, region.locked ? "" : " (non verrouillés)");
+    }
+  }
+  if (realtime.lockProcess) {
+    std::printf("Processus : %s (%zu Kio verrouillés%s)\n", memory.processLocked ? "verrouillé" : memory.processError.c_str(),
+                memory.processLockedBytes / 1024, memory.future ? ", allocations suivantes comprises" : "");
+  }
+  if (hashOutputs) {
+    while (!driver->finished()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  } else {
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  }
+  driver->stop();
+  unlockMemoryRegions(lockedRegions);
+  const double wall = static_cast<double>(monotonicNs() - wallStart) / 1e9;
+  const double cpu = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+  const CallbackStatsSnapshot snapshot = stats.snapshot();
+  const BlockClockStats clockStats = blockClock.stats();
+  std::printf("Callbacks : %llu, blocs perdus : %llu (pilote) / %llu (horloge), en retard : %llu, dépassements : %llu\n",
+              static_cast<unsigned long long>(snapshot.callbacks),
+              static_cast<unsigned long long>(driver->skippedBlocks()),
+              static_cast<unsigned long long>(clockStats.droppedBlocks),
+              static_cast<unsigned long long>(snapshot.lateCallbacks),
+              static_cast<unsigned long long>(snapshot.overruns));
+  std::printf("Traitement : moyen %.1f µs, p99 %.0f µs, max %.1f µs\n", snapshot.meanProcessingUs,
+              stats.processingHistogram().quantile(0.99), snapshot.maxProcessingUs);
+  std::printf("Intervalle : moyen %.1f µs (nominal %.1f µs), p99 %.0f µs, max %.1f µs, gigue moyenne %.1f µs\n",
+              snapshot.meanIntervalUs, snapshot.periodUs, stats.intervalHistogram().quantile(0.99),
+              snapshot.maxIntervalUs, clockStats.jitterMeanNs / 1e3);
+  std::printf("Charge DSP : moyenne %.2f %%, crête %.2f %% ; charge CPU du processus : %.2f %%\n",
+              100.0 * snapshot.meanDspLoad, 100.0 * snapshot.peakDspLoad, 100.0 * cpu / wall);
+  if (hashOutputs) {
+    const double audioSeconds = static_cast<double>(driver->blocks()) * static_cast<double>(block) / rate;
+    const LevelSnapshot levels = meter.snapshot();
+    std::printf("Horloge virtuelle : %.1f s d'audio en %.2f s (x%.0f), fréquence mesurée %.3f Hz, niveau RMS %.9f\n",
+                audioSeconds, wall, audioSeconds / wall, clockStats.measuredSampleRate, levels.rms);
+    std::printf("Empreinte des sorties : %016llx\n", static_cast<unsigned long long>(outputHash));
+  }
+
+  driver->disposeBuffers();
+  return 0;
+}
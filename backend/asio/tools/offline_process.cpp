@@ -0,0 +1,135 @@
+// Traitement hors ligne de fichiers WAV en ligne de commande
+// Même chaîne DSP et mêmes convertisseurs que le callback ASIO, sans pilote :
+// utilisable sous Linux pour rejouer des enregistrements plus vite que le temps réel.
+//
+// Usage : offline_process [options] entrée.wav sortie.wav [entrée2.wav sortie2.wav ...]
+//   --threads N          fichiers traités en parallèle (défaut 1, 0 : un par cœur)
+//   --block N            taille de bloc simulée (défaut 1024)
+//   --gain G             facteur d'inversion (défaut 1)
+//   --route E:S[:G]      route entrée -> sortie (répétable, défaut 0:0)
+//   --format F           int16 | int24 | int32 | float32 | float64 (défaut : format d'entrée)
+//   --mode fxlms --error-channel N [--taps N] [--step-size X] [--secondary-delay N] [--secondary-gain G]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../dsp_kernels.h"
+#include "../offline_processor.h"
+
+namespace {
+
+void usage() {
+  std::fprintf(stderr,
+               "Usage : offline_process [--threads N] [--block N] [--gain G] [--route E:S[:G]] [--format F]\n"
+               "                        [--mode inversion|fxlms --error-channel N --taps N --step-size X\n"
+               "                         --secondary-delay N --secondary-gain G]\n"
+               "                        entrée.wav sortie.wav [entrée2.wav sortie2.wav ...]\n");
+}
+
+bool parseRoute(const char* text, Route* route) {
+  long input = 0;
+  long output = 0;
+  float gain = 1.0f;
+  const int fields = std::sscanf(text, "%ld:%ld:%f", &input, &output, &gain);
+  if (fields < 2 || input < 0 || output < 0) {
+    return false;
+  }
+  *route = Route{input, output, gain};
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  OfflineJob defaults;
+  unsigned threads = 1;
+  std::vector<std::string> paths;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--help" || arg == "-h") {
+      usage();
+      return 0;
+    } else if (arg.compare(0, 2, "--") != 0) {
+      paths.push_back(arg);
+    } else if (!hasValue) {
+      std::fprintf(stderr, "Valeur manquante pour %s\n", arg.c_str());
+      return 2;
+    } else if (arg == "--threads") {
+      threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--block") {
+      defaults.blockSize = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--gain") {
+      defaults.settings.gain = std::strtof(argv[++i], nullptr);
+    } else if (arg == "--route") {
+      Route route;
+      if (!parseRoute(argv[++i], &route)) {
+        std::fprintf(stderr, "Route invalide : %s\n", argv[i]);
+        return 2;
+      }
+      defaults.settings.routes.push_back(route);
+    } else if (arg == "--format") {
+      if (!offlineFormatFromName(argv[++i], &defaults.outputFormat)) {
+        std::fprintf(stderr, "Format de sortie inconnu : %s\n", argv[i]);
+        return 2;
+      }
+      defaults.keepFormat = false;
+    } else if (arg == "--mode") {
+      const std::string mode = argv[++i];
+      if (mode != "fxlms" && mode != "inversion") {
+        std::fprintf(stderr, "Mode de traitement inconnu : %s\n", mode.c_str());
+        return 2;
+      }
+      defaults.settings.mode = mode == "fxlms" ? ProcessingMode::Fxlms : ProcessingMode::Inversion;
+    } else if (arg == "--error-channel") {
+      defaults.settings.errorChannel = std::strtol(argv[++i], nullptr, 10);
+    } else if (arg == "--taps") {
+      defaults.settings.fxlms.taps = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--step-size") {
+      defaults.settings.fxlms.stepSize = std::strtof(argv[++i], nullptr);
+    } else if (arg == "--secondary-delay") {
+      defaults.settings.fxlms.secondaryDelay = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--secondary-gain") {
+      defaults.settings.fxlms.secondaryGain = std::strtof(argv[++i], nullptr);
+    } else {
+      std::fprintf(stderr, "Option inconnue : %s\n", arg.c_str());
+      usage();
+      return 2;
+    }
+  }
+  if (paths.empty() || paths.size() % 2 != 0) {
+    usage();
+    return 2;
+  }
+
+  std::vector<OfflineJob> jobs;
+  for (size_t i = 0; i < paths.size(); i += 2) {
+    OfflineJob job = defaults;
+    job.input = paths[i];
+    job.output = paths[i + 1];
+    jobs.push_back(job);
+  }
+
+  const DspKernels& kernels = selectDspKernels();
+  std::printf("Noyaux : %s, %zu fichier(s), %u thread(s)\n", kernels.name, jobs.size(), threads);
+
+  const std::vector<OfflineResult> results = processFiles(jobs, threads);
+  int failures = 0;
+  for (size_t i = 0; i < results.size(); i++) {
+    const OfflineResult& result = results[i];
+    if (!result.success) {
+      std::fprintf(stderr, "%s : %s\n", jobs[i].input.c_str(), result.error.c_str());
+      failures++;
+      continue;
+    }
+    std::printf("%s -> %s : %llu trames, %u -> %u canaux, %.1f s audio en %.3f s (x%.0f)\n",
+                jobs[i].input.c_str(), jobs[i].output.c_str(), static_cast<unsigned long long>(result.frames),
+                result.inputChannels, result.outputChannels, result.frames / result.sampleRate,
+                result.seconds, result.realtimeFactor);
+  }
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,316 @@
+#include "virtual_asio_driver.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <future>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+// Entier 64 bits ASIO {hi, lo} (NATIVE_INT64 vaut 0 dans asiotypes.h)
+template <typename Asio64>
+void toAsio64(int64_t value, Asio64* out) {
+  const uint64_t bits = static_cast<uint64_t>(value);
+  out->hi = static_cast<unsigned long>(bits >> 32);
+  out->lo = static_cast<unsigned long>(bits & 0xffffffffu);
+}
+
+} // namespace
+
+VirtualAsioDriver::VirtualAsioDriver(long inputs, long outputs, double sampleRate)
+  : numInputs(inputs), numOutputs(outputs), rate(sampleRate) {}
+
+VirtualAsioDriver::~VirtualAsioDriver() {
+  disposeBuffers();
+}
+
+ASIOError VirtualAsioDriver::init(ASIODriverInfo* info) {
+  if (info) {
+    std::strcpy(info->name, "Simulation ASIO");
+    info->asioVersion = 2;
+    info->driverVersion = 1;
+    info->errorMessage[0] = 0;
+  }
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::start() {
+  if (!buffersCreated) {
+    return ASE_NotPresent;
+  }
+  if (started.load()) {
+    return ASE_OK;
+  }
+  toggle = 0;
+  samplePosition.store(0, std::memory_order_relaxed);
+  systemTimeNs.store(0, std::memory_order_relaxed);
+  delivered.store(0, std::memory_order_relaxed);
+  skipped.store(0, std::memory_order_relaxed);
+  clockFinished.store(false);
+  started.store(true);
+  std::promise<void> ready;
+  std::future<void> setupDone = ready.get_future();
+  clockThread = std::thread([this, &ready] {
+    if (threadSetup) {
+      threadSetup();
+    }
+    ready.set_value();
+    run();
+  });
+  setupDone.wait();
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::stop() {
+  // Au plus une période d'attente : le thread vérifie l'indicateur à chaque réveil
+  started.store(false);
+  if (clockThread.joinable()) {
+    clockThread.join();
+  }
+  return ASE_OK;
+}
+
+void VirtualAsioDriver::setClock(DriverClock newClock, uint64_t blockLimit) {
+  if (!started.load()) {
+    clockMode = newClock;
+    maxBlocks = blockLimit;
+  }
+}
+
+void VirtualAsioDriver::setThreadSetup(std::function<void()> setup) {
+  if (!started.load()) {
+    threadSetup = std::move(setup);
+  }
+}
+
+ASIOError VirtualAsioDriver::getChannels(long* numInputChannels, long* numOutputChannels) const {
+  if (numInputChannels) *numInputChannels = numInputs;
+  if (numOutputChannels) *numOutputChannels = numOutputs;
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::getLatencies(long* inputLatency, long* outputLatency) const {
+  // Comme AsioSample : un bloc en entrée, deux en sortie (double buffer) ; un seul une fois
+  // les buffers créés si l'hôte peut signaler ASIOOutputReady
+  if (inputLatency) *inputLatency = blockFrames;
+  if (outputLatency) *outputLatency = blockFrames * (outputReadyEnabled && buffersCreated ? 1 : 2);
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::outputReady() {
+  if (!outputReadyEnabled) {
+    return ASE_NotPresent;
+  }
+  outputReadyCalls.fetch_add(1, std::memory_order_relaxed);
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::getBufferSize(long* minSize, long* maxSize, long* preferredSize, long* granularity) const {
+  if (minSize) *minSize = kMinBlockFrames;
+  if (maxSize) *maxSize = kMaxBlockFrames;
+  if (preferredSize) *preferredSize = kPreferredBlockFrames;
+  if (granularity) *granularity = -1; // puissances de deux
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::canSampleRate(ASIOSampleRate sampleRate) const {
+  return (sampleRate >= 8000.0 && sampleRate <= 384000.0) ? ASE_OK : ASE_NoClock;
+}
+
+ASIOError VirtualAsioDriver::getSampleRate(ASIOSampleRate* sampleRate) const {
+  if (sampleRate) *sampleRate = rate;
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::setSampleRate(ASIOSampleRate sampleRate) {
+  if (canSampleRate(sampleRate) != ASE_OK) {
+    return ASE_NoClock;
+  }
+  if (sampleRate != rate) {
+    rate = sampleRate;
+    if (buffersCreated && hostCallbacks.sampleRateDidChange) {
+      hostCallbacks.sampleRateDidChange(rate);
+    }
+  }
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::getSamplePosition(ASIOSamples* position, ASIOTimeStamp* timeStamp) const {
+  if (position) toAsio64(samplePosition.load(std::memory_order_relaxed), position);
+  if (timeStamp) toAsio64(systemTimeNs.load(std::memory_order_relaxed), timeStamp);
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::getChannelInfo(ASIOChannelInfo* info) const {
+  if (!info || info->channel < 0 || info->channel >= (info->isInput ? numInputs : numOutputs)) {
+    return ASE_InvalidParameter;
+  }
+  info->isActive = ASIOFalse;
+  info->channelGroup = 0;
+  info->type = kSampleType;
+  std::snprintf(info->name, sizeof(info->name), "%s %ld", info->isInput ? "Entrée" : "Sortie", info->channel + 1);
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::createBuffers(ASIOBufferInfo* bufferInfos, long numChannels, long bufferSize,
+                                           ASIOCallbacks* callbacks) {
+  if (started.load()) {
+    return ASE_InvalidMode;
+  }
+  if (!bufferInfos || !callbacks || (!callbacks->bufferSwitch && !callbacks->bufferSwitchTimeInfo) ||
+      numChannels <= 0 || bufferSize < kMinBlockFrames || bufferSize > kMaxBlockFrames) {
+    return ASE_InvalidParameter;
+  }
+  for (long i = 0; i < numChannels; i++) {
+    const ASIOBufferInfo& info = bufferInfos[i];
+    if (info.channelNum < 0 || info.channelNum >= (info.isInput ? numInputs : numOutputs)) {
+      return ASE_InvalidParameter;
+    }
+  }
+
+  disposeBuffers();
+  blockFrames = bufferSize;
+  for (long i = 0; i < numChannels; i++) {
+    ASIOBufferInfo& info = bufferInfos[i];
+    std::vector<std::vector<int32_t>>& active = info.isInput ? inputBuffers : outputBuffers;
+    active.emplace_back(static_cast<size_t>(blockFrames) * 2, 0);
+    info.buffers[0] = active.back().data();
+    info.buffers[1] = active.back().data() + blockFrames;
+  }
+
+  sineWave.resize(static_cast<size_t>(blockFrames));
+  sawTooth.resize(static_cast<size_t>(blockFrames));
+  makeSine(sineWave.data());
+  makeSaw(sawTooth.data());
+
+  hostCallbacks = *callbacks;
+  timeInfoMode = hostCallbacks.bufferSwitchTimeInfo &&
+                 (!hostCallbacks.bufferSwitch ||
+                  (hostCallbacks.asioMessage && hostCallbacks.asioMessage(kAsioSupportsTimeInfo, 0, nullptr, nullptr) != 0));
+  asioTime = ASIOTime();
+  asioTime.timeInfo.speed = 1.0;
+  asioTime.timeInfo.sampleRate = rate;
+  asioTime.timeInfo.flags = kSystemTimeValid | kSamplePositionValid | kSampleRateValid;
+  asioTime.timeCode.speed = 1.0;
+  buffersCreated = true;
+  return ASE_OK;
+}
+
+ASIOError VirtualAsioDriver::disposeBuffers() {
+  stop();
+  inputBuffers.clear();
+  outputBuffers.clear();
+  hostCallbacks = ASIOCallbacks();
+  buffersCreated = false;
+  return ASE_OK;
+}
+
+void VirtualAsioDriver::makeSine(int32_t* wave) const {
+  const double f = (kPi * 2.0) / static_cast<double>(blockFrames);
+  for (long i = 0; i < blockFrames; i++) {
+    wave[i] = static_cast<int32_t>(2147483647.0 * std::sin(f * static_cast<double>(i)));
+  }
+}
+
+void VirtualAsioDriver::makeSaw(int32_t* wave) const {
+  const double f = 2.0 / static_cast<double>(blockFrames);
+  for (long i = 0; i < blockFrames; i++) {
+    wave[i] = static_cast<int32_t>(2147483647.0 * (-1.0 + f * static_cast<double>(i)));
+  }
+}
+
+void VirtualAsioDriver::input() {
+  const size_t bytes = static_cast<size_t>(blockFrames) * sizeof(int32_t);
+  const size_t offset = toggle ? static_cast<size_t>(blockFrames) : 0;
+  for (size_t i = 0; i < inputBuffers.size(); i++) {
+    std::memcpy(inputBuffers[i].data() + offset, (i & 1) ? sawTooth.data() : sineWave.data(), bytes);
+  }
+}
+
+void VirtualAsioDriver::bufferSwitch(int64_t timeNs) {
+  systemTimeNs.store(timeNs, std::memory_order_relaxed);
+  input();
+  if (timeInfoMode) {
+    bufferSwitchX();
+  } else {
+    hostCallbacks.bufferSwitch(toggle, ASIOFalse);
+  }
+  samplePosition.store(samplePosition.load(std::memory_order_relaxed) + blockFrames, std::memory_order_relaxed);
+  delivered.fetch_add(1, std::memory_order_relaxed);
+  toggle = toggle ? 0 : 1;
+}
+
+void VirtualAsioDriver::bufferSwitchX() {
+  getSamplePosition(&asioTime.timeInfo.samplePosition, &asioTime.timeInfo.systemTime);
+  hostCallbacks.bufferSwitchTimeInfo(&asioTime, toggle, ASIOFalse);
+  asioTime.timeInfo.flags &= ~(kSampleRateChanged | kClockSourceChanged);
+}
+
+void VirtualAsioDriver::run() {
+  if (clockMode == DriverClock::Virtual) {
+    runVirtual();
+    return;
+  }
+  // Échéance du bloc n calculée depuis le départ (pas de dérive cumulée sur les
+  // périodes non entières, 1024 / 44100 s par exemple)
+  const double periodNs = 1e9 * static_cast<double>(blockFrames) / rate;
+  const int64_t origin = nowNs();
+  uint64_t block = 0;
+  while (started.load(std::memory_order_acquire)) {
+    block++;
+    sleepUntilNs(origin + static_cast<int64_t>(std::llround(static_cast<double>(block) * periodNs)));
+    if (!started.load(std::memory_order_acquire)) {
+      break;
+    }
+    // Réveil après une ou plusieurs échéances suivantes : blocs perdus
+    const int64_t late = nowNs() - origin - static_cast<int64_t>(std::llround(static_cast<double>(block) * periodNs));
+    if (late >= static_cast<int64_t>(periodNs)) {
+      const uint64_t missed = static_cast<uint64_t>(static_cast<double>(late) / periodNs);
+      block += missed;
+      samplePosition.store(samplePosition.load(std::memory_order_relaxed) + static_cast<int64_t>(missed) * blockFrames,
+                           std::memory_order_relaxed);
+      skipped.fetch_add(missed, std::memory_order_relaxed);
+      toggle = (toggle + static_cast<long>(missed & 1)) & 1;
+    }
+    bufferSwitch(nowNs()); // horodatage au réveil, comme à l'interruption de la carte
+  }
+}
+
+void VirtualAsioDriver::runVirtual() {
+  // Temps système synthétisé depuis la position : cohérent avec la fréquence annoncée
+  // et indépendant de la machine, donc reproductible
+  const double periodNs = 1e9 * static_cast<double>(blockFrames) / rate;
+  for (uint64_t block = 0; maxBlocks == 0 || block < maxBlocks; block++) {
+    if (!started.load(std::memory_order_acquire)) {
+      return;
+    }
+    bufferSwitch(static_cast<int64_t>(std::llround(static_cast<double>(block) * periodNs)));
+  }
+  clockFinished.store(true, std::memory_order_release);
+}
+
+int64_t VirtualAsioDriver::nowNs() {
+  // steady_clock : CLOCK_MONOTONIC sous Linux, même horloge que le chronométrage de l'hôte
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void VirtualAsioDriver::sleepUntilNs(int64_t deadline) {
+#ifdef _WIN32
+  std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadline)));
+#else
+  timespec target;
+  target.tv_sec = static_cast<time_t>(deadline / 1000000000);
+  target.tv_nsec = static_cast<long>(deadline % 1000000000);
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {
+  }
+#endif
+}
@@ -0,0 +1,124 @@
+#ifndef __virtual_asio_driver__
+#define __virtual_asio_driver__
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "asiosys.h"
+#include "asio.h"
+
+// Pilote ASIO virtuel, sur le modèle de AsioSample (driver/asiosample/asiosmpl.cpp du SDK)
+// Canaux au format Int32LSB, double buffer contigu par canal actif. Les entrées reçoivent
+// les signaux de test du SDK : sinusoïde sur les canaux pairs, dents de scie sur les
+// impairs, une période par bloc (makeSine / makeSaw).
+// Au lieu de l'interruption de la carte, un thread dédié attend chaque échéance avec
+// clock_nanosleep (échéance absolue sur CLOCK_MONOTONIC) et appelle bufferSwitch ou
+// bufferSwitchTimeInfo à la période réelle du buffer : le callback de l'hôte est
+// chronométré comme avec une carte son, sans matériel (Linux compris).
+// Avec l'horloge virtuelle, les blocs sont enchaînés sans attente : position et temps
+// système de ASIOTime sont synthétisés (bloc n : n * taille de bloc, n * période depuis 0),
+// les signaux d'entrée sont ceux du SDK. Des heures de fonctionnement sont rejouées en
+// quelques minutes, avec des résultats identiques au bit près d'une exécution à l'autre.
+enum class DriverClock { RealTime, Virtual };
+
+class VirtualAsioDriver {
+public:
+  static const long kMinBlockFrames = 32;
+  static const long kMaxBlockFrames = 2048;
+  static const long kPreferredBlockFrames = 1024;
+  static const ASIOSampleType kSampleType = ASIOSTInt32LSB;
+
+  VirtualAsioDriver(long inputs = 2, long outputs = 2, double sampleRate = 44100.0);
+  ~VirtualAsioDriver();
+  VirtualAsioDriver(const VirtualAsioDriver&) = delete;
+  VirtualAsioDriver& operator=(const VirtualAsioDriver&) = delete;
+
+  // Interface ASIO (mêmes codes de retour que AsioSample)
+  ASIOError init(ASIODriverInfo* info);
+  ASIOError start();
+  ASIOError stop();
+  ASIOError getChannels(long* numInputChannels, long* numOutputChannels) const;
+  ASIOError getLatencies(long* inputLatency, long* outputLatency) const;
+  ASIOError getBufferSize(long* minSize, long* maxSize, long* preferredSize, long* granularity) const;
+  ASIOError canSampleRate(ASIOSampleRate sampleRate) const;
+  ASIOError getSampleRate(ASIOSampleRate* sampleRate) const;
+  ASIOError setSampleRate(ASIOSampleRate sampleRate);
+  ASIOError getSamplePosition(ASIOSamples* position, ASIOTimeStamp* timeStamp) const;
+  ASIOError getChannelInfo(ASIOChannelInfo* info) const;
+  ASIOError createBuffers(ASIOBufferInfo* bufferInfos, long numChannels, long bufferSize, ASIOCallbacks* callbacks);
+  ASIOError disposeBuffers();
+  ASIOError outputReady();
+
+  // À l'arrêt : accepter l'optimisation ASIOOutputReady (refusée par défaut, comme
+  // AsioSample). Le bloc étant alors joué dès que l'hôte le signale, la latence de
+  // sortie annoncée après createBuffers passe de deux blocs à un.
+  void setOutputReady(bool enabled) { outputReadyEnabled = enabled; }
+  uint64_t outputReadyCount() const { return outputReadyCalls.load(std::memory_order_relaxed); }
+
+  // À l'arrêt : source de temps ; blockLimit > 0 arrête l'horloge virtuelle après ce
+  // nombre de blocs (durée rejouée), 0 la laisse tourner jusqu'à stop()
+  void setClock(DriverClock newClock, uint64_t blockLimit = 0);
+  DriverClock clock() const { return clockMode; }
+
+  // À l'arrêt : fonction appelée par le thread d'horloge avant son premier bloc (priorité,
+  // affinité) ; start() ne retourne qu'une fois qu'elle est terminée
+  void setThreadSetup(std::function<void()> setup);
+
+  // Horloge virtuelle : tous les blocs demandés ont été livrés
+  bool finished() const { return clockFinished.load(std::memory_order_acquire); }
+
+  // Blocs livrés depuis start(), et blocs perdus parce que le callback (ou le
+  // réveil du thread) a dépassé l'échéance suivante : la position saute comme
+  // avec une carte dont le DMA continue de tourner
+  uint64_t blocks() const { return delivered.load(std::memory_order_relaxed); }
+  uint64_t skippedBlocks() const { return skipped.load(std::memory_order_relaxed); }
+
+private:
+  void run();
+  void runVirtual();
+  void bufferSwitch(int64_t timeNs);
+  void bufferSwitchX();
+  void input();
+  void makeSine(int32_t* wave) const;
+  void makeSaw(int32_t* wave) const;
+
+  static int64_t nowNs();
+  static void sleepUntilNs(int64_t deadline);
+
+  long numInputs;
+  long numOutputs;
+  double rate;
+  long blockFrames = kPreferredBlockFrames;
+  DriverClock clockMode = DriverClock::RealTime;
+  uint64_t maxBlocks = 0;
+  std::function<void()> threadSetup;
+
+  // Copie des callbacks de l'hôte (la structure passée à createBuffers peut être temporaire)
+  ASIOCallbacks hostCallbacks = ASIOCallbacks();
+  bool buffersCreated = false;
+  bool timeInfoMode = false;
+  ASIOTime asioTime = ASIOTime();
+
+  // Buffers actifs : 2 * blockFrames échantillons par canal, moitié 1 à la suite de la moitié 0
+  std::vector<std::vector<int32_t>> inputBuffers;
+  std::vector<std::vector<int32_t>> outputBuffers;
+  std::vector<int32_t> sineWave;
+  std::vector<int32_t> sawTooth;
+
+  // Thread d'horloge ; toggle n'est touché que par lui pendant la lecture
+  std::thread clockThread;
+  std::atomic<bool> started{false};
+  long toggle = 0;
+  std::atomic<int64_t> samplePosition{0};  // première trame du bloc livré
+  std::atomic<int64_t> systemTimeNs{0};    // instant de livraison du bloc (horloge monotone)
+  std::atomic<uint64_t> delivered{0};
+  std::atomic<uint64_t> skipped{0};
+  std::atomic<bool> clockFinished{false};
+  bool outputReadyEnabled = false;
+  std::atomic<uint64_t> outputReadyCalls{0};
+};
+
+#endif
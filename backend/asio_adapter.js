@@ -4,6 +4,7 @@
  */
 
 const path = require('path');
+const { createSharedTelemetryBuffer, SharedTelemetryWriter } = require('./shared_telemetry');
 let asioAddon;
 
 try {
@@ -12,17 +13,19 @@ try {
   console.log('Module ASIO natif chargé avec succès');
   
   // Vérifier si le module natif a toutes les méthodes nécessaires
-  const dummyHandler = new asioAddon.ASIOHandler();
+  // (chaque instance de ASIOHandler est un moteur ; la liste des périphériques est statique)
   const ASIOHandlerClass = asioAddon.ASIOHandler;
-  const requiredMethods = ['initialize', 'start', 'stop', 'getInputLevel', 'getFFTData', 'getDevices'];
+  const requiredMethods = ['initialize', 'start', 'stop', 'getInputLevel', 'getFFTData'];
   
   let missingMethods = [];
   for (const method of requiredMethods) {
-    // Vérifier si la méthode existe soit comme méthode d'instance, soit comme méthode statique
-    if (typeof dummyHandler[method] !== 'function' && typeof ASIOHandlerClass[method] !== 'function') {
+    if (typeof ASIOHandlerClass.prototype[method] !== 'function') {
       missingMethods.push(method);
     }
   }
+  if (typeof ASIOHandlerClass.getDevices !== 'function') {
+    missingMethods.push('getDevices');
+  }
   
   if (missingMethods.length > 0) {
     console.warn(`Le module ASIO natif ne contient pas toutes les méthodes requises: ${missingMethods.join(', ')}`);
@@ -90,6 +93,8 @@ const asioSimulation = {
 
 /**
  * Interface unifiée pour le module ASIO (réel ou simulé)
+ * Chaque interface possède son propre moteur natif : plusieurs pipelines (zones, paires de
+ * périphériques) peuvent fonctionner en parallèle avec new ASIOInterface()
  */
 class ASIOInterface {
   constructor() {
@@ -103,82 +108,37 @@ class ASIOInterface {
     this.currentInputDevice = null;
     this.currentOutputDevice = null;
     this.gain = 1.0;
+    
+    // Flux de télémétrie (module natif ou minuterie de simulation)
+    this.nativeTelemetry = false;
+    this.telemetryTimer = null;
+
+    // Télémétrie en mémoire partagée (module natif ou minuterie de simulation)
+    this.nativeSharedTelemetry = false;
+    this.sharedTelemetryTimer = null;
+
+    // initialize / start / stop sont exécutés l'un après l'autre, dans l'ordre des appels
+    this.controlQueue = Promise.resolve();
+  }
+
+  /**
+   * Enchaîner une opération de contrôle après les précédentes (une erreur n'interrompt pas la file)
+   */
+  runControl(operation) {
+    const run = this.controlQueue.then(operation);
+    this.controlQueue = run.catch(() => {});
+    return run;
   }
 
   /**
    * Récupérer la liste des périphériques audio disponibles
+   * (lue depuis le cache du module natif : aucun pilote n'est chargé ici)
    */
   getDevices() {
     if (this.useNative) {
       try {
-        // Utiliser le module natif pour récupérer les périphériques ASIO
-        console.log('Utilisation du module natif pour récupérer les périphériques ASIO');
-        
-        // Vérifier si la méthode getDevices existe
-        if (typeof asioAddon.ASIOHandler.getDevices !== 'function') {
-          console.warn('Méthode getDevices non trouvée dans le module natif');
-          throw new Error('Méthode getDevices non disponible');
-        }
-        
         const nativeDevices = asioAddon.ASIOHandler.getDevices();
-        console.log('Périphériques ASIO détectés par le module natif:', nativeDevices);
-        
-        // Si aucun périphérique n'est détecté ou si la liste est vide, utiliser des périphériques simulés
-        if (!nativeDevices || nativeDevices.length === 0) {
-          console.log('Aucun périphérique ASIO détecté, utilisation de périphériques simulés');
-          
-          // Créer des périphériques simulés
-          return [
-            {
-              id: 'input_sim',
-              name: 'Simulation ASIO (Entrée)',
-              isInput: true,
-              driverId: 'sim',
-              driverName: 'Simulation ASIO',
-              isSimulated: true
-            },
-            {
-              id: 'output_sim',
-              name: 'Simulation ASIO (Sortie)',
-              isInput: false,
-              driverId: 'sim',
-              driverName: 'Simulation ASIO',
-              isSimulated: true
-            }
-          ];
-        }
-        
-        // Créer deux périphériques (entrée et sortie) pour chaque pilote ASIO détecté
-        const devices = [];
-        for (let i = 0; i < nativeDevices.length; i++) {
-          const device = nativeDevices[i];
-          if (!device || !device.name) {
-            console.warn(`Périphérique #${i} invalide, ignoré`);
-            continue;
-          }
-          
-          // Ajouter un périphérique d'entrée
-          devices.push({
-            id: `input_${device.id || i}`,
-            name: `${device.name} (Entrée)`,
-            isInput: true,
-            driverId: device.id || i,
-            driverName: device.name,
-            isSimulated: device.isSimulated || false
-          });
-          
-          // Ajouter un périphérique de sortie
-          devices.push({
-            id: `output_${device.id || i}`,
-            name: `${device.name} (Sortie)`,
-            isInput: false,
-            driverId: device.id || i,
-            driverName: device.name,
-            isSimulated: device.isSimulated || false
-          });
-        }
-        
-        return devices;
+        return this.expandDevices(nativeDevices);
       } catch (err) {
         console.error('Erreur lors de la récupération des périphériques ASIO:', err);
         console.warn('Utilisation de la simulation ASIO à la place');
@@ -190,10 +150,105 @@ class ASIOInterface {
   }
 
   /**
-   * Initialiser ASIO
+   * Sonder de nouveau les pilotes (après l'ajout ou le retrait d'une carte son)
+   */
+  async refreshDevices() {
+    if (this.useNative && typeof asioAddon.ASIOHandler.refreshDevices === 'function') {
+      try {
+        return this.expandDevices(await asioAddon.ASIOHandler.refreshDevices());
+      } catch (err) {
+        console.error('Erreur lors du sondage des périphériques ASIO:', err);
+      }
+    }
+    return this.getDevices();
+  }
+
+  /**
+   * Créer un périphérique d'entrée et un de sortie par pilote de la liste native
+   */
+  expandDevices(nativeDevices) {
+    // Si aucun périphérique n'est détecté ou si la liste est vide, utiliser des périphériques simulés
+    if (!nativeDevices || nativeDevices.length === 0) {
+      return [
+        {
+          id: 'input_sim',
+          name: 'Simulation ASIO (Entrée)',
+          isInput: true,
+          driverId: 'sim',
+          driverName: 'Simulation ASIO',
+          isSimulated: true
+        },
+        {
+          id: 'output_sim',
+          name: 'Simulation ASIO (Sortie)',
+          isInput: false,
+          driverId: 'sim',
+          driverName: 'Simulation ASIO',
+          isSimulated: true
+        }
+      ];
+    }
+    
+    const devices = [];
+    for (let i = 0; i < nativeDevices.length; i++) {
+      const device = nativeDevices[i];
+      if (!device || !device.name) {
+        console.warn(`Périphérique #${i} invalide, ignoré`);
+        continue;
+      }
+      
+      // Capacités relevées lors du sondage (absentes tant que le pilote n'a pas été sondé)
+      const capabilities = {
+        isSimulated: device.isSimulated || false,
+        probed: device.probed || false,
+        preferredBufferSize: device.preferredBufferSize,
+        minBufferSize: device.minBufferSize,
+        maxBufferSize: device.maxBufferSize,
+        bufferGranularity: device.bufferGranularity,
+        sampleRate: device.sampleRate,
+        sampleRates: device.sampleRates,
+        error: device.error
+      };
+      
+      // Ajouter un périphérique d'entrée
+      devices.push({
+        id: `input_${device.id || i}`,
+        name: `${device.name} (Entrée)`,
+        isInput: true,
+        driverId: device.id || i,
+        driverName: device.name,
+        numChannels: device.numInputChannels,
+        latency: device.inputLatency,
+        ...capabilities
+      });
+      
+      // Ajouter un périphérique de sortie
+      devices.push({
+        id: `output_${device.id || i}`,
+        name: `${device.name} (Sortie)`,
+        isInput: false,
+        driverId: device.id || i,
+        driverName: device.name,
+        numChannels: device.numOutputChannels,
+        latency: device.outputLatency,
+        ...capabilities
+      });
+    }
+    
+    return devices;
+  }
+
+  /**
+   * Initialiser ASIO (promesse : le pilote est chargé hors du thread principal)
    * @param {string} driverName - Nom du pilote ASIO à initialiser
+   * @param {Object} options - { realtime: true | { priority, cpu, lockMemory, lockProcess },
+   *                            outputReady (pilote virtuel : optimisation ASIOOutputReady) }
    */
-  initialize(driverName) {
+  initialize(driverName, options = {}) {
+    return this.runControl(() => this.initializeNow(driverName, options));
+  }
+
+  async initializeNow(driverName, options = {}) {
     try {
       if (this.useNative) {
         try {
@@ -222,7 +277,7 @@ class ASIOInterface {
           // Vérifier la méthode disponible (initialize ou Initialize)
           const initMethod = typeof this.handler.initialize === 'function' ? 'initialize' : 'Initialize';
           console.log(`Méthode d'initialisation utilisée: ${initMethod}`);
-          const result = this.handler[initMethod](actualDriverName);
+          const result = await this.handler[initMethod](actualDriverName, options);
           
           if (result.success) {
             this.initialized = true;
@@ -249,9 +304,40 @@ class ASIOInterface {
   }
 
   /**
-   * Démarrer le traitement audio
+   * Construire les routes du module natif
+   * Accepte soit options.routes ([{ input, output, gain }], canaux à partir de 0),
+   * soit les canaux sélectionnés dans l'interface (options.inputChannels / options.outputChannels,
+   * numérotés à partir de 1) : chaque entrée est routée vers la sortie de même rang.
+   */
+  buildRoutes(options) {
+    if (Array.isArray(options.routes)) {
+      return options.routes;
+    }
+    const inputs = [].concat(options.inputChannels ?? options.inputChannel ?? []);
+    const outputs = [].concat(options.outputChannels ?? options.outputChannel ?? []);
+    if (inputs.length === 0 || outputs.length === 0) {
+      return null;
+    }
+    const count = Math.max(inputs.length, outputs.length);
+    const routes = [];
+    for (let i = 0; i < count; i++) {
+      routes.push({
+        input: Number(inputs[Math.min(i, inputs.length - 1)]) - 1,
+        output: Number(outputs[Math.min(i, outputs.length - 1)]) - 1,
+        gain: 1.0
+      });
+    }
+    return routes;
+  }
+
+  /**
+   * Démarrer le traitement audio (promesse)
    */
   start(options = {}) {
+    return this.runControl(() => this.startNow(options));
+  }
+
+  async startNow(options) {
     if (!this.initialized) {
       return { success: false, error: 'ASIO n\'est pas initialisé' };
     }
@@ -263,8 +349,16 @@ class ASIOInterface {
           console.log('Démarrage du traitement audio avec le module natif ASIO');
           console.log('Options:', options);
           
-          // Démarrer le traitement audio avec le gain spécifié
-          const result = this.handler.start(options.gain || 1.0);
+          // Démarrer le traitement audio avec le gain spécifié, son lissage, le routage
+          // et le mode de traitement (inversion ou fxlms)
+          const startOptions = {};
+          const nativeOptions = ['rampMs', 'ramp', 'mode', 'errorChannel', 'taps', 'stepSize', 'secondaryDelay', 'secondaryGain', 'secondaryPath', 'clock', 'duration'];
+          for (const key of nativeOptions) {
+            if (options[key] !== undefined) startOptions[key] = options[key];
+          }
+          const routes = this.buildRoutes(options);
+          if (routes) startOptions.routes = routes;
+          const result = await this.handler.start(options.gain || 1.0, startOptions);
           
           if (result.success) {
             this.processing = true;
@@ -297,9 +391,13 @@ class ASIOInterface {
   }
 
   /**
-   * Arrêter le traitement audio
+   * Arrêter le traitement audio (promesse)
    */
   stop() {
+    return this.runControl(() => this.stopNow());
+  }
+
+  async stopNow() {
     if (!this.processing) {
       return { success: true, message: 'Le traitement audio est déjà arrêté' };
     }
@@ -310,7 +408,7 @@ class ASIOInterface {
           // Utiliser le module natif pour arrêter le traitement audio
           console.log('Arrêt du traitement audio avec le module natif ASIO');
           
-          const result = this.handler.stop();
+          const result = await this.handler.stop();
           
           if (result.success) {
             this.processing = false;
@@ -343,8 +441,8 @@ class ASIOInterface {
     if (!this.processing) return 0;
 
     try {
-      // Utiliser directement la simulation pour l'instant
-      return asioSimulation.getInputLevel();
+      // Mesure du callback (module natif), sinon la simulation
+      return this.useNative ? this.handler.getInputLevel() : asioSimulation.getInputLevel();
     } catch (err) {
       console.error('Erreur lors de la récupération du niveau d\'entrée:', err);
       return 0;
@@ -358,14 +456,178 @@ class ASIOInterface {
     if (!this.processing) return Array(32).fill(0);
 
     try {
-      // Utiliser directement la simulation pour l'instant
-      return asioSimulation.getFFTData();
+      // Mesure du callback (module natif), sinon la simulation
+      return this.useNative ? this.handler.getFFTData() : asioSimulation.getFFTData();
     } catch (err) {
       console.error('Erreur lors de la récupération des données FFT:', err);
       return Array(32).fill(0);
     }
   }
 
+  /**
+   * Obtenir l'horloge des blocs (blocs perdus, gigue, derniers horodatages)
+   */
+  getTimeInfo(maxEntries = 32) {
+    if (!this.useNative) return null;
+
+    try {
+      return this.handler.getTimeInfo(maxEntries);
+    } catch (err) {
+      console.error('Erreur lors de la récupération de l\'horloge des blocs:', err);
+      return null;
+    }
+  }
+
+  /**
+   * Obtenir les statistiques temps réel du callback (temps de traitement, charge DSP, dépassements)
+   */
+  getStats() {
+    if (!this.useNative) return null;
+
+    try {
+      return this.handler.getStats();
+    } catch (err) {
+      console.error('Erreur lors de la récupération des statistiques du callback:', err);
+      return null;
+    }
+  }
+
+  /**
+   * Traiter des fichiers WAV hors ligne avec la chaîne DSP du callback (plus vite que le temps réel)
+   * jobs : [{ input, output, ...options propres }], options : { threads, blockSize, outputFormat,
+   * outputChannels, routes, gain, mode, errorChannel, ... } appliquées à tous les fichiers
+   */
+  processFiles(jobs, options = {}) {
+    if (!this.useNative || !asioAddon || typeof asioAddon.ASIOHandler.processFiles !== 'function') {
+      return Promise.reject(new Error('Le traitement hors ligne nécessite le module ASIO natif'));
+    }
+
+    try {
+      return asioAddon.ASIOHandler.processFiles(jobs, options);
+    } catch (err) {
+      return Promise.reject(err);
+    }
+  }
+
+  /**
+   * Recevoir la télémétrie (niveau, spectre, charge DSP) poussée par le module natif
+   * onFrame(trame) est appelé frameRate fois par seconde, sans interrogation ;
+   * options : { frameRate (défaut 30), bands (défaut 32) }. Trames simulées sans module natif.
+   */
+  startTelemetry(onFrame, options = {}) {
+    this.stopTelemetry();
+    const frameRate = options.frameRate || 30;
+    const bands = options.bands !== undefined ? options.bands : 32;
+
+    if (this.useNative && typeof this.handler.startTelemetry === 'function') {
+      try {
+        const result = this.handler.startTelemetry(onFrame, { frameRate, bands });
+        this.nativeTelemetry = true;
+        return result;
+      } catch (err) {
+        console.error('Erreur lors du démarrage de la télémétrie native:', err);
+        console.warn('Utilisation de la simulation ASIO à la place');
+      }
+    }
+
+    this.telemetryTimer = setInterval(() => {
+      onFrame({
+        timeMs: Date.now(),
+        processing: this.processing,
+        level: this.getInputLevel(),
+        fft: this.getFFTData()
+      });
+    }, 1000 / frameRate);
+    return { success: true, frameRate, bands, simulated: true };
+  }
+
+  /**
+   * Arrêter le flux de télémétrie
+   */
+  stopTelemetry() {
+    if (this.nativeTelemetry) {
+      this.nativeTelemetry = false;
+      try {
+        this.handler.stopTelemetry();
+      } catch (err) {
+        console.error('Erreur lors de l\'arrêt de la télémétrie native:', err);
+      }
+    }
+    if (this.telemetryTimer) {
+      clearInterval(this.telemetryTimer);
+      this.telemetryTimer = null;
+    }
+    return { success: true };
+  }
+
+  /**
+   * Démarrer la télémétrie en mémoire partagée : renvoie le SharedArrayBuffer, à lire avec
+   * SharedTelemetryReader (shared_telemetry.js) depuis n'importe quel thread ou worker
+   */
+  startSharedTelemetry(options = {}) {
+    this.stopSharedTelemetry();
+    const frameRate = options.frameRate || 30;
+    const bands = options.bands !== undefined ? options.bands : 32;
+    const buffer = createSharedTelemetryBuffer(bands);
+
+    if (this.useNative && typeof this.handler.startSharedTelemetry === 'function') {
+      try {
+        const result = this.handler.startSharedTelemetry(new Int32Array(buffer), { frameRate });
+        this.nativeSharedTelemetry = true;
+        return { ...result, buffer };
+      } catch (err) {
+        console.error('Erreur lors du démarrage de la télémétrie partagée native:', err);
+        console.warn('Utilisation de la simulation ASIO à la place');
+      }
+    }
+
+    const writer = new SharedTelemetryWriter(buffer);
+    this.sharedTelemetryTimer = setInterval(() => {
+      writer.publish({
+        processing: this.processing,
+        level: this.getInputLevel(),
+        fft: this.getFFTData()
+      });
+    }, 1000 / frameRate);
+    return { success: true, frameRate, bands, buffer, simulated: true };
+  }
+
+  /**
+   * Arrêter la télémétrie en mémoire partagée (la région n'est plus mise à jour)
+   */
+  stopSharedTelemetry() {
+    if (this.nativeSharedTelemetry) {
+      this.nativeSharedTelemetry = false;
+      try {
+        this.handler.stopSharedTelemetry();
+      } catch (err) {
+        console.error('Erreur lors de l\'arrêt de la télémétrie partagée native:', err);
+      }
+    }
+    if (this.sharedTelemetryTimer) {
+      clearInterval(this.sharedTelemetryTimer);
+      this.sharedTelemetryTimer = null;
+    }
+    return { success: true };
+  }
+
+  /**
+   * Fermer le moteur (arrêt, libération du pilote et des threads natifs) ; un autre moteur
+   * peut alors utiliser le pilote du registre
+   */
+  close() {
+    return this.runControl(async () => {
+      this.stopTelemetry();
+      this.stopSharedTelemetry();
+      if (this.useNative && typeof this.handler.close === 'function') {
+        await this.handler.close();
+      }
+      this.initialized = false;
+      this.processing = false;
+      return { success: true };
+    });
+  }
+
   /**
    * Obtenir le statut actuel d'ASIO
    */
@@ -381,5 +643,6 @@ class ASIOInterface {
   }
 }
 
-// Exporter une instance unique de l'interface ASIO
+// Exporter l'interface ASIO du serveur, et la classe pour créer d'autres pipelines
 module.exports = new ASIOInterface();
+module.exports.ASIOInterface = ASIOInterface;
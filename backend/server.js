@@ -30,22 +30,55 @@ app.get('/api/devices', (req, res) => {
   }
 });
 
-app.post('/api/initialize', (req, res) => {
+// Nouveau sondage des pilotes (carte son ajoutée ou retirée)
+app.post('/api/devices/refresh', async (req, res) => {
   try {
-    const result = asioInterface.initialize();
+    const devices = await asioInterface.refreshDevices();
+    res.json({ devices });
+  } catch (error) {
+    res.status(500).json({ error: error.message });
+  }
+});
+
+app.post('/api/initialize', async (req, res) => {
+  try {
+    // realtime : true ou { priority, cpu, lockMemory, lockProcess } (thread de traitement et mémoire)
+    // outputReady : le pilote virtuel accepte l'optimisation ASIOOutputReady
+    const { driver, realtime, outputReady } = req.body || {};
+    const options = {};
+    if (realtime !== undefined) options.realtime = realtime;
+    if (outputReady !== undefined) options.outputReady = outputReady;
+    const result = await asioInterface.initialize(driver, options);
     res.json(result);
   } catch (error) {
     res.status(500).json({ error: error.message });
   }
 });
 
-app.post('/api/start', (req, res) => {
+app.post('/api/start', async (req, res) => {
   try {
-    const { gain, inputDeviceId, outputDeviceId } = req.body;
-    const result = asioInterface.start({
+    const {
+      gain, inputDeviceId, outputDeviceId, rampMs, ramp, routes, inputChannels, outputChannels,
+      mode, errorChannel, taps, stepSize, secondaryDelay, secondaryGain, secondaryPath, clock, duration
+    } = req.body;
+    const result = await asioInterface.start({
       gain,
       inputDeviceId,
-      outputDeviceId
+      outputDeviceId,
+      rampMs,
+      ramp,
+      routes,
+      inputChannels,
+      outputChannels,
+      mode,
+      errorChannel,
+      taps,
+      stepSize,
+      secondaryDelay,
+      secondaryGain,
+      secondaryPath,
+      clock,
+      duration
     });
     res.json(result);
   } catch (error) {
@@ -53,9 +86,9 @@ app.post('/api/start', (req, res) => {
   }
 });
 
-app.post('/api/stop', (req, res) => {
+app.post('/api/stop', async (req, res) => {
   try {
-    const result = asioInterface.stop();
+    const result = await asioInterface.stop();
     res.json(result);
   } catch (error) {
     res.status(500).json({ error: error.message });
@@ -74,7 +107,75 @@ app.get('/api/input-level', (req, res) => {
 app.get('/api/fft-data', (req, res) => {
   try {
     const data = asioInterface.getFFTData();
-    res.json({ data });
+    res.json({ data: Array.from(data) });
+  } catch (error) {
+    res.status(500).json({ error: error.message });
+  }
+});
+
+// Les résultats du module natif sont des Float32Array : sérialisés en tableaux JSON
+const typedArraysAsLists = (key, value) => (ArrayBuffer.isView(value) ? Array.from(value) : value);
+
+// Flux de télémétrie (Server-Sent Events) : une seule source native, partagée par tous
+// les clients ; démarrée à la première connexion, arrêtée à la dernière déconnexion
+const telemetryClients = new Set();
+
+app.get('/api/telemetry', (req, res) => {
+  res.set({
+    'Content-Type': 'text/event-stream',
+    'Cache-Control': 'no-cache',
+    Connection: 'keep-alive'
+  });
+  res.flushHeaders();
+
+  telemetryClients.add(res);
+  if (telemetryClients.size === 1) {
+    try {
+      asioInterface.startTelemetry((frame) => {
+        const message = `data: ${JSON.stringify(frame, typedArraysAsLists)}\n\n`;
+        for (const client of telemetryClients) {
+          client.write(message);
+        }
+      }, {
+        frameRate: Number(req.query.frameRate) || 30,
+        bands: req.query.bands !== undefined ? Number(req.query.bands) : 32
+      });
+    } catch (error) {
+      res.write(`event: error\ndata: ${JSON.stringify({ error: error.message })}\n\n`);
+    }
+  }
+
+  req.on('close', () => {
+    telemetryClients.delete(res);
+    if (telemetryClients.size === 0) {
+      asioInterface.stopTelemetry();
+    }
+  });
+});
+
+app.get('/api/time-info', (req, res) => {
+  try {
+    const timeInfo = asioInterface.getTimeInfo(Number(req.query.entries) || 32);
+    res.json({ timeInfo });
+  } catch (error) {
+    res.status(500).json({ error: error.message });
+  }
+});
+
+app.get('/api/stats', (req, res) => {
+  try {
+    const stats = asioInterface.getStats();
+    res.json({ stats });
+  } catch (error) {
+    res.status(500).json({ error: error.message });
+  }
+});
+
+app.post('/api/process-files', async (req, res) => {
+  try {
+    const { jobs, options } = req.body;
+    const results = await asioInterface.processFiles(jobs, options);
+    res.json({ results });
   } catch (error) {
     res.status(500).json({ error: error.message });
   }
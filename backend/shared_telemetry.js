@@ -0,0 +1,160 @@
+/**
+ * Télémétrie en mémoire partagée (format de asio/shared_telemetry.h)
+ *
+ * La région est un SharedArrayBuffer de mots de 32 bits : 32 mots d'en-tête puis une
+ * valeur par bande du spectre. L'écrivain (module natif, ou la simulation) publie sous
+ * compteur de séquence ; les lecteurs (thread principal ou workers) lisent chaque mot
+ * avec Atomics.load et recommencent si une écriture était en cours.
+ */
+
+const VERSION = 1;
+const HEADER_WORDS = 32;
+
+// Index des mots de l'en-tête (SharedTelemetryField)
+const Field = {
+  SEQUENCE: 0,
+  VERSION: 1,
+  BANDS: 2,
+  PROCESSING: 3,
+  FRAMES: 4,
+  TIME_US_LO: 5,
+  TIME_US_HI: 6,
+  LEVEL: 8,
+  RMS: 9,
+  PEAK: 10,
+  PEAK_HOLD: 11,
+  BLOCKS: 12,
+  CALLBACKS_LO: 13,
+  OVERRUNS_LO: 15,
+  LATE_LO: 17,
+  DSP_LOAD: 19,
+  MEAN_DSP_LOAD: 20,
+  PEAK_DSP_LOAD: 21
+};
+
+// Conversion mot de 32 bits <-> float sans allocation
+const wordView = new Int32Array(1);
+const floatView = new Float32Array(wordView.buffer);
+
+function toFloat(word) {
+  wordView[0] = word;
+  return floatView[0];
+}
+
+function toWord(value) {
+  floatView[0] = value;
+  return wordView[0];
+}
+
+/**
+ * Créer la région partagée pour un nombre de bandes
+ */
+function createSharedTelemetryBuffer(bands = 32) {
+  const buffer = new SharedArrayBuffer((HEADER_WORDS + bands) * Int32Array.BYTES_PER_ELEMENT);
+  const words = new Int32Array(buffer);
+  Atomics.store(words, Field.VERSION, VERSION);
+  Atomics.store(words, Field.BANDS, bands);
+  return buffer;
+}
+
+/**
+ * Lecteur de la région : read() renvoie la dernière trame cohérente, ou null si aucune
+ * trame n'a encore été publiée. fft est réutilisé d'une lecture à l'autre.
+ */
+class SharedTelemetryReader {
+  constructor(buffer) {
+    this.words = new Int32Array(buffer);
+    if (Atomics.load(this.words, Field.VERSION) !== VERSION) {
+      throw new Error('Version du format de télémétrie partagée non supportée');
+    }
+    this.bands = Atomics.load(this.words, Field.BANDS);
+    this.header = new Int32Array(HEADER_WORDS);
+    this.fft = new Float32Array(this.bands);
+    this.lastSequence = -1;
+  }
+
+  // Vrai si une trame a été publiée depuis la dernière lecture
+  changed() {
+    return Atomics.load(this.words, Field.SEQUENCE) !== this.lastSequence;
+  }
+
+  read() {
+    const { words, header, fft } = this;
+    let before;
+    let after;
+    do {
+      before = Atomics.load(words, Field.SEQUENCE);
+      for (let i = 0; i < HEADER_WORDS; i++) {
+        header[i] = Atomics.load(words, i);
+      }
+      for (let i = 0; i < this.bands; i++) {
+        fft[i] = toFloat(Atomics.load(words, HEADER_WORDS + i));
+      }
+      after = Atomics.load(words, Field.SEQUENCE);
+    } while ((before & 1) !== 0 || before !== after);
+    this.lastSequence = before;
+
+    if (header[Field.FRAMES] === 0) return null;
+
+    const uint64 = (lo) => (header[lo] >>> 0) + (header[lo + 1] >>> 0) * 4294967296;
+    return {
+      timeMs: uint64(Field.TIME_US_LO) / 1000,
+      processing: header[Field.PROCESSING] === 1,
+      frames: header[Field.FRAMES] >>> 0,
+      level: toFloat(header[Field.LEVEL]),
+      levels: {
+        rms: toFloat(header[Field.RMS]),
+        peak: toFloat(header[Field.PEAK]),
+        peakHold: toFloat(header[Field.PEAK_HOLD]),
+        blocks: header[Field.BLOCKS] >>> 0
+      },
+      fft,
+      callbacks: uint64(Field.CALLBACKS_LO),
+      overruns: uint64(Field.OVERRUNS_LO),
+      lateCallbacks: uint64(Field.LATE_LO),
+      dspLoad: {
+        current: toFloat(header[Field.DSP_LOAD]),
+        mean: toFloat(header[Field.MEAN_DSP_LOAD]),
+        peak: toFloat(header[Field.PEAK_DSP_LOAD])
+      }
+    };
+  }
+}
+
+/**
+ * Écrivain JavaScript (simulation sans module natif) : même protocole que le module natif
+ */
+class SharedTelemetryWriter {
+  constructor(buffer) {
+    this.words = new Int32Array(buffer);
+    this.bands = Atomics.load(this.words, Field.BANDS);
+    this.frames = 0;
+  }
+
+  publish({ processing = false, level = 0, fft = [] }) {
+    const { words } = this;
+    const sequence = Atomics.load(words, Field.SEQUENCE);
+    Atomics.store(words, Field.SEQUENCE, sequence + 1);
+
+    const timeUs = Math.round(performance.now() * 1000);
+    Atomics.store(words, Field.PROCESSING, processing ? 1 : 0);
+    Atomics.store(words, Field.FRAMES, ++this.frames);
+    Atomics.store(words, Field.TIME_US_LO, timeUs % 4294967296);
+    Atomics.store(words, Field.TIME_US_HI, Math.floor(timeUs / 4294967296));
+    Atomics.store(words, Field.LEVEL, toWord(level));
+    for (let i = 0; i < this.bands; i++) {
+      Atomics.store(words, HEADER_WORDS + i, toWord(fft[i] || 0));
+    }
+
+    Atomics.store(words, Field.SEQUENCE, sequence + 2);
+  }
+}
+
+module.exports = {
+  VERSION,
+  HEADER_WORDS,
+  Field,
+  createSharedTelemetryBuffer,
+  SharedTelemetryReader,
+  SharedTelemetryWriter
+};
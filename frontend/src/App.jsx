@@ -18,19 +18,21 @@ function App() {
     loadDevices();
   }, []);
 
-  // Polling pour les mises à jour des niveaux audio quand le traitement est actif
+  // Niveaux audio poussés par le serveur (Server-Sent Events) quand le traitement est actif
   useEffect(() => {
-    let interval;
-    if (status.asio?.processing) {
-      interval = setInterval(() => {
-        getInputLevel();
-        getFFTData();
-      }, 100);
-    }
+    if (!status.asio?.processing) return undefined;
 
-    return () => {
-      if (interval) clearInterval(interval);
+    const source = new EventSource(`${API_URL}/telemetry?frameRate=30&bands=32`);
+    source.onmessage = (event) => {
+      const frame = JSON.parse(event.data);
+      setInputLevel(frame.level);
+      if (frame.fft) setFftData(frame.fft);
+    };
+    source.onerror = (err) => {
+      console.error('Erreur du flux de télémétrie:', err);
     };
+
+    return () => source.close();
   }, [status.asio?.processing]);
 
   const checkServerStatus = async () => {
@@ -150,26 +152,6 @@ function App() {
     }
   };
 
-  const getInputLevel = async () => {
-    try {
-      const response = await fetch(`${API_URL}/input-level`);
-      const data = await response.json();
-      setInputLevel(data.level);
-    } catch (err) {
-      console.error('Erreur de lecture du niveau:', err);
-    }
-  };
-
-  const getFFTData = async () => {
-    try {
-      const response = await fetch(`${API_URL}/fft-data`);
-      const data = await response.json();
-      setFftData(data.data);
-    } catch (err) {
-      console.error('Erreur de lecture FFT:', err);
-    }
-  };
-
   return (
     <div className="min-h-screen flex items-center justify-center p-4">
       <div className="max-w-2xl w-full bg-slate-800 rounded-xl shadow-lg p-6 space-y-4">
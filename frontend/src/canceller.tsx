@@ -11,6 +11,12 @@ const MOCK_ASIO_DEVICES = [
   { id: 'asio_device_3', name: 'Realtek ASIO' },
 ];
 
+// API du backend (mêmes routes que App.jsx)
+const API_URL = 'http://localhost:3002/api';
+
+// Période de relève des statistiques du callback (latence mesurée)
+const STATS_POLL_MS = 1000;
+
 // Simulation des nombres de canaux par périphérique
 const MOCK_CHANNEL_COUNTS: { [key: string]: { inputs: number; outputs: number } } = {
   asio_device_1: { inputs: 8, outputs: 8 },
@@ -31,7 +37,7 @@ const PhaseReversalNoiseCanceller: React.FC = () => {
   
   // Nouveaux états pour la visualisation
   const [inputLevel, setInputLevel] = useState<number>(0);
-  const [latency, setLatency] = useState<number>(5.8);
+  const [latency, setLatency] = useState<number | null>(null);
   const [bufferSize, setBufferSize] = useState<number>(5.8);
   const [showFrequencyAnalysis, setShowFrequencyAnalysis] = useState<boolean>(false);
   
@@ -126,6 +132,33 @@ const PhaseReversalNoiseCanceller: React.FC = () => {
     }
   }, [isEnabled, status, showFrequencyAnalysis]);
   
+  // Latence mesurée par le module natif (latences d'entrée + de sortie du pilote)
+  useEffect(() => {
+    if (!isEnabled || status !== 'Active') {
+      return;
+    }
+    
+    let cancelled = false;
+    const poll = async () => {
+      try {
+        const response = await fetch(`${API_URL}/stats`);
+        const { stats } = await response.json();
+        if (!cancelled && stats && typeof stats.latencyMs === 'number') {
+          setLatency(Number(stats.latencyMs.toFixed(2)));
+        }
+      } catch (err) {
+        // Backend injoignable ou module natif absent : dernière latence connue conservée
+      }
+    };
+    
+    poll();
+    const timer = setInterval(poll, STATS_POLL_MS);
+    return () => {
+      cancelled = true;
+      clearInterval(timer);
+    };
+  }, [isEnabled, status]);
+  
   // Gestion de l'activation/désactivation
   const handleToggleEnable = () => {
     if (!selectedAsioDevice && !isEnabled) {
@@ -143,7 +176,9 @@ const PhaseReversalNoiseCanceller: React.FC = () => {
         setError(null);
         // Dans une implémentation réelle :
         // if (asioHandlerRef.current) {
-        //   asioHandlerRef.current.start(noiseReductionLevel / 100);
+        //   asioHandlerRef.current.start(noiseReductionLevel / 100, {
+        //     routes: [{ input: inputChannel - 1, output: outputChannel - 1, gain: 1.0 }]
+        //   });
         // }
       } else if (selectedAsioDevice) {
         setStatus('Initializing');
@@ -222,7 +257,6 @@ const PhaseReversalNoiseCanceller: React.FC = () => {
   // Changement de taille de buffer
   const handleBufferSizeChange = (size: number) => {
     setBufferSize(size);
-    setLatency(size);
     // Dans une implémentation réelle :
     // if (asioHandlerRef.current) {
     //   asioHandlerRef.current.setBufferSize(size);
@@ -362,7 +396,7 @@ const PhaseReversalNoiseCanceller: React.FC = () => {
               
               {/* Contrôle de latence */}
               <div className="flex items-center justify-between">
-                <span className="text-sm text-slate-300">Latence: {latency}ms</span>
+                <span className="text-sm text-slate-300">Latence: {latency !== null ? `${latency}ms` : '—'}</span>
                 <div className="flex space-x-1">
                   {[1.45, 3.0, 5.8].map((ms) => (
                     <button 